@@ -55,6 +55,15 @@
 //        so that the GPS connector points toward the tail of the plane
 #define BOARD_ORIENTATION                   ORIENTATION_FORWARDS
 
+////////////////////////////////////////////////////////////////////////////////
+// MPU6000 FIFO oversampling (UDB5 and AUAV3 only)
+// Set MPU_FIFO_RATE to 1000, 2000, 4000 or 8000 to sample the gyros (and the
+// accelerometers, at up to 1 kHz) at that rate into the MPU6000 FIFO. The FIFO
+// is drained in one DMA burst per heartbeat, the samples are averaged and
+// coning / sculling corrections are passed on to the DCM.
+// Set to 0 to use the default of one data ready interrupt per heartbeat.
+#define MPU_FIFO_RATE                       0
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // Choose your airframe type:
@@ -112,6 +121,12 @@
 // Use 32 meters for 20 to 50 meters/sec, and 16 meters for less than that.
 #define CROSS_TRACK_MARGIN                  32
 
+// Cross track lookahead time, in seconds
+// Set this above 0 to scale the cross track margin with ground speed, so that the
+// aircraft steers toward a point on the track this many seconds ahead of it.
+// The margin above is still the shortest lookahead used. 0 keeps a fixed margin.
+#define CROSS_TRACK_LOOKAHEAD_TIME          0
+
 // Wind Gain Adjustment
 // This is an option for modulating the navigation gains in flight
 // to maintain a constant turn radius in heavy winds in waypoing mode.
@@ -815,6 +830,11 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 // Optionally enable experimental extended range navigation support (merged from ballon launch branch)
+// The dead reckoned and GPS positions are always kept in 32 bit centimeters, but
+// navigation, the flight plans, camera targeting and telemetry still work in 16 bit
+// meters, about 32 km from the origin. Extended navigation keeps the waypoints and
+// GPSlocation in 32 bit meters and shortens long legs to fit, the plane itself must
+// still stay within the 16 bit range.
 //#define USE_EXTENDED_NAV
 
 
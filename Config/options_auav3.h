@@ -60,3 +60,7 @@
 
 // Set this to 1 to enable the UART communications support over USB on AUAV3
 //#define USE_CDC                             1
+
+// Set this to 1 to send the MAVLink or telemetry stream over the USB CDC port
+// instead of the telemetry UART, for full rate data on the bench (needs USE_CDC)
+//#define USE_CDC_TELEMETRY                   1
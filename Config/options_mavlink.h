@@ -64,6 +64,18 @@
 #define MAVLINK_FRAME_FREQUENCY             40
 #define MAVLINK_WAYPOINT_TIMEOUT            120 // Dependent on frequency of calling mavlink_output_40hz. 120 is 3 second timeout.
 
+// Number of mission items requested ahead during an upload, and of download
+// requests queued. Lost items are requested again after twice the measured
+// round trip. 1 gives the original one item at a time handshake.
+#define MAVLINK_MISSION_WINDOW              8
+
+// Largest Logo program, main and RTL instructions together, that can be
+// uploaded with DATA_TRANSMISSION_HANDSHAKE and ENCAPSULATED_DATA messages.
+// An uploaded program replaces the compiled in one the next time it is safe
+// to do so, and is kept in non volatile memory when USE_NV_MEMORY is set.
+// Each instruction uses 8 bytes of RAM. 0 leaves out Logo program upload.
+#define LOGO_UPLOAD_INSTRUCTIONS            0
+
 // 19200,38400,57600,115200,230400,460800,921600
 // Fixed 19200 for non free running clock
 //#define MAVLINK_BAUD                        19200   // now using SERIAL_BAUDRATE in options.h
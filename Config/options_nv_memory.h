@@ -41,6 +41,18 @@
 #endif
 
 
+////////////////////////////////////////////////////////////////////////////////
+// Store MAVLink missions in non volatile memory
+// Set to the maximum number of mission points to keep uploaded missions in
+// non volatile memory, paged through a small RAM window as they are flown.
+// Missions stored this way survive a power cycle and resume at the last leg.
+// Set to 0 to keep uploaded missions in RAM only.
+// WARNING: Requires USE_NV_MEMORY.  Each point uses 22 bytes of nv memory.
+#ifndef MISSION_STORE_POINTS
+#define MISSION_STORE_POINTS            0
+#endif
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // Manual erase / format of non volatile memory table
 // If set to 1, does manual erase of memory table when it runs.
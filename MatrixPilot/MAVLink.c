@@ -57,6 +57,8 @@
 #include "MAVParams.h"
 #include "MAVMission.h"
 #include "MAVFlexiFunctions.h"
+#include "MAVLogo.h"
+#include "MAVLogs.h"
 #include "MAVUDBExtra.h"
 #include "../MAVLink/MAVFTP.h"
 
@@ -126,6 +128,11 @@ static uint8_t mavlink_counter_40hz = 0;
 static uint64_t usec = 0; // A measure of time in microseconds (should be from Unix Epoch).
 static uint32_t msec = 0; // A measure of time in microseconds (should be from Unix Epoch).
 
+#ifndef MAVLINK_BULK_BYTES_PER_TICK
+// Bytes the link drains in one 40Hz tick, less a quarter for timing jitter
+#define MAVLINK_BULK_BYTES_PER_TICK         ((MAVLINK_BAUD / 10 / 40) * 3 / 4)
+#endif
+
 static int16_t sb_index = 0;
 static int16_t end_index = 0;
 static char serial_interrupt_stopped = 1;
@@ -195,6 +202,42 @@ int16_t mavlink_callback_get_byte_to_send(void)
 	return -1;
 }
 
+// Number of bytes that can be queued for sending without being thrown away
+int16_t mavlink_serial_tx_space(void)
+{
+	if (serial_interrupt_stopped == 1)
+	{
+		return SERIAL_BUFFER_SIZE;
+	}
+	return SERIAL_BUFFER_SIZE - end_index;
+}
+
+// Number of bytes the bulk transfers (parameter lists, missions, logs) may
+// queue this tick. The serial buffer is only reset once it has drained, so
+// the bulk transfers keep what is queued within one tick of link time. The
+// buffer is then empty again for the next tick's periodic streams. On a slow
+// link, where a log data message takes more than a tick to send, one bulk
+// message is still allowed whenever the buffer is idle.
+int16_t mavlink_bulk_tx_space(void)
+{
+	int16_t space = mavlink_serial_tx_space();
+	int16_t allowed = MAVLINK_BULK_BYTES_PER_TICK;
+
+	if (serial_interrupt_stopped == 0)
+	{
+		allowed -= end_index - sb_index;
+	}
+	else if (allowed < MAVLINK_MAX_PACKET_LEN)
+	{
+		allowed = MAVLINK_MAX_PACKET_LEN;
+	}
+	if (space > allowed)
+	{
+		space = allowed;
+	}
+	return space;
+}
+
 //int16_t mavlink_serial_send(mavlink_channel_t UNUSED(chan), uint8_t buf[], uint16_t len)
 int16_t mavlink_serial_send(mavlink_channel_t UNUSED(chan), const uint8_t buf[], uint16_t len) // RobD
 // Note: Channel Number, chan, is currently ignored.
@@ -650,6 +693,8 @@ static void handleMessage(void)
 	handling_of_message_completed |= MAVParamsHandleMessage(handle_msg);
 	handling_of_message_completed |= MAVMissionHandleMessage(handle_msg);
 	handling_of_message_completed |= MAVFlexiFunctionsHandleMessage(handle_msg);
+	handling_of_message_completed |= MAVLogoHandleMessage(handle_msg);
+	handling_of_message_completed |= MAVLogsHandleMessage(handle_msg);
 //	handling_of_message_completed |= MAVFTPHandleMessage(handle_msg); // WIP - RobD
 
 	if (handling_of_message_completed != false)
@@ -751,6 +796,32 @@ static boolean mavlink_frequency_send(uint8_t frequency, uint8_t counter)
 	}
 	return false;
 }
+
+// The bulk producers each send as much as mavlink_bulk_tx_space() allows, so
+// the one that goes first is rotated every tick to keep it from starving the rest
+static void (* const mavlink_bulk_output_40hz[])(void) =
+{
+	&MAVParamsOutput_40hz,
+	&MAVMissionOutput_40hz,
+	&MAVFlexiFunctionsOutput_40hz,
+	&MAVLogoOutput_40hz,
+	&MAVLogsOutput_40hz,
+//	&MAVFTPOutput_40hz, // WIP - RobD
+};
+
+#define MAVLINK_BULK_OUTPUTS (sizeof(mavlink_bulk_output_40hz) / sizeof(mavlink_bulk_output_40hz[0]))
+
+static void mavlink_bulk_output(void)
+{
+	static uint8_t first = 0;
+	uint8_t i;
+
+	for (i = 0; i < MAVLINK_BULK_OUTPUTS; i++)
+	{
+		(*mavlink_bulk_output_40hz[(first + i) % MAVLINK_BULK_OUTPUTS])();
+	}
+	first = (first + 1) % MAVLINK_BULK_OUTPUTS;
+}
 #endif // (MAVLINK_TEST_ENCODE_DECODE != 1)
 
 void mavlink_output_40hz(void)
@@ -1058,10 +1129,6 @@ void mavlink_output_40hz(void)
 	{
 		MAVUDBExtraOutput(); // Designed to be called at 8Hz.
 	}
-	MAVParamsOutput_40hz();
-	MAVMissionOutput_40hz();
-	MAVFlexiFunctionsOutput_40hz();
-//	MAVFTPOutput_40hz(); // WIP - RobD
 
 	// Acknowledge a command if flaged to do so.
 	if (mavlink_send_command_ack == true)
@@ -1069,6 +1136,7 @@ void mavlink_output_40hz(void)
 		mavlink_msg_command_ack_send(MAVLINK_COMM_0, mavlink_command_ack_command, mavlink_command_ack_result);
 		mavlink_send_command_ack = false;
 	}
+	mavlink_bulk_output();
 #if (USE_TELELOG == 1)
 	log_swapbuf();
 #endif
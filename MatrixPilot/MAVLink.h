@@ -51,13 +51,10 @@ int16_t mavlink_serial_send(mavlink_channel_t chan, const uint8_t buf[], uint16_
 
 typedef struct mavlink_flag_bits {
 //	uint16_t unused                         : 2;
-	uint16_t mavlink_send_specific_variable : 1;
 	uint16_t mavlink_send_variables         : 1;
 	uint16_t mavlink_send_waypoint_count    : 1;
 	uint16_t mavlink_sending_waypoints      : 1;
 	uint16_t mavlink_receiving_waypoints    : 1;
-	uint16_t mavlink_send_specific_waypoint : 1;
-	uint16_t mavlink_request_specific_waypoint : 1;
 	uint16_t mavlink_send_waypoint_reached  : 1;
 	uint16_t mavlink_send_waypoint_changed  : 1;
 } mavlink_flags_t;
@@ -67,6 +64,8 @@ extern mavlink_flags_t mavlink_flags;
 boolean mavlink_check_target(uint8_t target_system, uint8_t target_component);
 void mavlink_input_byte(uint8_t byte);
 void mavlink_output_40hz(void);
+int16_t mavlink_serial_tx_space(void);
+int16_t mavlink_bulk_tx_space(void);
 void mavlink_init(void);
 int16_t mavlink_callback_get_byte_to_send(void);
 void mavlink_callback_received_byte(uint8_t rxchar);
@@ -0,0 +1,215 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2015 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+#include "../MatrixPilot/defines.h"
+#include "options_mavlink.h"
+
+#if (USE_MAVLINK == 1)
+
+#include "MAVLink.h"
+#include "MAVLogo.h"
+#include "flightplan_logo.h"
+#include <string.h>
+
+#if (LOGO_UPLOAD_INSTRUCTIONS > 0)
+
+// Logo program upload
+//
+// A program is sent as a container: an 8 byte header followed by one
+// record per instruction, main program first then RTL (see flightplan_logo.h).
+// The header holds, as little endian words: LOGO_PROGRAM_MAGIC, the number of main
+// instructions, the number of RTL instructions and the X25 checksum of the
+// records, as calculated for MAVLink messages.
+//
+// 1. The GCS sends DATA_TRANSMISSION_HANDSHAKE, type LOGO_PROGRAM_DATA_TYPE,
+//    with the size of the container.
+// 2. The UAV answers with a handshake holding the number of packets and the
+//    payload of each.
+// 3. The GCS sends every packet as ENCAPSULATED_DATA, without waiting.
+// 4. When all have arrived the UAV answers with a handshake with packets 0
+//    and the LOGO_UPLOAD_ result in jpg_quality. If packets go missing it
+//    repeats the handshake of step 2 with width set to the first missing
+//    packet, and the GCS sends again from that packet on.
+
+#define LOGO_HEADER_SIZE            8
+#define LOGO_PACKET_PAYLOAD         253     // ENCAPSULATED_DATA data field
+#define LOGO_MAX_PACKETS            32      // one bit each in logo_rx_received
+#define LOGO_RESEND_TICKS           10      // quiet time before asking for missing packets
+
+enum
+{
+	LOGO_RX_IDLE,
+	LOGO_RX_ACKNOWLEDGE,                    // send the handshake then receive
+	LOGO_RX_RECEIVING,
+	LOGO_RX_REPORT,                         // send the result
+};
+
+static uint8_t logo_rx_state = LOGO_RX_IDLE;
+static uint32_t logo_rx_size;
+static uint16_t logo_rx_packets;
+static uint32_t logo_rx_received;
+static uint8_t logo_rx_result;
+static uint16_t logo_rx_timer;
+static uint8_t logo_rx_header[LOGO_HEADER_SIZE];
+static mavlink_encapsulated_data_t logo_rx_packet;  // too big for the stack
+
+static uint16_t logo_rx_first_missing(void)
+{
+	uint16_t i;
+
+	for (i = 0; i < logo_rx_packets; i++)
+	{
+		if (!(logo_rx_received & ((uint32_t)1 << i))) break;
+	}
+	return i;
+}
+
+static uint16_t logo_rx_word(uint8_t index)
+{
+	return logo_rx_header[index] | ((uint16_t)logo_rx_header[index+1] << 8);
+}
+
+static void logo_rx_report(uint8_t result)
+{
+	logo_rx_result = result;
+	logo_rx_state = LOGO_RX_REPORT;
+}
+
+// Returns false if the handshake is not for a Logo program
+static boolean MAVLogoHandshake(mavlink_message_t* handle_msg)
+{
+	mavlink_data_transmission_handshake_t packet;
+
+	mavlink_msg_data_transmission_handshake_decode(handle_msg, &packet);
+	if (packet.type != LOGO_PROGRAM_DATA_TYPE) return false;
+
+	logo_rx_size = packet.size;
+	logo_rx_packets = (packet.size + LOGO_PACKET_PAYLOAD - 1) / LOGO_PACKET_PAYLOAD;
+	if (packet.size <= LOGO_HEADER_SIZE || (packet.size - LOGO_HEADER_SIZE) % LOGO_RECORD_SIZE != 0 ||
+	    logo_rx_packets > LOGO_MAX_PACKETS)
+	{
+		logo_rx_report(LOGO_UPLOAD_BAD_SIZE);
+		return true;
+	}
+	logo_rx_result = flightplan_logo_upload_begin((packet.size - LOGO_HEADER_SIZE) / LOGO_RECORD_SIZE);
+	if (logo_rx_result != LOGO_UPLOAD_OK)
+	{
+		logo_rx_report(logo_rx_result);
+		return true;
+	}
+	logo_rx_received = 0;
+	logo_rx_state = LOGO_RX_ACKNOWLEDGE;
+	return true;
+}
+
+// ENCAPSULATED_DATA carries no type, so it is only taken while an upload is open.
+// Returns false otherwise.
+static boolean MAVLogoData(mavlink_message_t* handle_msg)
+{
+	uint32_t offset;
+	uint16_t length;
+	uint8_t* data;
+
+	if (logo_rx_state != LOGO_RX_ACKNOWLEDGE && logo_rx_state != LOGO_RX_RECEIVING) return false;
+
+	mavlink_msg_encapsulated_data_decode(handle_msg, &logo_rx_packet);
+	if (logo_rx_packet.seqnr >= logo_rx_packets) return true;
+
+	offset = (uint32_t)logo_rx_packet.seqnr * LOGO_PACKET_PAYLOAD;
+	length = (logo_rx_size - offset < LOGO_PACKET_PAYLOAD) ? logo_rx_size - offset : LOGO_PACKET_PAYLOAD;
+	data = logo_rx_packet.data;
+	if (offset == 0)
+	{
+		memcpy(logo_rx_header, data, LOGO_HEADER_SIZE);
+		data += LOGO_HEADER_SIZE;
+		length -= LOGO_HEADER_SIZE;
+	}
+	else
+	{
+		offset -= LOGO_HEADER_SIZE;
+	}
+	flightplan_logo_upload_data(offset, data, length);
+	logo_rx_received |= (uint32_t)1 << logo_rx_packet.seqnr;
+	logo_rx_timer = 0;
+
+	if (logo_rx_first_missing() == logo_rx_packets)
+	{
+		if (logo_rx_word(0) != LOGO_PROGRAM_MAGIC)
+		{
+			logo_rx_report(LOGO_UPLOAD_BAD_MAGIC);
+		}
+		else
+		{
+			logo_rx_report(flightplan_logo_upload_commit(logo_rx_word(2), logo_rx_word(4), logo_rx_word(6)));
+		}
+	}
+	return true;
+}
+
+#endif // LOGO_UPLOAD_INSTRUCTIONS
+
+boolean MAVLogoHandleMessage(mavlink_message_t* handle_msg)
+{
+	switch (handle_msg->msgid)
+	{
+#if (LOGO_UPLOAD_INSTRUCTIONS > 0)
+		case MAVLINK_MSG_ID_DATA_TRANSMISSION_HANDSHAKE:
+			return MAVLogoHandshake(handle_msg);
+		case MAVLINK_MSG_ID_ENCAPSULATED_DATA:
+			return MAVLogoData(handle_msg);
+#endif // (LOGO_UPLOAD_INSTRUCTIONS > 0)
+		default:
+			return false;
+	}
+	return true;
+}
+
+void MAVLogoOutput_40hz(void)
+{
+#if (LOGO_UPLOAD_INSTRUCTIONS > 0)
+	switch (logo_rx_state)
+	{
+		case LOGO_RX_ACKNOWLEDGE:
+			mavlink_msg_data_transmission_handshake_send(MAVLINK_COMM_0, LOGO_PROGRAM_DATA_TYPE, logo_rx_size, 0, 0, logo_rx_packets, LOGO_PACKET_PAYLOAD, 0);
+			logo_rx_timer = 0;
+			logo_rx_state = LOGO_RX_RECEIVING;
+			break;
+		case LOGO_RX_RECEIVING:
+			logo_rx_timer++;
+			if (logo_rx_timer >= MAVLINK_WAYPOINT_TIMEOUT)
+			{
+				logo_rx_state = LOGO_RX_IDLE;   // the GCS has given up
+			}
+			else if (logo_rx_timer % LOGO_RESEND_TICKS == 0)
+			{
+				mavlink_msg_data_transmission_handshake_send(MAVLINK_COMM_0, LOGO_PROGRAM_DATA_TYPE, logo_rx_size, logo_rx_first_missing(), 0, logo_rx_packets, LOGO_PACKET_PAYLOAD, 0);
+			}
+			break;
+		case LOGO_RX_REPORT:
+			mavlink_msg_data_transmission_handshake_send(MAVLINK_COMM_0, LOGO_PROGRAM_DATA_TYPE, logo_rx_size, 0, 0, 0, LOGO_PACKET_PAYLOAD, logo_rx_result);
+			logo_rx_state = LOGO_RX_IDLE;
+			break;
+	}
+#endif // (LOGO_UPLOAD_INSTRUCTIONS > 0)
+}
+
+#endif // (USE_MAVLINK == 1)
@@ -0,0 +1,34 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2015 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+#ifndef MAVLOGO_H
+#define MAVLOGO_H
+
+// DATA_TRANSMISSION_HANDSHAKE type used for Logo program uploads, clear of
+// the image types of MAVLINK_DATA_STREAM_TYPE
+#define LOGO_PROGRAM_DATA_TYPE      100
+
+boolean MAVLogoHandleMessage(mavlink_message_t* handle_msg);
+void MAVLogoOutput_40hz(void);
+
+
+#endif // MAVLOGO_H
@@ -0,0 +1,325 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2015 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "../MatrixPilot/defines.h"
+#include "options_mavlink.h"
+
+#if (USE_MAVLINK == 1)
+
+#include "MAVLink.h"
+#include "MAVLogs.h"
+#if (USE_TELELOG == 1) && !((WIN == 1 || NIX == 1) && (SILSIM_MEDIA == SILSIM_MEDIA_HOST)) && (PX4 == 0)
+#include "MDD-File-System/FSIO.h"
+#include "../libFlashFS/log_store.h"
+#endif
+
+#ifdef USE_AT45D_LOG_STORE
+
+// Log download
+//
+// The logs in the dataflash log store are listed and downloaded with the
+// MAVLink log messages. LOG_REQUEST_LIST is answered with a LOG_ENTRY for each
+// log in the range asked for, LOG_REQUEST_DATA with LOG_DATA messages of up to
+// 90 bytes each, and a LOG_DATA with count 0 if the range asked for runs past
+// the end of the log. The log being written can be downloaded in flight, up
+// to its last full page.
+//
+// The main loop owns the dataflash, so MAVLogsService() does the reading and
+// queues the messages, and MAVLogsOutput_40hz() sends them only while the
+// serial buffer has room, so a download uses the spare capacity of the link
+// and never holds up the other streams.
+
+#define LOG_CHUNK_SIZE      MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN
+#define LOG_QUEUE_SIZE      4       // must be a power of 2
+
+enum
+{
+	LOG_IDLE,
+	LOG_LIST,
+	LOG_DATA
+};
+
+typedef struct tag_log_queued {
+	uint8_t request;                // log_request it answers
+	uint8_t type;                   // LOG_LIST or LOG_DATA
+	uint8_t count;                  // LOG_DATA bytes
+	uint16_t id;
+	uint16_t num_logs;              // LOG_ENTRY only
+	uint16_t last_log_num;          // LOG_ENTRY only
+	uint32_t value;                 // LOG_DATA offset or LOG_ENTRY size
+	uint8_t data[LOG_CHUNK_SIZE];
+} log_queued_t;
+
+// Written by MAVLogsHandleMessage(), log_request last
+static volatile uint8_t log_request = 0;
+static uint8_t log_request_type = LOG_IDLE;
+static uint16_t log_request_id;     // LOG_LIST start, LOG_DATA log
+static uint16_t log_request_end;    // LOG_LIST end
+static uint32_t log_request_ofs;
+static uint32_t log_request_count;
+
+// MAVLogsService() state
+static uint8_t log_serving = 0;
+static uint8_t log_type = LOG_IDLE;
+static uint16_t log_id;             // next log listed or log downloaded
+static uint16_t log_last;           // last log listed
+static uint16_t log_num_logs;
+static uint16_t log_start;          // page the downloaded log starts at
+static uint32_t log_ofs;
+static uint32_t log_end;            // end of the range asked for, clipped to the log
+static boolean log_past_end;        // the range asked for runs past the end of the log
+
+static log_queued_t log_queue[LOG_QUEUE_SIZE];
+static volatile uint8_t log_queue_head = 0; // written by MAVLogsService()
+static volatile uint8_t log_queue_tail = 0; // written by MAVLogsOutput_40hz()
+
+static log_queued_t* log_queue_next(void)
+{
+	if (((log_queue_head + 1) & (LOG_QUEUE_SIZE - 1)) == log_queue_tail)
+	{
+		return NULL;
+	}
+	return &log_queue[log_queue_head];
+}
+
+static void log_queue_push(log_queued_t* q, uint8_t type, uint16_t id)
+{
+	q->request = log_serving;
+	q->type = type;
+	q->id = id;
+	log_queue_head = (log_queue_head + 1) & (LOG_QUEUE_SIZE - 1);
+}
+
+static void log_start_request(uint16_t id, uint16_t end, uint32_t ofs, uint32_t count)
+{
+	uint16_t first;
+	uint16_t last;
+	uint32_t size;
+
+	switch (log_type)
+	{
+		case LOG_LIST:
+			if (!log_store_range(&first, &last))
+			{
+				// an empty store is listed as a single entry with num_logs 0
+				log_id = 0;
+				log_num_logs = 0;
+				break;
+			}
+			log_num_logs = last - first + 1;
+			log_id = (id > first) ? id : first;
+			log_last = (end < last) ? end : last;
+			if (log_id > log_last)
+			{
+				log_type = LOG_IDLE;
+			}
+			break;
+		case LOG_DATA:
+			log_id = id;
+			size = log_store_find(log_id, &log_start);
+			log_ofs = (ofs < size) ? ofs : size;
+			if (count > size - log_ofs)
+			{
+				log_end = size;
+				log_past_end = true;
+			}
+			else
+			{
+				log_end = log_ofs + count;
+				log_past_end = false;
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+static void log_list_next(log_queued_t* q)
+{
+	uint16_t start;
+
+	q->num_logs = log_num_logs;
+	q->last_log_num = log_num_logs ? log_last : 0;
+	q->value = log_num_logs ? log_store_find(log_id, &start) : 0;
+	log_queue_push(q, LOG_LIST, log_id);
+	if (log_num_logs == 0 || log_id++ == log_last)
+	{
+		log_type = LOG_IDLE;
+	}
+}
+
+static void log_data_next(log_queued_t* q)
+{
+	int16_t count = 0;
+	int16_t len;
+
+	len = (log_end - log_ofs < LOG_CHUNK_SIZE) ? (int16_t)(log_end - log_ofs) : LOG_CHUNK_SIZE;
+	while (count < len)
+	{
+		// a chunk can span two pages
+		int16_t n = log_store_read(log_id, log_start, log_ofs + count, (char*)q->data + count, len - count);
+		if (n <= 0)
+		{
+			// overwritten while being downloaded, or not in the store
+			log_end = log_ofs + count;
+			log_past_end = true;
+			break;
+		}
+		count += n;
+	}
+	if (count == 0 && !log_past_end)
+	{
+		log_type = LOG_IDLE;
+		return;
+	}
+	q->value = log_ofs;
+	q->count = count;
+	log_queue_push(q, LOG_DATA, log_id);
+	log_ofs += count;
+	if (count == 0)
+	{
+		log_type = LOG_IDLE;
+	}
+}
+
+void MAVLogsService(void)
+{
+	log_queued_t* q;
+	uint8_t request;
+	uint8_t type;
+	uint16_t id;
+	uint16_t end;
+	uint32_t ofs;
+	uint32_t count;
+
+	if (log_request != log_serving)
+	{
+		do {
+			// a new request can arrive while this copies the last one
+			request = log_request;
+			type = log_request_type;
+			id = log_request_id;
+			end = log_request_end;
+			ofs = log_request_ofs;
+			count = log_request_count;
+		} while (request != log_request);
+		log_serving = request;
+		log_type = type;
+		log_start_request(id, end, ofs, count);
+	}
+	while (log_type != LOG_IDLE && (q = log_queue_next()) != NULL)
+	{
+		if (log_type == LOG_LIST)
+		{
+			log_list_next(q);
+		}
+		else
+		{
+			log_data_next(q);
+		}
+	}
+}
+
+boolean MAVLogsHandleMessage(mavlink_message_t* handle_msg)
+{
+	switch (handle_msg->msgid)
+	{
+		case MAVLINK_MSG_ID_LOG_REQUEST_LIST:
+		{
+			mavlink_log_request_list_t packet;
+			mavlink_msg_log_request_list_decode(handle_msg, &packet);
+			log_request_id = packet.start;
+			log_request_end = packet.end;
+			log_request_type = LOG_LIST;
+			log_request++;
+			break;
+		}
+		case MAVLINK_MSG_ID_LOG_REQUEST_DATA:
+		{
+			mavlink_log_request_data_t packet;
+			mavlink_msg_log_request_data_decode(handle_msg, &packet);
+			log_request_id = packet.id;
+			log_request_ofs = packet.ofs;
+			log_request_count = packet.count;
+			log_request_type = LOG_DATA;
+			log_request++;
+			break;
+		}
+		case MAVLINK_MSG_ID_LOG_REQUEST_END:
+			log_request_type = LOG_IDLE;
+			log_request++;
+			break;
+		default:
+			return false;
+	}
+	return true;
+}
+
+// Sends queued replies within the per-tick bulk allowance, so that a log
+// download leaves the heartbeat and telemetry streams their share of the link
+void MAVLogsOutput_40hz(void)
+{
+	log_queued_t* q;
+
+	while (log_queue_tail != log_queue_head)
+	{
+		q = &log_queue[log_queue_tail];
+		if (q->request != log_request)
+		{
+			// answers a request that has since been replaced
+		}
+		else if (q->type == LOG_LIST)
+		{
+			if (mavlink_bulk_tx_space() < (MAVLINK_MSG_ID_LOG_ENTRY_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES))
+			{
+				break;
+			}
+			mavlink_msg_log_entry_send(MAVLINK_COMM_0, q->id, q->num_logs, q->last_log_num, 0, q->value);
+		}
+		else
+		{
+			if (mavlink_bulk_tx_space() < (MAVLINK_MSG_ID_LOG_DATA_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES))
+			{
+				break;
+			}
+			mavlink_msg_log_data_send(MAVLINK_COMM_0, q->id, q->value, q->count, q->data);
+		}
+		log_queue_tail = (log_queue_tail + 1) & (LOG_QUEUE_SIZE - 1);
+	}
+}
+
+#else
+
+boolean MAVLogsHandleMessage(mavlink_message_t* handle_msg)
+{
+	return false;
+}
+
+void MAVLogsOutput_40hz(void)
+{
+}
+
+void MAVLogsService(void)
+{
+}
+
+#endif // USE_AT45D_LOG_STORE
+
+#endif // (USE_MAVLINK == 1)
@@ -31,16 +31,53 @@
 #include "../MatrixPilot/flightplan_waypoints.h"
 #include "../libDCM/gpsParseCommon.h"
 
-uint16_t waypoint_request_i;
+#ifndef MAVLINK_MISSION_WINDOW
+#define MAVLINK_MISSION_WINDOW  8
+#endif
+
+// Mission items are about 45 bytes on the wire. Downloads send no more
+// items each 40Hz tick than half the link can carry, and at least one.
+#define MISSION_ITEM_BYTES      45
+#define MISSION_ITEMS_PER_LINK  (SERIAL_BAUDRATE / (10L * 2 * MISSION_ITEM_BYTES * MAVLINK_FRAME_FREQUENCY))
+#define MISSION_ITEMS_PER_TICK  (MISSION_ITEMS_PER_LINK > 0 ? MISSION_ITEMS_PER_LINK : 1)
+
+#define MISSION_RTT_INITIAL     8   // 40Hz ticks, until the first item has been timed
+#define MISSION_RTT_MAX         60
+
+// Upload window. Items are requested ahead of the next one to be stored,
+// and held here until they can be added to the flight plan in sequence.
+// A slot belongs to the item it last requested.
+enum {
+	RX_REQUESTED,
+	RX_RETRIED,
+	RX_RECEIVED,
+};
+
+struct mission_rx_slot {
+	uint16_t seq;
+	uint8_t  state;
+	uint8_t  age;                       // 40Hz ticks since the item was requested
+	int16_t  flags;
+	struct waypoint3D wp;
+};
+
+uint16_t waypoint_request_i;            // next uploaded item to be stored
 uint16_t mav_waypoint_reached;
 uint16_t mav_waypoint_changed;
-uint16_t mavlink_waypoint_requested_sequence_number;
 uint8_t  mavlink_waypoint_dest_sysid;
 uint8_t  mavlink_waypoint_dest_compid;
 uint16_t mavlink_waypoint_timeout = 0;
-uint8_t  number_of_waypoint_retries = 2;
 uint8_t  mavlink_waypoint_frame = MAV_FRAME_GLOBAL;
-boolean  mavlink_waypoint_current = true;
+
+static struct mission_rx_slot mission_rx[MAVLINK_MISSION_WINDOW];
+
+// Smoothed round trip from request to item, in 40Hz ticks * 8
+static uint16_t mission_rtt = MISSION_RTT_INITIAL * 8;
+
+// Download queue of requested items that have not been sent yet
+static uint16_t mission_tx[MAVLINK_MISSION_WINDOW];
+static uint8_t  mission_tx_head;
+static uint8_t  mission_tx_count;
 
 #define MAX_PARAMS 10
 static uint16_t params[MAX_PARAMS];
@@ -73,6 +110,135 @@ static uint16_t get(uint16_t index)
 	return data;
 }
 
+static void mission_tx_queue(uint16_t seq)
+{
+	uint8_t i;
+
+	for (i = 0; i < mission_tx_count; i++)
+	{
+		if (mission_tx[(mission_tx_head + i) % MAVLINK_MISSION_WINDOW] == seq)
+		{
+			return;                     // already queued, the request was repeated
+		}
+	}
+	if (mission_tx_count < MAVLINK_MISSION_WINDOW)
+	{
+		mission_tx[(mission_tx_head + mission_tx_count) % MAVLINK_MISSION_WINDOW] = seq;
+		mission_tx_count++;
+	}
+}
+
+// Send queued items, as many as the link has room for this tick
+static void mission_tx_send(void)
+{
+	vect3_32t wp;
+	uint8_t i;
+
+	for (i = 0; i < MISSION_ITEMS_PER_TICK && mission_tx_count > 0; i++)
+	{
+		uint16_t seq = mission_tx[mission_tx_head];
+
+		if (seq < waypoint_count())
+		{
+			if (!getWaypoint3D(seq, &wp))
+			{
+				return;                 // paged out, sent once it has been read back
+			}
+			if (mavlink_bulk_tx_space() < (MAVLINK_MSG_ID_MISSION_ITEM_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES))
+			{
+				return;                 // left queued until the link has room
+			}
+//			mavlink_msg_mission_item_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, 
+//			    uint16_t seq, uint8_t frame, uint16_t command, uint8_t current, uint8_t autocontinue, 
+//			    float param1, float param2, float param3, float param4, 
+//			    float x, float y, float z)
+			mavlink_msg_mission_item_send(MAVLINK_COMM_0, mavlink_waypoint_dest_sysid, mavlink_waypoint_dest_compid, \
+			    seq, mavlink_waypoint_frame, MAV_CMD_NAV_WAYPOINT, seq == waypointIndex, true, \
+			    0.0, 0.0, 0.0, 0.0, \
+			    (float)wp.y / 10000000.0, (float)wp.x / 10000000.0, wp.z);
+			DPRINT("waypoint %u %f %f %f\r\n", seq, (double)wp.y / 10000000.0, (double)wp.x / 10000000.0, (double)wp.z);
+		}
+		mission_tx_head = (mission_tx_head + 1) % MAVLINK_MISSION_WINDOW;
+		mission_tx_count--;
+	}
+}
+
+static void mission_rx_reset(void)
+{
+	int16_t i;
+
+	for (i = 0; i < MAVLINK_MISSION_WINDOW; i++)
+	{
+		mission_rx[i].seq = 0xFFFF;
+	}
+	waypoint_request_i = 0;
+}
+
+// Request the items in the upload window that have not been asked for yet.
+// With retry set, also ask again for those outstanding for longer than
+// twice the measured round trip.
+static void mission_rx_request(boolean retry)
+{
+	uint16_t seq;
+	uint16_t end = waypoint_request_i + MAVLINK_MISSION_WINDOW;
+	uint8_t timeout = (mission_rtt >> 2) + 4;
+
+	if (end > get(PARAM_WP_TOTAL))
+	{
+		end = get(PARAM_WP_TOTAL);
+	}
+	for (seq = waypoint_request_i; seq < end; seq++)
+	{
+		struct mission_rx_slot* slot = &mission_rx[seq % MAVLINK_MISSION_WINDOW];
+
+		if (slot->seq != seq)
+		{
+			slot->seq = seq;
+			slot->state = RX_REQUESTED;
+		}
+		else if (slot->state == RX_RECEIVED || !retry || ++slot->age < timeout)
+		{
+			continue;
+		}
+		else
+		{
+			DPRINT("re-requesting waypoint: %u\r\n", seq);
+			slot->state = RX_RETRIED;
+		}
+		slot->age = 0;
+		mavlink_msg_mission_request_send(MAVLINK_COMM_0, mavlink_waypoint_dest_sysid, mavlink_waypoint_dest_compid, seq);
+	}
+}
+
+// Add the received items to the flight plan in sequence, stopping at the
+// first missing item or when the flight plan cannot take another point yet
+static void mission_rx_store(void)
+{
+	uint8_t type = 0; // ok (0), error(1)
+
+	while (waypoint_request_i < get(PARAM_WP_TOTAL))
+	{
+		struct mission_rx_slot* slot = &mission_rx[waypoint_request_i % MAVLINK_MISSION_WINDOW];
+
+		if (slot->seq != waypoint_request_i || slot->state != RX_RECEIVED)
+		{
+			return;
+		}
+		if (!add_waypoint(slot->wp, slot->flags))
+		{
+			return;
+		}
+		waypoint_request_i++;
+	}
+	//gcs.send_text("flight plane received");
+	DPRINT("flight plan received\r\n");
+	commit_flightplan();
+	mavlink_msg_mission_ack_send(MAVLINK_COMM_0, mavlink_waypoint_dest_sysid, mavlink_waypoint_dest_compid, type);
+	mavlink_flags.mavlink_receiving_waypoints = false;
+	// XXX ignores waypoint radius for individual waypoints, can
+	// only set WP_RADIUS parameter
+}
+
 static inline void MissionRequestList(mavlink_message_t* handle_msg)
 {
 	mavlink_mission_request_list_t packet;
@@ -89,6 +255,7 @@ static inline void MissionRequestList(mavlink_message_t* handle_msg)
 	mavlink_flags.mavlink_receiving_waypoints = false;
 	mavlink_waypoint_dest_sysid = handle_msg->sysid;
 	mavlink_waypoint_dest_compid = handle_msg->compid;
+	mission_tx_count = 0;
 	// Start sending waypoints
 	mavlink_flags.mavlink_send_waypoint_count = 1;
 	DPRINT("mission request list: sysid %u compid %u\r\n", handle_msg->sysid, handle_msg->compid);
@@ -111,19 +278,11 @@ static inline void MissionRequest(mavlink_message_t* handle_msg)
 	mavlink_msg_mission_request_decode(handle_msg, &packet);
 	if (mavlink_check_target(packet.target_system, packet.target_component)) return;
 	mavlink_waypoint_timeout = MAVLINK_WAYPOINT_TIMEOUT;
-	mavlink_waypoint_requested_sequence_number = packet.seq;
 	DPRINT("mission request: packet.seq %u\r\n", packet.seq);
 	mavlink_waypoint_frame = MAV_FRAME_GLOBAL; // reference frame
-	if (mavlink_waypoint_requested_sequence_number == waypointIndex)
-	{
-		mavlink_waypoint_current = true;
-	}
-	else
-	{
-		mavlink_waypoint_current = false;
-	}
-	// send waypoint
-	mavlink_flags.mavlink_send_specific_waypoint = 1;
+	// a ground station may have several requests outstanding, they are
+	// queued and answered as fast as the link allows
+	mission_tx_queue(packet.seq);
 
 	/************** Not converted to MAVLink wire protocol 1.0 yet *******************/
 	//uint8_t action = MAV_ACTION_NAVIGATE; // action
@@ -190,6 +349,7 @@ static inline void MissionAck(mavlink_message_t* handle_msg)
 
 	// turn off waypoint send
 	mavlink_flags.mavlink_sending_waypoints = false;
+	mission_tx_count = 0;
 	mavlink_waypoint_timeout  = 0;
 }
 
@@ -254,21 +414,30 @@ static inline void MissionCount(mavlink_message_t* handle_msg)
 	DPRINT("mission count: %u\r\n", packet.count);
 	// start waypoint receiving
 	set(PARAM_WP_TOTAL, packet.count);
-	if (get(PARAM_WP_TOTAL) > MAX_WAYPOINTS)
-		set(PARAM_WP_TOTAL, MAX_WAYPOINTS);
+	if (get(PARAM_WP_TOTAL) > MAX_MISSION_POINTS)
+		set(PARAM_WP_TOTAL, MAX_MISSION_POINTS);
+	clear_flightplan();
 	//mavlink_flags.waypoint_timelast_receive = millis();
 	mavlink_waypoint_timeout = MAVLINK_WAYPOINT_TIMEOUT;
 
 	mavlink_flags.mavlink_receiving_waypoints = true;
 	mavlink_flags.mavlink_sending_waypoints = false;
-	mavlink_flags.mavlink_request_specific_waypoint = 1;
-	waypoint_request_i = 0;
+	mavlink_waypoint_dest_sysid = handle_msg->sysid;
+	mavlink_waypoint_dest_compid = handle_msg->compid;
+	mission_rx_reset();
+	// request the first window of items straight away
+	mission_rx_store();
+	if (mavlink_flags.mavlink_receiving_waypoints)
+	{
+		mission_rx_request(false);
+	}
 }
 
 static inline void MissionItem(mavlink_message_t* handle_msg)
 {
 	int16_t flags = 0;
 	struct waypoint3D wp;
+	struct mission_rx_slot* slot;
 	mavlink_mission_item_t packet;
 	//send_text((uint8_t*)"waypoint\r\n");
 //	DPRINT("mission item\r\n");
@@ -282,8 +451,10 @@ static inline void MissionItem(mavlink_message_t* handle_msg)
 
 	DPRINT("mission item: %u\r\n", packet.seq);
 
-	// check if this is the requested waypoint
-	if (packet.seq != waypoint_request_i) return;
+	// check if this is a requested waypoint not already received
+	if (packet.seq < waypoint_request_i || packet.seq >= waypoint_request_i + MAVLINK_MISSION_WINDOW) return;
+	slot = &mission_rx[packet.seq % MAVLINK_MISSION_WINDOW];
+	if (slot->seq != packet.seq || slot->state == RX_RECEIVED) return;
 
 	// store waypoint
 	//uint8_t loadAction = 0; // 0 insert in list, 1 exec now
@@ -360,30 +531,29 @@ static inline void MissionItem(mavlink_message_t* handle_msg)
 			return;
 	}
 
-	// save waypoint
-	add_waypoint(wp, flags);
+	// time the round trip, only for items that were requested once
+	if (slot->state == RX_REQUESTED)
+	{
+		mission_rtt += slot->age - (mission_rtt >> 3);
+		if (mission_rtt > MISSION_RTT_MAX * 8)
+		{
+			mission_rtt = MISSION_RTT_MAX * 8;
+		}
+	}
+
+	// hold the waypoint until the items before it have been stored
+	slot->wp = wp;
+	slot->flags = flags;
+	slot->state = RX_RECEIVED;
 	//set_wp_with_index(tell_command, packet.seq);
 
 	// update waypoint receiving state machine
 	//global_data.waypoint_timelast_receive = millis();
 	mavlink_waypoint_timeout = MAVLINK_WAYPOINT_TIMEOUT;
-	waypoint_request_i++;
-
-	if (waypoint_request_i == get(PARAM_WP_TOTAL))
-	{
-		uint8_t type = 0; // ok (0), error(1)
-		//gcs.send_text("flight plane received");
-		DPRINT("flight plan received\r\n");
-		mavlink_msg_mission_ack_send(MAVLINK_COMM_0, handle_msg->sysid, handle_msg->compid, type);
-		mavlink_flags.mavlink_receiving_waypoints = false;
-		// XXX ignores waypoint radius for individual waypoints, can
-		// only set WP_RADIUS parameter
-
-		// send MAVLINK_MSG_ID_MISSION_ACK ?
-	}
-	else
+	mission_rx_store();
+	if (mavlink_flags.mavlink_receiving_waypoints)
 	{
-		mavlink_flags.mavlink_request_specific_waypoint = 1;
+		mission_rx_request(false);
 	}
 }
 
@@ -421,13 +591,9 @@ boolean MAVMissionHandleMessage(mavlink_message_t* handle_msg)
 	return true;
 }
 
-vect3_32t getWaypoint3D(uint16_t wp);
-
 void MAVMissionOutput_40hz(void)
 {
 #if (FLIGHT_PLAN_TYPE == FP_WAYPOINTS) // LOGO_WAYPOINTS cannot be uploaded / downloaded
-	vect3_32t wp;
-
 	if (mavlink_flags.mavlink_send_waypoint_reached == 1)
 	{
 		mavlink_flags.mavlink_send_waypoint_reached = 0;
@@ -453,16 +619,18 @@ void MAVMissionOutput_40hz(void)
 		}
 		mavlink_flags.mavlink_sending_waypoints   = false;
 		mavlink_flags.mavlink_receiving_waypoints = false;
+		mission_tx_count = 0;
 	}
 
-//	if (mavlink_flags.mavlink_receiving_waypoints == 1)
-	if (mavlink_flags.mavlink_request_specific_waypoint == 1)
+	// Store items held back by a busy flight plan, and retransmit requests
+	// for items that have not arrived
+	if (mavlink_flags.mavlink_receiving_waypoints)
 	{
-		DPRINT("requesting waypoint: %u\r\n", waypoint_request_i);
-			//mavlink_flags.waypoint_request_i = 0;
-//static inline void mavlink_msg_mission_request_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, uint16_t seq)
-		mavlink_msg_mission_request_send(MAVLINK_COMM_0, mavlink_waypoint_dest_sysid, mavlink_waypoint_dest_compid, waypoint_request_i);
-		mavlink_flags.mavlink_request_specific_waypoint = 0;
+		mission_rx_store();
+		if (mavlink_flags.mavlink_receiving_waypoints)
+		{
+			mission_rx_request(true);
+		}
 	}
 
 	// SEND NUMBER OF WAYPOINTS IN WAYPOINTS LIST
@@ -476,41 +644,8 @@ void MAVMissionOutput_40hz(void)
 		mavlink_flags.mavlink_send_waypoint_count = 0;
 	}
 
-	// SEND DETAILS OF A SPECIFIC WAYPOINT
-	if (mavlink_flags.mavlink_send_specific_waypoint == 1)
-	{
-			//send_text((uint8_t *)"Time to send a specific waypoint\r\n");
-			DPRINT("Time to send a specific waypoint: %u\r\n", mavlink_waypoint_requested_sequence_number);
-
-//			mavlink_msg_mission_item_send(mavlink_channel_t chan, uint8_t target_system, uint8_t target_component, 
-//			    uint16_t seq, uint8_t frame, uint16_t command, uint8_t current, uint8_t autocontinue, 
-//			    float param1, float param2, float param3, float param4, 
-//			    float x, float y, float z)
-
-			//BUILDING
-			//struct waypoint3D    { int32_t x; int32_t y; int16_t z; };
-
-//			struct waypoint3D getWaypoint3D(uint16_t wp);
-//			struct waypoint3D wp;
-//			wp = getWaypoint3D(mavlink_waypoint_requested_sequence_number);
-			wp = getWaypoint3D(mavlink_waypoint_requested_sequence_number);
-
-			//float lat_float, lon_float, alt_float = 0.0;
-			//uint32_t accum_long = IMUlocationy._.W1 + (lat_origin.WW / 90); //  meters North from Equator
-			//lat_float  = (float)((accum_long * 90) / 10000000.0); // degrees North from Equator
-			//lon_float = (float)((float) lon_origin.WW  + ((float)(IMUlocationx._.W1) * 90.0) / (float)(cos_lat / 16384.0)) / 10000000.0;
-			//extern struct relWaypointDef wp_to_relative(struct waypointDef wp);
-			//struct relWaypointDef current_waypoint = wp_to_relative(waypoints[waypointIndex]);
-			//alt_float =  ((float)(IMUlocationz._.W1)) + (float)(alt_origin.WW / 100.0);
-			mavlink_msg_mission_item_send(MAVLINK_COMM_0, mavlink_waypoint_dest_sysid, mavlink_waypoint_dest_compid, \
-			    mavlink_waypoint_requested_sequence_number, mavlink_waypoint_frame, MAV_CMD_NAV_WAYPOINT, mavlink_waypoint_current, true, \
-			    0.0, 0.0, 0.0, 0.0, \
-			    (float)wp.y / 10000000.0, (float)wp.x / 10000000.0, wp.z);
-
-			DPRINT("waypoint %f %f %f\r\n", (double)wp.y / 10000000.0, (double)wp.x / 10000000.0, (double)wp.z);
-
-			mavlink_flags.mavlink_send_specific_waypoint = 0;
-	}
+	// SEND DETAILS OF REQUESTED WAYPOINTS
+	mission_tx_send();
 	if (mavlink_waypoint_timeout  > 0) mavlink_waypoint_timeout--;
 
 #endif // (FLIGHT_PLAN_TYPE == FP_WAYPOINTS)
@@ -51,7 +51,21 @@
 /****************************************************************************/
 
 int16_t send_variables_counter = 0;
-int16_t send_by_index = 0;
+
+// A PARAM_VALUE message on the wire
+#define PARAM_VALUE_BYTES       (MAVLINK_MSG_ID_PARAM_VALUE_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES)
+
+// Parameters asked for one at a time, when set, read by name, or read by
+// index to fill the gaps of a list download, are queued ahead of the list
+#define PARAM_READ_QUEUE        16
+#define PARAM_HASH_INDEX        -2      // queue entry for the table hash
+
+static int16_t param_read_queue[PARAM_READ_QUEUE];
+static uint8_t param_read_head = 0;
+static uint8_t param_read_count = 0;
+
+// Read by name, this returns a hash of the whole table in place of a value
+static const char param_hash_name[16] = "_HASH_CHECK";
 
 extern uint16_t maxstack;
 static boolean mavlink_parameter_out_of_bounds(mavlink_param_union_t parm, int16_t i);
@@ -361,8 +375,64 @@ void mavlink_set_frame_anglerate(mavlink_param_union_t setting, int16_t i)
 	*((int16_t*)mavlink_parameters_list[i].pparam) = dec_angle._.W1;
 }
 
+// Hash of the parameter table, names in the high word and values in the
+// low word. A ground station holding a copy with the same hash can skip
+// downloading the list.
+static uint32_t param_table_hash(void)
+{
+	uint16_t crc_names;
+	uint16_t crc_values;
+	int16_t i;
+	uint16_t j;
+
+	crc_init(&crc_names);
+	crc_init(&crc_values);
+	for (i = 0; i < count_of_parameters_list; i++)
+	{
+		for (j = 0; j < sizeof(mavlink_parameters_list[i].name); j++)
+		{
+			crc_accumulate(mavlink_parameters_list[i].name[j], &crc_names);
+		}
+		if (mavlink_parameters_list[i].pparam != NULL)
+		{
+			for (j = 0; j < mavlink_parameters_list[i].param_size; j++)
+			{
+				crc_accumulate(mavlink_parameters_list[i].pparam[j], &crc_values);
+			}
+		}
+	}
+	return ((uint32_t)crc_names << 16) | crc_values;
+}
+
+static void mavlink_send_param_hash(void)
+{
+	mavlink_param_union_t param;
+
+	param.param_uint32 = param_table_hash();
+	mavlink_msg_param_value_send(MAVLINK_COMM_0, param_hash_name,
+	    param.param_float, MAVLINK_TYPE_UINT32_T, count_of_parameters_list, -1);
+}
+
 // END OF GENERAL ROUTINES FOR CHANGING UAV ONBOARD PARAMETERS
 
+static void param_read_queue_add(int16_t i)
+{
+	uint8_t n;
+
+	for (n = 0; n < param_read_count; n++)
+	{
+		if (param_read_queue[(param_read_head + n) % PARAM_READ_QUEUE] == i)
+		{
+			return;                     // already queued
+		}
+	}
+	if (param_read_count < PARAM_READ_QUEUE)
+	{
+		param_read_queue[(param_read_head + param_read_count) % PARAM_READ_QUEUE] = i;
+		param_read_count++;
+	}
+}
+
 static int16_t get_param_index(const char* key)
 {
 	int16_t i;
@@ -426,11 +496,7 @@ static void MAVParamsSet(const mavlink_message_t* handle_msg)
 				DPRINT("parameter[%i] %s, %f out of bounds\r\n", i, (const char*)packet.param_id, (double)param.param_float);
 			}
 			// Send the parameter back to GCS as acknowledgement of success, or otherwise
-			if (mavlink_flags.mavlink_send_specific_variable == 0)
-			{
-				send_by_index = i;
-				mavlink_flags.mavlink_send_specific_variable = 1;
-			}
+			param_read_queue_add(i);
 		}
 		else
 		{
@@ -495,14 +561,22 @@ static void MAVParamsRequestRead(const mavlink_message_t* handle_msg)
 	if (packet.target_system == mavlink_system.sysid)
 	{
 //		const char* key = (const char*)packet.param_id;
-		packet.param_index = get_param_index((const char*)packet.param_id);
-		if ((packet.param_index >= 0) && (packet.param_index <= count_of_parameters_list))
+		if (packet.param_index < 0)
+		{
+			if (strncmp((const char*)packet.param_id, param_hash_name, sizeof(packet.param_id)) == 0)
+			{
+				DPRINT("Requested parameter table hash\r\n");
+				param_read_queue_add(PARAM_HASH_INDEX);
+				return;
+			}
+			packet.param_index = get_param_index((const char*)packet.param_id);
+		}
+		// a ground station fills the gaps of a list download by index
+		if ((packet.param_index >= 0) && (packet.param_index < count_of_parameters_list))
 		{
 //			DPRINT("Requested specific parameter %u %u\r\n", packet.param_index, count_of_parameters_list);
 			DPRINT("Requested specific parameter %u %s\r\n", packet.param_index, (const char*)packet.param_id);
-			send_by_index = packet.param_index;
-			mavlink_flags.mavlink_send_specific_variable = 1;
-			DPRINT("Sending specific parameter\r\n");
+			param_read_queue_add(packet.param_index);
 		}
 	}
 }
@@ -537,27 +611,40 @@ boolean MAVParamsHandleMessage(mavlink_message_t* handle_msg)
 
 void MAVParamsOutput_40hz(void)
 {
+	// SEND SPECIFICALLY REQUESTED PARAMETERS
+	while (param_read_count > 0 && mavlink_bulk_tx_space() >= PARAM_VALUE_BYTES)
+	{
+		int16_t i = param_read_queue[param_read_head];
+
+		param_read_head = (param_read_head + 1) % PARAM_READ_QUEUE;
+		param_read_count--;
+		if (i == PARAM_HASH_INDEX)
+		{
+			mavlink_send_param_hash();
+		}
+		else
+		{
+			mavlink_parameter_parsers[mavlink_parameters_list[i].udb_param_type].send_param(i);
+		}
+	}
+
 	// SEND VALUES OF PARAMETERS IF THE LIST HAS BEEN REQUESTED
+	// Each tick sends as many as fit in the bulk allowance the other streams
+	// have left. Parameters missed by the GCS are read by index.
 	if (mavlink_flags.mavlink_send_variables == 1)
 	{
-		if (send_variables_counter < count_of_parameters_list)
+		while (send_variables_counter < count_of_parameters_list &&
+		       mavlink_bulk_tx_space() >= PARAM_VALUE_BYTES)
 		{
 			mavlink_parameter_parsers[mavlink_parameters_list[send_variables_counter].udb_param_type].send_param(send_variables_counter);
 			send_variables_counter++;
 		}
-		else
+		if (send_variables_counter >= count_of_parameters_list)
 		{
 			send_variables_counter = 0;
 			mavlink_flags.mavlink_send_variables = 0;
 		}
 	}
-
-	// SEND SPECIFICALLY REQUESTED PARAMETER
-	if (mavlink_flags.mavlink_send_specific_variable == 1)
-	{
-		mavlink_parameter_parsers[mavlink_parameters_list[send_by_index].udb_param_type].send_param(send_by_index);
-		mavlink_flags.mavlink_send_specific_variable = 0;
-	}
 }
 
 #endif // (USE_MAVLINK == 1)
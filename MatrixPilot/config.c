@@ -33,6 +33,8 @@
 #include "minIni.h"
 #include "navigate.h"
 #include "airspeedCntrl.h"
+#include "helicalTurnCntrl.h"
+#include "../libFlashFS/filesys.h"
 
 
 union settings_word settings;
@@ -314,6 +316,7 @@ void config_load(void)
 	init_pitchCntrl();
 
 	init_navigation();
+	init_helicalTurnCntrl();
 	init_airspeedCntrl();
 	init_altitudeCntrl();
 	init_altitudeCntrlVariable();
@@ -336,6 +339,7 @@ void config_save(void)
 	save_settings();
 	save_gains();
 	save_turns();
+	filesys_flush();
 }
 
 void config_init(void)
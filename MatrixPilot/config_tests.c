@@ -251,6 +251,14 @@
 	#error("HILSIM_USB only supported on AUAV3 board"
 #endif
 
+#if ((USE_CDC_TELEMETRY == 1) && ((USE_USB != 1) || (USE_CDC != 1)))
+	#error("USE_CDC_TELEMETRY requires USE_USB and USE_CDC"
+#endif
+
+#if ((USE_CDC_TELEMETRY == 1) && (HILSIM_USB == 1))
+	#error("USE_CDC_TELEMETRY can not share the USB CDC port with HILSIM_USB"
+#endif
+
 #ifdef INVERTED_NEUTRAL_PITCH
 #ifdef ANGLE_OF_ATTACK_INVERTED
 #error ( "Both INVERTED_NEUTRAL_PITCH and ANGLE_OF_ATTACK_INVERTED are being used. Use only one or the other."
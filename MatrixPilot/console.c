@@ -281,6 +281,15 @@ static void cmd_close(char* arg)
 #endif
 }
 
+void filesys_export(void);
+
+static void cmd_export(char* arg)
+{
+#if (USE_FILESYS == 1)
+	filesys_export();
+#endif
+}
+
 //void navigate_print(void);
 static void cmd_nav(char* arg)
 {
@@ -308,6 +317,7 @@ const cmds_t cmdslist[] = {
 	{ 0, cmd_reset,  "reset" },
 	{ 0, cmd_trap,   "trap" },
 	{ 0, cmd_close,  "close" },
+	{ 0, cmd_export, "export" },
 };
 
 static void cmd_help(char* arg)
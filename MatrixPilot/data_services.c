@@ -228,6 +228,7 @@ static void data_services_init_all_callback(boolean success)
 {
 	if (success) data_services_table_index++;
 	data_service_state = DATA_SERVICE_STATE_INIT_ALL;
+	data_services_trigger();
 }
 
 // Calculate the size of the complete list of variable items in bytes
@@ -282,6 +283,7 @@ static void data_services_read_index(void)
 		if (data_services_do_all_areas == true)
 		{
 			data_services_table_index++;
+			data_services_trigger();
 		}
 		else
 		{
@@ -303,6 +305,7 @@ boolean data_services_save_all(uint16_t serialize_flags, DSRV_callbackFunc pcall
 	data_services_table_index     = 0;
 	data_services_do_all_areas    = true;
 	data_service_state            = DATA_SERVICE_STATE_WRITE;
+	data_services_trigger();
 
 	return true;
 }
@@ -321,7 +324,7 @@ boolean data_services_load_specific(uint16_t data_storage_handle, DSRV_callbackF
 	data_services_serialize_flags = STORAGE_FLAG_ALL;   // Flag to read regardless of flags
 	data_service_state = DATA_SERVICE_STATE_READ;
 
-	return false;
+	return true;
 }
 
 // Request to load all memory areas from the table which match the serialize flags
@@ -356,18 +359,23 @@ static void data_services_read_done(void)
 
 	data_services_table_index++;
 	data_service_state = DATA_SERVICE_STATE_READ;
+	data_services_trigger();
 }
 
 // Called when storage manager data read has finished
 static void data_services_read_callback(boolean success)
 {
 	if (success)
+	{
 		data_service_state = DATA_SERVICE_STATE_READ_DONE;
+		data_services_trigger();
+	}
 	else
 		if (data_services_do_all_areas == true)
 		{
 			data_services_table_index++;
 			data_service_state = DATA_SERVICE_STATE_READ;
+			data_services_trigger();
 		}
 		else
 		{
@@ -461,7 +469,8 @@ boolean data_services_save_specific(uint16_t data_storage_handle, DSRV_callbackF
 	data_services_serialize_flags = STORAGE_FLAG_ALL;   // Flag to write regardless of flags
 
 	data_service_state = DATA_SERVICE_STATE_WRITE;
-	return false;
+	data_services_trigger();
+	return true;
 }
 
 // Start the write of a checksummed structure
@@ -505,7 +514,10 @@ static void data_services_write(void)
 	else
 	{
 		if (data_services_do_all_areas == true)
+		{
 			data_services_table_index++;
+			data_services_trigger();
+		}
 		else
 		{
 			if (data_services_user_callback != NULL) data_services_user_callback(false);
@@ -524,6 +536,7 @@ static void data_services_write_callback(boolean success)
 		{
 			data_services_table_index++;
 			data_service_state = DATA_SERVICE_STATE_WRITE;
+			data_services_trigger();
 		}
 		else
 		{
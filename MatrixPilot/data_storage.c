@@ -28,6 +28,23 @@
 //
 // Uses X.25 checksum from MAVink libraries
 //
+// The free space between the areas is kept as a list in address order,
+// rebuilt from the table whenever the table changes. Areas are allocated
+// first fit from it. At startup areas are moved down into holes that hold
+// them whole, and the table is only rewritten once an area has been copied,
+// so a power failure during compaction leaves the old copy in use.
+//
+// The table is kept in two slots at the bottom of memory, each with a
+// generation and a checksum. A table write goes to the slot not in use, so
+// a power failure during the write leaves the other copy to start from.
+//
+// A checksummed structure also has two slots, each a header followed by
+// the data. A save is written to the older slot with the next generation,
+// with its header in the same page as the start of its data, and that page
+// is written last, so the header is only ever committed over complete data.
+// Reading uses the newest slot that checks, or else the other one. Areas
+// whose data has not changed since they were last read or written are not
+// written again.
 //
 
 #include "../libUDB/libUDB.h"
@@ -48,17 +65,21 @@ enum
 {
 	DATA_STORAGE_STATUS_START,
 	DATA_STORAGE_STATUS_INIT,
+	DATA_STORAGE_READ_TABLE_B,
 	DATA_STORAGE_CHECK_TABLE,
 	DATA_STORAGE_FORMAT_TABLE,
 	DATA_STORAGE_STATUS_WAITING,
 
 	DATA_STORAGE_READ,
+	DATA_STORAGE_READ_HEADER,
 	DATA_STORAGE_READING_HEADER,
 	DATA_STORAGE_READ_HEADER_COMPLETE,
+	DATA_STORAGE_READ_SLOT,
 	DATA_STORAGE_READING_DATA,
 	DATA_STORAGE_READ_DATA_COMPLETE,
 
 	DATA_STORAGE_WRITE,
+	DATA_STORAGE_WRITE_SLOT,
 	DATA_STORAGE_WRITING_DATA,
 	DATA_STORAGE_WRITING_DATA_COMPLETE,
 	DATA_STORAGE_WRITING_HEADER,
@@ -72,6 +93,17 @@ enum
 
 	DATA_STORAGE_AREA_CLEAR,
 	DATA_STORAGE_AREA_CLEARING,
+
+	DATA_STORAGE_AREA_DELETE,
+	DATA_STORAGE_AREA_RESIZE,
+
+	DATA_STORAGE_COMPACT,
+	DATA_STORAGE_MOVE_READ,
+	DATA_STORAGE_MOVE_READING,
+	DATA_STORAGE_MOVE_WRITE,
+	DATA_STORAGE_MOVE_WRITING,
+	DATA_STORAGE_MOVE_COMMIT,
+	DATA_STORAGE_MOVE_COMMITTING,
 } DATA_STORAGE_STATUS;
 
 static uint16_t data_storage_status = DATA_STORAGE_STATUS_START;
@@ -86,8 +118,20 @@ static boolean data_storage_check_table(void);
 // Format the data storage table
 static boolean data_storage_format_table(void);
 
-// Find a hole of size data_storage_size and return its address.
-static uint16_t data_storage_find_hole(uint16_t data_storage_size);
+// Rebuild the list of free space from the table
+static void data_storage_build_free_list(void);
+
+// Find free space of size data_storage_size and return its address.
+static uint16_t data_storage_alloc(uint16_t data_storage_size);
+
+// Size of the free space starting at address
+static uint16_t data_storage_free_after(uint16_t address);
+
+// Start moving the next area that fits into a hole below it
+static void data_storage_compact(void);
+
+// Resize an area in place or move it
+static void storage_resize_specific_area(void);
 
 // Clear a specific data area by invalidating the checksum and writing it to eeprom table
 static void storage_clear_specific_area(void);
@@ -97,6 +141,7 @@ static void storage_clear_specific_area(void);
 // The callbacks normally set the status so that the background service routine does the work.
 static void data_storage_format_callback(boolean success);     // format write is completed
 static void data_storage_init_read_callback(boolean success);  // initialisation read of storage table
+static void data_storage_init_read_b_callback(boolean success);// initialisation read of second storage table
 
 static void storage_write_callback(boolean success);           // Data write callback
 static void storage_write_header_callback(boolean success);    // Header write callback
@@ -105,9 +150,14 @@ static void storage_read_header_callback(boolean success);     // Header read ca
 static void storage_read_data_callback(boolean success);       // Data read callback
 
 static void data_storage_write_table_callback(boolean success);// Table write callback
+static void data_storage_table_written(boolean success);       // Table slot write callback
 
 static void storage_clear_specific_area_callback(boolean success); // Clear specific data area finished callback
 
+static void storage_move_read_callback(boolean success);       // Area move page read callback
+static void storage_move_write_callback(boolean success);      // Area move page write callback
+static void storage_move_commit_callback(boolean success);     // Area move table write callback
+
 // A constant preamble used to determine the start of a data block
 // This also allows the data to be found if the FAT is broken
 static const uint8_t data_storage_preamble[] = {0xAA, 0x5A, 0xA5, 0x55};
@@ -122,18 +172,240 @@ static const uint8_t table_invalid_preamble[] = {0x01, 0x10, 0x01, 0x10};
 // Structure in ram of complete data directory including checksum.
 static DATA_STORAGE_TABLE data_storage_table;
 
+// The second table slot, only used while choosing between them at startup
+static DATA_STORAGE_TABLE data_storage_table_b;
+
+// Slot holding the table in ram, the next table write goes to the other one
+static uint16_t data_storage_table_slot = 0;
+
+// User callback for the table write in progress
+static NVMemory_callbackFunc data_storage_table_callback = NULL;
+
 // Callers data.  Used on initialisation, reading or writing an area.
 static uint8_t* pdata_storage_data     = NULL;
 static uint16_t data_storage_type      = DATA_STORAGE_NULL;
 static uint16_t data_storage_size      = 0;     // Storage size including header
 static uint16_t data_storage_data_size = 0;     // Storage size of data only
+static uint16_t data_storage_offset    = 0;     // Offset into a self managed area
 static uint16_t data_storage_handle    = INVALID_HANDLE;
 static DS_callbackFunc data_storage_user_callback = NULL;
 
 static DATA_STORAGE_HEADER data_storage_header; // Buffer for header information
 
+// Headers of both slots of a checksummed structure, the slot being accessed,
+// and whether the other slot can still be read if this one fails its checksum
+static DATA_STORAGE_HEADER data_storage_slot_header[2];
+static uint16_t data_storage_slot = 0;
+static boolean data_storage_slot_fallback = false;
+static boolean data_storage_writing = false;   // Slot headers are read ahead of a write
+
+// Generation and slot of each checksummed structure's newest copy, valid when the area's bit is set
+static uint16_t data_storage_generation[MAX_DATA_HANDLES];
+static uint32_t data_storage_slot_known = 0;
+static uint32_t data_storage_slot_b = 0;
+
+// The first page of a checksummed structure, its header followed by the start of the data
+static uint8_t data_storage_first_page[FAT_CHUNK_BYTE_SIZE];
+
+// Checksums of each area's data as it is in nv memory, valid when the area's bit is set
+static uint16_t data_storage_clean_checksum[MAX_DATA_HANDLES];
+static uint16_t data_storage_clean_sum[MAX_DATA_HANDLES];
+static uint32_t data_storage_clean_flags = 0;
+static uint16_t data_storage_write_sum;
+
 static uint16_t data_storage_event_handle = INVALID_HANDLE;
 
+// Free space between the areas, in address order
+typedef struct tagDATA_STORAGE_EXTENT
+{
+	uint16_t address;
+	uint16_t size;
+} DATA_STORAGE_EXTENT;
+
+static DATA_STORAGE_EXTENT data_storage_free[MAX_DATA_HANDLES + 1];
+static uint16_t data_storage_free_count = 0;
+
+// Area being moved, by compaction or by a resize
+static uint16_t data_storage_move_from = 0;
+static uint16_t data_storage_move_to = 0;
+static uint16_t data_storage_move_size = 0;         // bytes to copy
+static uint16_t data_storage_move_offset = 0;
+static uint16_t data_storage_move_area_size = 0;    // size of the area once moved
+static boolean data_storage_compacting = false;
+
+// Round a size up to whole pages
+static inline uint16_t storage_page_size(uint16_t size)
+{
+	return ((size + FAT_CHUNK_BYTE_SIZE - 1) / FAT_CHUNK_BYTE_SIZE) * FAT_CHUNK_BYTE_SIZE;
+}
+
+// Space taken in nv memory by an area, a checksummed structure has two slots
+static uint16_t storage_area_span(uint16_t data_type, uint16_t data_size)
+{
+	uint16_t size = storage_page_size(data_size);
+
+	if (data_type == DATA_STORAGE_CHECKSUM_STRUCT)
+		size *= 2;
+	return size;
+}
+
+// Address of a slot of the area at data_storage_handle
+static uint16_t storage_slot_address(uint16_t slot)
+{
+	DATA_STORAGE_ENTRY* pEntry = &data_storage_table.table[data_storage_handle];
+
+	return pEntry->data_address + (slot * storage_page_size(pEntry->data_size));
+}
+
+// True if generation a is newer than generation b, allowing for wrap round
+static inline boolean storage_generation_newer(uint16_t a, uint16_t b)
+{
+	return ((int16_t)(a - b) > 0);
+}
+
+// Checksum of the table, covering everything before the checksum itself
+static uint16_t data_storage_table_checksum(DATA_STORAGE_TABLE* pTable)
+{
+	return crc_calculate((uint8_t*) pTable, (uint8_t*) &pTable->table_checksum - (uint8_t*) pTable);
+}
+
+// Write the table to nv memory, in the slot not holding the current table
+static boolean data_storage_write_table(NVMemory_callbackFunc callback)
+{
+	data_storage_table.table_generation++;
+	data_storage_table.table_checksum = data_storage_table_checksum(&data_storage_table);
+	data_storage_table_callback = callback;
+
+	return udb_nv_memory_write((uint8_t*) &data_storage_table, 
+	    (1 - data_storage_table_slot) * storage_page_size(sizeof(data_storage_table)), 
+	    sizeof(data_storage_table), 
+	    &data_storage_table_written);
+}
+
+// The table slot written becomes the current one once the write is complete
+static void data_storage_table_written(boolean success)
+{
+	if (success)
+		data_storage_table_slot = 1 - data_storage_table_slot;
+
+	if (data_storage_table_callback != NULL)
+		data_storage_table_callback(success);
+}
+
+// A plain sum, so that a change that the X.25 checksum misses is still seen
+static uint16_t data_storage_sum(const uint8_t* pData, uint16_t size)
+{
+	uint16_t sum = 0;
+
+	while (size--)
+	{
+		sum += *pData++;
+	}
+	return sum;
+}
+
+static void storage_set_clean(uint16_t data_handle, uint16_t checksum, uint16_t sum)
+{
+	data_storage_clean_checksum[data_handle] = checksum;
+	data_storage_clean_sum[data_handle] = sum;
+	data_storage_clean_flags |= (1UL << data_handle);
+}
+
+static void storage_set_dirty(uint16_t data_handle)
+{
+	if (data_handle < MAX_DATA_HANDLES)
+	{
+		data_storage_clean_flags &= ~(1UL << data_handle);
+	}
+}
+
+static boolean storage_is_clean(uint16_t data_handle, uint16_t checksum, uint16_t sum)
+{
+	return ((data_storage_clean_flags & (1UL << data_handle)) &&
+	        data_storage_clean_checksum[data_handle] == checksum &&
+	        data_storage_clean_sum[data_handle] == sum);
+}
+
+static void storage_set_slot(uint16_t data_handle, uint16_t slot, uint16_t generation)
+{
+	data_storage_generation[data_handle] = generation;
+	data_storage_slot_known |= (1UL << data_handle);
+	if (slot)
+		data_storage_slot_b |= (1UL << data_handle);
+	else
+		data_storage_slot_b &= ~(1UL << data_handle);
+}
+
+// The area's slots are read again before it is next written
+static void storage_forget_slot(uint16_t data_handle)
+{
+	if (data_handle < MAX_DATA_HANDLES)
+	{
+		data_storage_slot_known &= ~(1UL << data_handle);
+	}
+}
+
+// Check a slot header read belongs to the area being accessed
+static boolean storage_slot_header_valid(uint16_t slot)
+{
+	if (memcmp(data_storage_slot_header[slot].data_preamble, data_storage_preamble, DATA_PREAMBLE_SIZE) != 0) return false;
+	if (data_storage_slot_header[slot].data_handle != data_storage_handle) return false;
+	return true;
+}
+
+// Choose the slot with the newest valid header
+// return false if neither slot has a valid header
+static boolean storage_select_slot(void)
+{
+	boolean valid_a = storage_slot_header_valid(0);
+	boolean valid_b = storage_slot_header_valid(1);
+
+	data_storage_slot_fallback = (valid_a && valid_b);
+
+	if (valid_a && valid_b)
+		data_storage_slot = storage_generation_newer(data_storage_slot_header[1].data_version, data_storage_slot_header[0].data_version) ? 1 : 0;
+	else if (valid_b)
+		data_storage_slot = 1;
+	else if (valid_a)
+		data_storage_slot = 0;
+	else
+		return false;
+	return true;
+}
+
+// Start reading the header of slot data_storage_slot
+static void storage_read_slot_header(void)
+{
+	if (udb_nv_memory_read((uint8_t*) &data_storage_slot_header[data_storage_slot], 
+	    storage_slot_address(data_storage_slot), 
+	    sizeof(DATA_STORAGE_HEADER),
+	    &storage_read_header_callback) == false)
+	{
+		if (data_storage_user_callback != NULL)
+			data_storage_user_callback(false);
+		data_storage_status = DATA_STORAGE_STATUS_WAITING;
+	}
+	else
+		data_storage_status = DATA_STORAGE_READING_HEADER;
+}
+
+// Bytes of a checksummed structure slot that lie in its first page
+static uint16_t storage_first_page_size(void)
+{
+	uint16_t address = storage_slot_address(data_storage_slot);
+	uint16_t size = FAT_CHUNK_BYTE_SIZE - (address % FAT_CHUNK_BYTE_SIZE);
+
+	if (size < sizeof(DATA_STORAGE_HEADER))
+	{
+		size = sizeof(DATA_STORAGE_HEADER);
+	}
+	if (size > data_storage_size)
+	{
+		size = data_storage_size;
+	}
+	return size;
+}
+
 // Status of storage services
 boolean storage_services_started(void)
 {
@@ -142,6 +414,7 @@ boolean storage_services_started(void)
 	case DATA_STORAGE_STATUS_START:
 	case DATA_STORAGE_CHECK_TABLE:
 	case DATA_STORAGE_STATUS_INIT:
+	case DATA_STORAGE_READ_TABLE_B:
 		return false;
 	}
 	return true;
@@ -156,6 +429,8 @@ static void data_storage_service(void)
 	case DATA_STORAGE_STATUS_START:
 		data_storage_table.table_preamble[0] = 0x00; // Make sure memory contents are invalid before reading
 		data_storage_table.table_checksum = 0x0000;
+		data_storage_table_b.table_preamble[0] = 0x00;
+		data_storage_table_b.table_checksum = 0x0000;
 
 		// Loading the data storage table.  Set status as running initialisation.
 		// If NV memory not ready, immediate return.
@@ -163,24 +438,32 @@ static void data_storage_service(void)
 		data_storage_status = DATA_STORAGE_STATUS_INIT;
 		break;
 
+	case DATA_STORAGE_READ_TABLE_B:
+		if (udb_nv_memory_read((uint8_t*) &data_storage_table_b, storage_page_size(sizeof(data_storage_table)), sizeof(data_storage_table_b), &data_storage_init_read_b_callback) == false) return;
+		data_storage_status = DATA_STORAGE_STATUS_INIT;
+		break;
+
 	case DATA_STORAGE_CHECK_TABLE:
+	{
+		boolean table_ok = data_storage_check_table();
 
 #if (MANUAL_ERASE_TABLE  == 1)
-		if (!data_storage_format_table())
-			data_storage_status = DATA_STORAGE_STATUS_START;
-#else
-		if (data_storage_check_table() == false)
+		table_ok = false;
+#endif
+		if (table_ok == false)
 		{
-			// If table check fails then format the table
+			// If neither table checks then format the table
 			if (!data_storage_format_table())
 				data_storage_status = DATA_STORAGE_STATUS_START;
 		}
 		else
 		{
-			data_storage_status = DATA_STORAGE_STATUS_WAITING;
+			data_storage_build_free_list();
+			data_storage_compacting = true;
+			data_storage_status = DATA_STORAGE_COMPACT;
+			storage_service_trigger();
 		}
-#endif
-		break;
+	}	break;
 
 	case DATA_STORAGE_WRITE:
 		// Write data to nv memory
@@ -189,20 +472,34 @@ static void data_storage_service(void)
 		switch (data_storage_type)
 		{
 		case DATA_STORAGE_CHECKSUM_STRUCT:
-			if (udb_nv_memory_write(pdata_storage_data, 
-			    data_storage_table.table[data_storage_handle].data_address + sizeof(DATA_STORAGE_HEADER), 
-			    data_storage_data_size, 
-			    &storage_write_callback) == false)
+			data_storage_header.data_checksum = crc_calculate((uint8_t*)pdata_storage_data, data_storage_data_size);
+			data_storage_write_sum = data_storage_sum(pdata_storage_data, data_storage_data_size);
+
+			// Nothing to write if the data is already in nv memory
+			if (storage_is_clean(data_storage_handle, data_storage_header.data_checksum, data_storage_write_sum))
 			{
-				if (data_storage_user_callback != NULL)
-					data_storage_user_callback(false);
 				data_storage_status = DATA_STORAGE_STATUS_WAITING;
+				if (data_storage_user_callback != NULL)
+					data_storage_user_callback(true);
 				return;
 			}
-			break;
+			storage_set_dirty(data_storage_handle);
+
+			// Read the slot headers first if the newest slot is not known
+			if ((data_storage_slot_known & (1UL << data_storage_handle)) == 0)
+			{
+				data_storage_writing = true;
+				data_storage_slot = 0;
+				storage_read_slot_header();
+				return;
+			}
+			data_storage_status = DATA_STORAGE_WRITE_SLOT;
+			storage_service_trigger();
+			return;
+
 		case DATA_STORAGE_SELF_MANAGED:
 			if (udb_nv_memory_write(pdata_storage_data, 
-			    data_storage_table.table[data_storage_handle].data_address, 
+			    data_storage_table.table[data_storage_handle].data_address + data_storage_offset, 
 			    data_storage_size, 
 			    &storage_write_callback) == false)
 			{
@@ -217,20 +514,53 @@ static void data_storage_service(void)
 		data_storage_status = DATA_STORAGE_WRITING_DATA;	
 		break;
 
+	case DATA_STORAGE_WRITE_SLOT:
+	{
+		uint16_t first_page_size;
+
+		// Write to the slot not holding the newest copy
+		data_storage_slot = (data_storage_slot_b & (1UL << data_storage_handle)) ? 0 : 1;
+		first_page_size = storage_first_page_size();
+
+		// Write the data after the first page, the first page is written last
+		if (data_storage_size == first_page_size)
+		{
+			data_storage_status = DATA_STORAGE_WRITING_DATA_COMPLETE;
+			storage_service_trigger();
+			break;
+		}
+		if (udb_nv_memory_write(pdata_storage_data + first_page_size - sizeof(DATA_STORAGE_HEADER), 
+		    storage_slot_address(data_storage_slot) + first_page_size, 
+		    data_storage_size - first_page_size, 
+		    &storage_write_callback) == false)
+		{
+			if (data_storage_user_callback != NULL)
+				data_storage_user_callback(false);
+			data_storage_status = DATA_STORAGE_STATUS_WAITING;
+		}
+		else
+			data_storage_status = DATA_STORAGE_WRITING_DATA;
+	}	break;
+
 		case DATA_STORAGE_WRITING_DATA_COMPLETE:
 		{
 			switch (data_storage_type)
 			{
 			case DATA_STORAGE_CHECKSUM_STRUCT:
 			{
-				data_storage_header.data_checksum = crc_calculate((uint8_t*)pdata_storage_data, data_storage_data_size);
+				uint16_t first_page_size = storage_first_page_size();
+
 				data_storage_header.data_handle = data_storage_handle;
-				data_storage_header.data_version = 0;
+				data_storage_header.data_version = data_storage_generation[data_storage_handle] + 1;
 				memcpy(data_storage_header.data_preamble, data_storage_preamble, sizeof(data_storage_preamble));
 
-				if (udb_nv_memory_write((uint8_t*)&data_storage_header,
-				    data_storage_table.table[data_storage_handle].data_address,
-				    sizeof(DATA_STORAGE_HEADER),
+				// The header and the start of the data go in one page write
+				memcpy(data_storage_first_page, &data_storage_header, sizeof(DATA_STORAGE_HEADER));
+				memcpy(&data_storage_first_page[sizeof(DATA_STORAGE_HEADER)], pdata_storage_data, first_page_size - sizeof(DATA_STORAGE_HEADER));
+
+				if (udb_nv_memory_write(data_storage_first_page,
+				    storage_slot_address(data_storage_slot),
+				    first_page_size,
 				    &storage_write_header_callback) == false)
 				{
 					if (data_storage_user_callback != NULL)
@@ -257,21 +587,13 @@ static void data_storage_service(void)
 		switch (data_storage_type)
 		{
 		case DATA_STORAGE_CHECKSUM_STRUCT:
-			if (udb_nv_memory_read((uint8_t*) &data_storage_header, 
-			    data_storage_table.table[data_storage_handle].data_address, 
-			    sizeof(DATA_STORAGE_HEADER),
-			    &storage_read_header_callback) == false)
-			{
-				if (data_storage_user_callback != NULL)
-					data_storage_user_callback(false);
-				data_storage_status = DATA_STORAGE_STATUS_WAITING;
-			}
-			else
-				data_storage_status = DATA_STORAGE_READING_HEADER;	
+			data_storage_writing = false;
+			data_storage_slot = 0;
+			storage_read_slot_header();
 			break;
 		case DATA_STORAGE_SELF_MANAGED:
 			if (udb_nv_memory_read(pdata_storage_data, 
-			    data_storage_table.table[data_storage_handle].data_address, 
+			    data_storage_table.table[data_storage_handle].data_address + data_storage_offset, 
 			    data_storage_size,
 			    &storage_read_data_callback) == false)
 			{
@@ -286,10 +608,35 @@ static void data_storage_service(void)
 		break;
 
 
+	case DATA_STORAGE_READ_HEADER:
+		storage_read_slot_header();
+		break;
+
 	case DATA_STORAGE_READ_HEADER_COMPLETE:
-	{
+		if (data_storage_writing == true)
+		{
+			// Before a write only the headers are needed, to find the slot to write
+			if (storage_select_slot())
+				storage_set_slot(data_storage_handle, data_storage_slot, data_storage_slot_header[data_storage_slot].data_version);
+			else
+				storage_set_slot(data_storage_handle, 1, 0);
+			data_storage_status = DATA_STORAGE_WRITE_SLOT;
+			storage_service_trigger();
+			break;
+		}
+		if (storage_select_slot() == false)
+		{
+			data_storage_status = DATA_STORAGE_STATUS_WAITING;
+			if (data_storage_user_callback != NULL) data_storage_user_callback(false);
+			break;
+		}
+		data_storage_status = DATA_STORAGE_READ_SLOT;
+		storage_service_trigger();
+		break;
+
+	case DATA_STORAGE_READ_SLOT:
 		if (udb_nv_memory_read(pdata_storage_data, 
-		    data_storage_table.table[data_storage_handle].data_address + sizeof(DATA_STORAGE_HEADER), 
+		    storage_slot_address(data_storage_slot) + sizeof(DATA_STORAGE_HEADER), 
 		    data_storage_data_size,
 		    &storage_read_data_callback) == false)
 		{
@@ -298,7 +645,6 @@ static void data_storage_service(void)
 		}
 		else
 			data_storage_status = DATA_STORAGE_READING_DATA;	
-	}
 		break;
 
 	case DATA_STORAGE_READ_DATA_COMPLETE:
@@ -307,16 +653,27 @@ static void data_storage_service(void)
 
 		if (data_storage_type == DATA_STORAGE_CHECKSUM_STRUCT)
 		{
-			// If handle is incorrect then fail
-			if (data_storage_header.data_handle != data_storage_handle)  success = false;
-	
-			// If preamble is incorrect then fail
-			if (memcmp(data_storage_header.data_preamble, data_storage_preamble, 4) != 0)  success = false;
-	
-			// If checksum is incorrect then fail.
+			DATA_STORAGE_HEADER* pHeader = &data_storage_slot_header[data_storage_slot];
 
-			if (data_storage_header.data_checksum != crc_calculate((uint8_t*) pdata_storage_data, data_storage_data_size))
+			// If checksum is incorrect then fail, or try the other slot if it has a valid header
+			if (pHeader->data_checksum != crc_calculate((uint8_t*) pdata_storage_data, data_storage_data_size))
+			{
+				if (data_storage_slot_fallback == true)
+				{
+					data_storage_slot_fallback = false;
+					data_storage_slot = 1 - data_storage_slot;
+					data_storage_status = DATA_STORAGE_READ_SLOT;
+					storage_service_trigger();
+					break;
+				}
 				success = false;
+			}
+
+			if (success)
+			{
+				storage_set_clean(data_storage_handle, pHeader->data_checksum, data_storage_sum(pdata_storage_data, data_storage_data_size));
+				storage_set_slot(data_storage_handle, data_storage_slot, pHeader->data_version);
+			}
 		}
 
 		// Status to waiting and callback the user with result
@@ -326,9 +683,20 @@ static void data_storage_service(void)
 
 
 	case DATA_STORAGE_AREA_CREATE:
-		if ((data_storage_table.table[data_storage_handle].data_address = data_storage_find_hole(data_storage_size)) == 0)
+	{
+		DATA_STORAGE_ENTRY old_entry = data_storage_table.table[data_storage_handle];
+
+		// An area the handle already has is released first, so that its space is reused
+		data_storage_table.table[data_storage_handle].data_address = 0;
+		data_storage_table.table[data_storage_handle].data_size = 0;
+		data_storage_table.table[data_storage_handle].data_type = DATA_STORAGE_NULL;
+		data_storage_build_free_list();
+
+		if ((data_storage_table.table[data_storage_handle].data_address = data_storage_alloc(storage_area_span(data_storage_type, data_storage_size))) == 0)
 		{
 			// Failed to find space for new data area
+			data_storage_table.table[data_storage_handle] = old_entry;
+			data_storage_build_free_list();
 			if (data_storage_user_callback != NULL)
 				data_storage_user_callback(false);
 			data_storage_status = DATA_STORAGE_STATUS_WAITING;
@@ -337,18 +705,16 @@ static void data_storage_service(void)
 		
 		data_storage_table.table[data_storage_handle].data_size = data_storage_size;
 		data_storage_table.table[data_storage_handle].data_type = data_storage_type;
+		storage_set_dirty(data_storage_handle);
+		storage_forget_slot(data_storage_handle);
 
 		data_storage_status = DATA_STORAGE_AREA_CREATING;
 
-		// Calculate the checksum
-		data_storage_table.table_checksum = crc_calculate((uint8_t*) data_storage_table.table, sizeof(*data_storage_table.table));
-
 		// Store the table.  If storage area create fails, put the services in wait.
-		if (udb_nv_memory_write((uint8_t*) &data_storage_table, 0, sizeof(data_storage_table), &data_storage_write_table_callback) == false)
+		if (data_storage_write_table(&data_storage_write_table_callback) == false)
 		{
-			data_storage_table.table[data_storage_handle].data_size = 0;
-			data_storage_table.table[data_storage_handle].data_type = 0;
-			data_storage_table.table[data_storage_handle].data_address = 0;
+			data_storage_table.table[data_storage_handle] = old_entry;
+			data_storage_build_free_list();
 
 			if (data_storage_user_callback != NULL)
 				data_storage_user_callback(false);
@@ -359,16 +725,88 @@ static void data_storage_service(void)
 		else
 			data_storage_status = DATA_STORAGE_AREA_CREATING;	
 
-		break;
+	}	break;
 
 	case DATA_STORAGE_AREA_CLEAR:
 		storage_clear_specific_area();
 		break;
+
+	case DATA_STORAGE_AREA_DELETE:
+	{
+		DATA_STORAGE_ENTRY old_entry = data_storage_table.table[data_storage_handle];
+
+		storage_set_dirty(data_storage_handle);
+		storage_forget_slot(data_storage_handle);
+		data_storage_table.table[data_storage_handle].data_address = 0;
+		data_storage_table.table[data_storage_handle].data_size = 0;
+		data_storage_table.table[data_storage_handle].data_type = DATA_STORAGE_NULL;
+
+		if (data_storage_write_table(&data_storage_write_table_callback) == false)
+		{
+			data_storage_table.table[data_storage_handle] = old_entry;
+			if (data_storage_user_callback != NULL)
+				data_storage_user_callback(false);
+			data_storage_status = DATA_STORAGE_STATUS_WAITING;
+		}
+		else
+			data_storage_status = DATA_STORAGE_AREA_CREATING;
+	}	break;
+
+	case DATA_STORAGE_AREA_RESIZE:
+		storage_resize_specific_area();
+		break;
+
+	case DATA_STORAGE_COMPACT:
+		data_storage_compact();
+		break;
+
+	case DATA_STORAGE_MOVE_READ:
+	{
+		uint16_t size = data_storage_move_size - data_storage_move_offset;
+
+		if (size == 0)
+		{
+			data_storage_status = DATA_STORAGE_MOVE_COMMIT;
+			storage_service_trigger();
+			break;
+		}
+		if (size > FAT_CHUNK_BYTE_SIZE) size = FAT_CHUNK_BYTE_SIZE;
+
+		// If NV memory not ready, try again on the next trigger
+		if (udb_nv_memory_read(data_storage_first_page, data_storage_move_from + data_storage_move_offset, size, &storage_move_read_callback) == true)
+			data_storage_status = DATA_STORAGE_MOVE_READING;
+	}	break;
+
+	case DATA_STORAGE_MOVE_WRITE:
+	{
+		uint16_t size = data_storage_move_size - data_storage_move_offset;
+
+		if (size > FAT_CHUNK_BYTE_SIZE) size = FAT_CHUNK_BYTE_SIZE;
+
+		if (udb_nv_memory_write(data_storage_first_page, data_storage_move_to + data_storage_move_offset, size, &storage_move_write_callback) == true)
+			data_storage_status = DATA_STORAGE_MOVE_WRITING;
+	}	break;
+
+	case DATA_STORAGE_MOVE_COMMIT:
+	{
+		DATA_STORAGE_ENTRY old_entry = data_storage_table.table[data_storage_handle];
+
+		// The area only moves once the table says so
+		data_storage_table.table[data_storage_handle].data_address = data_storage_move_to;
+		data_storage_table.table[data_storage_handle].data_size = data_storage_move_area_size;
+
+		if (data_storage_write_table(&storage_move_commit_callback) == true)
+			data_storage_status = DATA_STORAGE_MOVE_COMMITTING;
+		else
+			data_storage_table.table[data_storage_handle] = old_entry;
+	}	break;
 	}
 }
 
 static void data_storage_write_table_callback(boolean success)
 {
+	data_storage_build_free_list();
+
 	if (data_storage_user_callback != NULL)
 		data_storage_user_callback(success);
 
@@ -397,25 +835,50 @@ static void data_storage_init_read_callback(boolean success)
 		data_storage_status = DATA_STORAGE_STATUS_START;
 		return;
 	}
-	data_storage_status = DATA_STORAGE_CHECK_TABLE;
+	data_storage_status = DATA_STORAGE_READ_TABLE_B;
+	storage_service_trigger();
 }
 
-// Check that the data storage table is valid with the correct checksum
-static boolean data_storage_check_table(void)
+// Callback when the second table slot has been read
+static void data_storage_init_read_b_callback(boolean success)
 {
-	uint16_t mem_checksum;
+	if (success == false)
+	{
+		data_storage_status = DATA_STORAGE_STATUS_START;
+		return;
+	}
+	data_storage_status = DATA_STORAGE_CHECK_TABLE;
+	storage_service_trigger();
+}
 
+// Check that a data storage table is valid with the correct checksum
+static boolean data_storage_table_valid(DATA_STORAGE_TABLE* pTable)
+{
 	// Check that the preamble is correct
-	if (memcmp(data_storage_table.table_preamble, table_storage_preamble, 4) != 0) return false;
-
-	// Calcualte the checksum
-	mem_checksum = crc_calculate((uint8_t*) data_storage_table.table, sizeof(*data_storage_table.table));
+	if (memcmp(pTable->table_preamble, table_storage_preamble, 4) != 0) return false;
 
-	if (mem_checksum != data_storage_table.table_checksum) return false;
+	if (data_storage_table_checksum(pTable) != pTable->table_checksum) return false;
 
 	return true;
 }
 
+// Choose the newest valid table of the two slots, leaving it in data_storage_table
+// return false if neither is valid
+static boolean data_storage_check_table(void)
+{
+	boolean valid_a = data_storage_table_valid(&data_storage_table);
+	boolean valid_b = data_storage_table_valid(&data_storage_table_b);
+
+	data_storage_table_slot = 0;
+
+	if (valid_b && (valid_a == false || storage_generation_newer(data_storage_table_b.table_generation, data_storage_table.table_generation)))
+	{
+		data_storage_table = data_storage_table_b;
+		data_storage_table_slot = 1;
+	}
+	return (valid_a || valid_b);
+}
+
 // Format the data storage table
 static boolean data_storage_format_table(void)
 {
@@ -423,6 +886,8 @@ static boolean data_storage_format_table(void)
 
 	//Copy the preamble
 	memcpy(data_storage_table.table_preamble, table_storage_preamble, 4);
+	data_storage_clean_flags = 0;
+	data_storage_slot_known = 0;
 
 	for(mem_counter = 0; mem_counter < MAX_DATA_HANDLES; mem_counter++)
 	{
@@ -431,13 +896,8 @@ static boolean data_storage_format_table(void)
 		data_storage_table.table[mem_counter].data_size = 0;
 	}
 
-	// Calculate the checksum
-	mem_counter = crc_calculate((uint8_t*) data_storage_table.table, sizeof(*data_storage_table.table));
-
-	data_storage_table.table_checksum = mem_counter;
-
-	// Store the table
-	if (udb_nv_memory_write((uint8_t*) &data_storage_table, 0, sizeof(data_storage_table), &data_storage_format_callback) == false)
+	// Store the table, newer than any table already in the other slot
+	if (data_storage_write_table(&data_storage_format_callback) == false)
 		return false;
 	return true;
 }
@@ -451,6 +911,7 @@ static void data_storage_format_callback(boolean success)
 		return;
 	}
 
+	data_storage_build_free_list();
 	data_storage_status = DATA_STORAGE_STATUS_WAITING;
 	return;
 }
@@ -479,6 +940,7 @@ boolean storage_write(uint16_t data_handle, uint8_t* pwrData, uint16_t size, DS_
 	data_storage_handle        = data_handle;
 	data_storage_user_callback = callback;
 	data_storage_data_size     = size;
+	data_storage_offset        = 0;
 
 	data_storage_type = data_storage_table.table[data_handle].data_type;
 
@@ -498,6 +960,7 @@ boolean storage_write(uint16_t data_handle, uint8_t* pwrData, uint16_t size, DS_
 	if (data_storage_table.table[data_handle].data_size != data_storage_size) return false;
 
 	data_storage_status = DATA_STORAGE_WRITE;
+	storage_service_trigger();
 
 	return true;
 }
@@ -508,12 +971,19 @@ static void storage_write_callback(boolean success)
 	{
 		if (data_storage_user_callback != NULL) data_storage_user_callback(false);
 		data_storage_status = DATA_STORAGE_STATUS_WAITING;
+		return;
 	}
 	data_storage_status = DATA_STORAGE_WRITING_DATA_COMPLETE;
+	storage_service_trigger();
 }
 
 static void storage_write_header_callback(boolean success)
 {
+	if (success)
+	{
+		storage_set_clean(data_storage_handle, data_storage_header.data_checksum, data_storage_write_sum);
+		storage_set_slot(data_storage_handle, data_storage_slot, data_storage_header.data_version);
+	}
 	data_storage_status = DATA_STORAGE_STATUS_WAITING;
 	if (data_storage_user_callback != NULL) data_storage_user_callback(success);
 }
@@ -530,6 +1000,7 @@ boolean storage_read(uint16_t data_handle, uint8_t* pwrData, uint16_t size, DS_c
 	data_storage_data_size     = size;
 	data_storage_handle        = data_handle;
 	data_storage_user_callback = callback;
+	data_storage_offset        = 0;
 
 	switch (data_storage_table.table[data_handle].data_type)
 	{
@@ -547,14 +1018,57 @@ boolean storage_read(uint16_t data_handle, uint8_t* pwrData, uint16_t size, DS_c
 	if (data_storage_table.table[data_handle].data_size != data_storage_size) return false;
 
 	data_storage_status = DATA_STORAGE_READ;
+	storage_service_trigger();
+
+	return true;
+}
+
+// Start a random access write or read of part of a self managed area
+static boolean storage_access_part(uint16_t data_handle, uint8_t* pData, uint16_t offset, uint16_t size, DS_callbackFunc callback, uint16_t status)
+{
+	if (data_storage_status != DATA_STORAGE_STATUS_WAITING) return false;
+
+	// If the data storage area has not been created, return false
+	if (storage_test_handle(data_handle) == false)
+		return false;
+
+	if (data_storage_table.table[data_handle].data_type != DATA_STORAGE_SELF_MANAGED) return false;
+
+	// Check the access is inside the area
+	if (offset > data_storage_table.table[data_handle].data_size) return false;
+	if (size > data_storage_table.table[data_handle].data_size - offset) return false;
+
+	pdata_storage_data         = pData;
+	data_storage_handle        = data_handle;
+	data_storage_user_callback = callback;
+	data_storage_type          = DATA_STORAGE_SELF_MANAGED;
+	data_storage_size          = size;
+	data_storage_data_size     = size;
+	data_storage_offset        = offset;
+
+	data_storage_status = status;
+	storage_service_trigger();
 
 	return true;
 }
 
+boolean storage_write_part(uint16_t data_handle, uint8_t* pwrData, uint16_t offset, uint16_t size, DS_callbackFunc callback)
+{
+	return storage_access_part(data_handle, pwrData, offset, size, callback, DATA_STORAGE_WRITE);
+}
+
+boolean storage_read_part(uint16_t data_handle, uint8_t* prdData, uint16_t offset, uint16_t size, DS_callbackFunc callback)
+{
+	return storage_access_part(data_handle, prdData, offset, size, callback, DATA_STORAGE_READ);
+}
+
 static void storage_read_data_callback(boolean success)
 {
 	if (success)
+	{
 		data_storage_status = DATA_STORAGE_READ_DATA_COMPLETE;
+		storage_service_trigger();
+	}
 	else
 	{
 		if (data_storage_user_callback != NULL) data_storage_user_callback(false);
@@ -565,7 +1079,17 @@ static void storage_read_data_callback(boolean success)
 static void storage_read_header_callback(boolean success)
 {
 	if (success)
-		data_storage_status = DATA_STORAGE_READ_HEADER_COMPLETE;
+	{
+		// Read the second slot header after the first
+		if (data_storage_slot == 0)
+		{
+			data_storage_slot = 1;
+			data_storage_status = DATA_STORAGE_READ_HEADER;
+		}
+		else
+			data_storage_status = DATA_STORAGE_READ_HEADER_COMPLETE;
+		storage_service_trigger();
+	}
 	else
 	{
 		if (data_storage_user_callback != NULL) data_storage_user_callback(false);
@@ -579,6 +1103,7 @@ static void storage_read_header_callback(boolean success)
 boolean storage_check_area_exists(uint16_t data_handle, uint16_t size, uint16_t type)
 {
 	uint16_t check_size;
+	if (data_handle >= MAX_DATA_HANDLES) return false;
 	if (data_storage_table.table[data_handle].data_address == 0) return false;
 	if (data_storage_table.table[data_handle].data_type != type) return false;
 
@@ -607,6 +1132,7 @@ boolean storage_check_area_exists(uint16_t data_handle, uint16_t size, uint16_t
 boolean storage_create_area(uint16_t data_handle, uint16_t size, uint16_t type, DS_callbackFunc callback)
 {
 	if (data_storage_status != DATA_STORAGE_STATUS_WAITING) return false;
+	if (data_handle >= MAX_DATA_HANDLES) return false;
 
 	pdata_storage_data         = NULL;
 	data_storage_type          = type;
@@ -627,89 +1153,280 @@ boolean storage_create_area(uint16_t data_handle, uint16_t size, uint16_t type,
 	}
 
 	data_storage_status = DATA_STORAGE_AREA_CREATE;
+	storage_service_trigger();
 	return true;
 }
 
-// Find the address of the next page start
-static inline uint16_t find_next_page_address(uint16_t address)
+// Rebuild the list of free space from the table
+static void data_storage_build_free_list(void)
 {
-	uint16_t temp = address / FAT_CHUNK_BYTE_SIZE;
-	temp++;
-	return temp * FAT_CHUNK_BYTE_SIZE;
+	uint16_t order[MAX_DATA_HANDLES];
+	uint16_t count = 0;
+	uint16_t handle;
+	uint16_t index;
+	uint16_t next;
+	// Areas start at the next page address above both storage table slots
+	uint16_t address = 2 * storage_page_size(sizeof(data_storage_table));
+
+	// Sort the allocated areas by address
+	for (handle = 0; handle < MAX_DATA_HANDLES; handle++)
+	{
+		if (storage_test_handle(handle) == false) continue;
+
+		for (index = count; index > 0; index--)
+		{
+			if (data_storage_table.table[order[index - 1]].data_address <= data_storage_table.table[handle].data_address) break;
+			order[index] = order[index - 1];
+		}
+		order[index] = handle;
+		count++;
+	}
+
+	// The free space is what lies between them
+	data_storage_free_count = 0;
+	for (index = 0; index <= count; index++)
+	{
+		if (index < count)
+			next = data_storage_table.table[order[index]].data_address;
+		else
+			next = DATA_STORAGE_MEMORY_SIZE;
+
+		if (next > address)
+		{
+			data_storage_free[data_storage_free_count].address = address;
+			data_storage_free[data_storage_free_count].size = next - address;
+			data_storage_free_count++;
+		}
+		if (index < count)
+		{
+			next += storage_area_span(data_storage_table.table[order[index]].data_type, data_storage_table.table[order[index]].data_size);
+			if (next > address) address = next;
+		}
+	}
 }
 
-// Find a hole of size data_storage_size and return its address.
+// Find free space of size data_storage_size and return its address.
+// The size is the span of the area, see storage_area_span.
 //  returns zero address if space is not found
-//
-// TEMPORARY:  Finds next available space after all areas.
-// TEMPORARY:  Does not check max size
-//
-static uint16_t data_storage_find_hole(uint16_t data_storage_size)
+static uint16_t data_storage_alloc(uint16_t data_storage_size)
 {
-	// Start search at the next page address above the storage table
-	uint16_t lowestAddr = find_next_page_address(sizeof(data_storage_table));
-	uint16_t highestAddr = lowestAddr + data_storage_size;
-	uint16_t scanMaxAddr = 0;
-	uint16_t scanMinAddr = 0;
-	uint16_t handle = 0;
+	uint16_t index;
+	uint16_t size = storage_page_size(data_storage_size);
 
-	boolean found_space;
-	boolean overlap;
+	// First fit keeps the areas low in memory
+	for (index = 0; index < data_storage_free_count; index++)
+	{
+		if (data_storage_free[index].size >= size)
+			return data_storage_free[index].address;
+	}
+	return 0;
+}
 
-	// go around this loop checking if any of the assigned data areas in the table overlap
-	// the proposed data area (lowestAddr-highestAddr).
-	// If an overlap is found, move the proposed area to the end of the assigned area, if the
-	// assigned area is at a higher address.
-	// Scanned addresses are the address ranges registered in the table
-	// Repeat the loop until the whole table is passed without a data overlap
+// Size of the free space starting at address
+static uint16_t data_storage_free_after(uint16_t address)
+{
+	uint16_t index;
 
-	do
+	for (index = 0; index < data_storage_free_count; index++)
 	{
-		found_space = true;
+		if (data_storage_free[index].address == address)
+			return data_storage_free[index].size;
+	}
+	return 0;
+}
 
-		for(handle = 0; handle <= MAX_DATA_HANDLES; handle++)
-		{
-			overlap = false;
+// Start a copy of the area at data_storage_handle to a new address
+static void storage_start_move(uint16_t address, uint16_t copy_size, uint16_t area_size)
+{
+	data_storage_move_from      = data_storage_table.table[data_storage_handle].data_address;
+	data_storage_move_to        = address;
+	data_storage_move_size      = copy_size;
+	data_storage_move_offset    = 0;
+	data_storage_move_area_size = area_size;
+
+	data_storage_status = DATA_STORAGE_MOVE_READ;
+	storage_service_trigger();
+}
 
-			scanMinAddr = data_storage_table.table[handle].data_address;
-			scanMaxAddr = scanMinAddr + data_storage_table.table[handle].data_size;
+// Move the highest area that fits whole into the lowest hole
+static void data_storage_compact(void)
+{
+	uint16_t handle;
+	uint16_t best = INVALID_HANDLE;
+	DATA_STORAGE_ENTRY* pEntry;
 
-			// If the lowest address is inside the scanned range, data areas overlap
-			if ((scanMinAddr <= lowestAddr) & (scanMaxAddr >= lowestAddr)) overlap = true;
+	if (data_storage_free_count > 0)
+	{
+		for (handle = 0; handle < MAX_DATA_HANDLES; handle++)
+		{
+			if (storage_test_handle(handle) == false) continue;
+			pEntry = &data_storage_table.table[handle];
+			if (pEntry->data_address < data_storage_free[0].address) continue;
+			if (storage_area_span(pEntry->data_type, pEntry->data_size) > data_storage_free[0].size) continue;
 
-			// If the highest address is inside the scanned range, data areas overlap
-			if ((scanMinAddr <= highestAddr) & (scanMaxAddr >= highestAddr)) overlap = true;
+			if (best == INVALID_HANDLE || data_storage_table.table[handle].data_address > data_storage_table.table[best].data_address)
+				best = handle;
+		}
+	}
 
-			// If the scanned range is inside the proposed range, data areas ovverlap
-			if ((scanMinAddr >= lowestAddr) & (scanMinAddr <= highestAddr)) overlap = true;
+	if (best == INVALID_HANDLE)
+	{
+		data_storage_compacting = false;
+		data_storage_status = DATA_STORAGE_STATUS_WAITING;
+		return;
+	}
 
+	data_storage_handle = best;
+	pEntry = &data_storage_table.table[best];
 
-			// If there has been an overlap of any kind, move the lowest proposed address
-			// to the start of the next page above the highest scanned address
-			if (overlap == true)
-			{
-				if (scanMaxAddr > lowestAddr)
-				{
-					lowestAddr =  find_next_page_address(scanMaxAddr);
-					highestAddr = lowestAddr + data_storage_size;
-				}
+	// Both slots of a checksummed structure are moved, the second one starting a page on
+	if (pEntry->data_type == DATA_STORAGE_CHECKSUM_STRUCT)
+		storage_start_move(data_storage_free[0].address, storage_page_size(pEntry->data_size) + pEntry->data_size, pEntry->data_size);
+	else
+		storage_start_move(data_storage_free[0].address, pEntry->data_size, pEntry->data_size);
+}
 
-				found_space = false;        // flag space not found for this round of the search
-			}
+// Finished moving an area
+static void storage_move_done(boolean success)
+{
+	if (data_storage_compacting == true)
+	{
+		if (success)
+		{
+			data_storage_status = DATA_STORAGE_COMPACT;
+			storage_service_trigger();
+			return;
 		}
-	} while(found_space == false);
-/*
-	for(handle = 0; handle <= DATA_HANDLE_MAX; handle++)
+		data_storage_compacting = false;
+		data_storage_status = DATA_STORAGE_STATUS_WAITING;
+		return;
+	}
+
+	data_storage_status = DATA_STORAGE_STATUS_WAITING;
+	if (data_storage_user_callback != NULL)
+		data_storage_user_callback(success);
+}
+
+static void storage_move_read_callback(boolean success)
+{
+	if (success == false)
+	{
+		storage_move_done(false);
+		return;
+	}
+	data_storage_status = DATA_STORAGE_MOVE_WRITE;
+	storage_service_trigger();
+}
+
+static void storage_move_write_callback(boolean success)
+{
+	if (success == false)
+	{
+		storage_move_done(false);
+		return;
+	}
+	data_storage_move_offset += FAT_CHUNK_BYTE_SIZE;
+	if (data_storage_move_offset > data_storage_move_size)
+		data_storage_move_offset = data_storage_move_size;
+	data_storage_status = DATA_STORAGE_MOVE_READ;
+	storage_service_trigger();
+}
+
+static void storage_move_commit_callback(boolean success)
+{
+	data_storage_build_free_list();
+	storage_move_done(success);
+}
+
+// Resize an area, keeping its contents up to the smaller of the two sizes
+boolean storage_resize(uint16_t data_handle, uint16_t size, DS_callbackFunc callback)
+{
+	if (data_storage_status != DATA_STORAGE_STATUS_WAITING) return false;
+
+	// If the data storage area has not been created, return false
+	if (storage_test_handle(data_handle) == false)
+		return false;
+
+	switch (data_storage_table.table[data_handle].data_type)
+	{
+	case DATA_STORAGE_CHECKSUM_STRUCT:
+		data_storage_size = size + sizeof(DATA_STORAGE_HEADER);
+		break;
+	case DATA_STORAGE_SELF_MANAGED:
+		data_storage_size = size;
+		break;
+	default:
+		return false;
+		break;
+	}
+
+	data_storage_handle        = data_handle;
+	data_storage_user_callback = callback;
+
+	data_storage_status = DATA_STORAGE_AREA_RESIZE;
+	storage_service_trigger();
+
+	return true;
+}
+
+static void storage_resize_specific_area(void)
+{
+	DATA_STORAGE_ENTRY* pEntry = &data_storage_table.table[data_storage_handle];
+	uint16_t old_size = pEntry->data_size;
+	uint16_t old_pages = storage_area_span(pEntry->data_type, old_size);
+	uint16_t new_pages = storage_area_span(pEntry->data_type, data_storage_size);
+	uint16_t copy_size = old_size;
+	uint16_t address;
+
+	storage_set_dirty(data_storage_handle);
+	storage_forget_slot(data_storage_handle);
+
+	// A checksummed structure's checksum covers its old size, so there is nothing to keep
+	if (pEntry->data_type == DATA_STORAGE_CHECKSUM_STRUCT)
+		copy_size = 0;
+
+	// Resize in place if it shrinks, or if the space after it is free
+	if (new_pages <= old_pages || data_storage_free_after(pEntry->data_address + old_pages) >= new_pages - old_pages)
 	{
-		scanAddr = data_storage_table.table[handle].data_address;
-		maxAddr = scanAddr + data_storage_table.table[handle].data_size;
-		maxAddr = find_next_page_address(maxAddr);
+		pEntry->data_size = data_storage_size;
+		if (data_storage_write_table(&data_storage_write_table_callback) == false)
+		{
+			pEntry->data_size = old_size;
+			if (data_storage_user_callback != NULL)
+				data_storage_user_callback(false);
+			data_storage_status = DATA_STORAGE_STATUS_WAITING;
+		}
+		else
+			data_storage_status = DATA_STORAGE_AREA_CREATING;
+		return;
+	}
 
-		if (maxAddr > lowestAddr)
-			lowestAddr = maxAddr;
+	// Otherwise move it to free space big enough to hold it
+	if ((address = data_storage_alloc(new_pages)) == 0)
+	{
+		if (data_storage_user_callback != NULL)
+			data_storage_user_callback(false);
+		data_storage_status = DATA_STORAGE_STATUS_WAITING;
+		return;
 	}
- */
-	return lowestAddr;
+	storage_start_move(address, copy_size, data_storage_size);
+}
+
+// Delete a data storage area and free its space
+boolean storage_delete_area(uint16_t data_handle, DS_callbackFunc callback)
+{
+	if (data_storage_status != DATA_STORAGE_STATUS_WAITING) return false;
+
+	if (storage_test_handle(data_handle) == false)
+		return false;
+
+	data_storage_user_callback = callback;
+	data_storage_handle        = data_handle;
+
+	data_storage_status = DATA_STORAGE_AREA_DELETE;
+	storage_service_trigger();
+
+	return true;
 }
 
 // Clear specific data storage area by invalidating data
@@ -719,8 +1436,10 @@ boolean storage_clear_area(uint16_t data_handle, DS_callbackFunc callback)
 
 	data_storage_user_callback = callback;
 	data_storage_handle        = data_handle;
+	data_storage_slot          = 0;
 
 	data_storage_status = DATA_STORAGE_AREA_CLEAR;
+	storage_service_trigger();
 
 	return true;
 }
@@ -737,6 +1456,8 @@ static void storage_clear_specific_area(void)
 		return;
 	}
 
+	storage_set_dirty(data_storage_handle);
+	storage_forget_slot(data_storage_handle);
 	memcpy(data_storage_header.data_preamble, table_invalid_preamble, 4);
 	data_storage_header.data_handle   = 0;
 	data_storage_header.data_version  = 0;
@@ -749,7 +1470,7 @@ static void storage_clear_specific_area(void)
 		size = data_storage_table.table[data_storage_handle].data_size;
 
 	// Invalidate the data preamble but do not change any of the data.
-	if (udb_nv_memory_write((uint8_t*) &data_storage_header, data_storage_table.table[data_storage_handle].data_address, size, &storage_clear_specific_area_callback) == false)
+	if (udb_nv_memory_write((uint8_t*) &data_storage_header, storage_slot_address(data_storage_slot), size, &storage_clear_specific_area_callback) == false)
 	{
 		if (data_storage_user_callback != NULL)
 			data_storage_user_callback(false);
@@ -763,6 +1484,16 @@ static void storage_clear_specific_area(void)
 // Clear specific storage area callback
 static void storage_clear_specific_area_callback(boolean success)
 {
+	// Both slots of a checksummed structure are invalidated
+	if (success && data_storage_slot == 0 &&
+	    data_storage_table.table[data_storage_handle].data_type == DATA_STORAGE_CHECKSUM_STRUCT)
+	{
+		data_storage_slot = 1;
+		data_storage_status = DATA_STORAGE_AREA_CLEAR;
+		storage_service_trigger();
+		return;
+	}
+
 	if (data_storage_user_callback != NULL)
 		data_storage_user_callback(success);
 
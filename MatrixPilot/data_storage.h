@@ -45,6 +45,9 @@
 // Maximum number of data areas
 #define MAX_DATA_HANDLES        30
 
+// Size of the nv memory holding the data areas (24LC256)
+#define DATA_STORAGE_MEMORY_SIZE 0x8000
+
 // callback type for data storage user
 typedef void (*DS_callbackFunc)(boolean);
 
@@ -58,7 +61,7 @@ typedef void (*DS_callbackFunc)(boolean);
 // Data storage types defines the way in which the storage area works
 //
 // NULL - Nothing there
-// CHECKSUM_STRUCT - A single structure with a checksum
+// CHECKSUM_STRUCT - A single structure with a checksum, kept in two slots
 // HEADER_NO_CHECKSUM - A header to start the area but no checksum use
 // CHECKSUMMED_ARRAY - Chuncks of data with a checksum for each chunck
 // SELF_MANAGED - No header or checksum. Only checks out of bounds writing
@@ -84,13 +87,17 @@ typedef struct tagDATA_STORAGE_ENTRY
 } DATA_STORAGE_ENTRY;
 
 // Structure of complete data directory including checksum.
+// Two copies are kept, the valid one with the newest generation is used.
 typedef struct tagDATA_STORAGE_TABLE
 {
 	uint8_t            table_preamble[DATA_PREAMBLE_SIZE];
+	uint16_t           table_generation;
 	DATA_STORAGE_ENTRY table[MAX_DATA_HANDLES];
 	uint16_t           table_checksum;
 } DATA_STORAGE_TABLE;
 
+// Header at the start of each slot of a checksummed structure.
+// data_version is the generation of the copy, the newest valid slot is used.
 typedef struct tagDATA_STORAGE_HEADER
 {
 	uint8_t  data_preamble[DATA_PREAMBLE_SIZE];
@@ -130,8 +137,13 @@ extern boolean storage_read_array(uint16_t data_handle, uint8_t* prdData, uint16
 extern boolean storage_write_part(uint16_t data_handle, uint8_t* pwrData, uint16_t offset, uint16_t size, DS_callbackFunc callback);
 extern boolean storage_read_part(uint16_t data_handle, uint8_t* prdData, uint16_t offset, uint16_t size, DS_callbackFunc callback);
 
+// Resize an area, in place if there is room after it, otherwise moving it.
+// Data is kept up to the smaller of the two sizes.
 extern boolean storage_resize(uint16_t data_handle, uint16_t size, DS_callbackFunc callback);
 
+// Delete a data storage area and free its space
+extern boolean storage_delete_area(uint16_t data_handle, DS_callbackFunc callback);
+
 // Clear all data storage areas by invalidating data
 extern boolean storage_clear_all(DS_callbackFunc callback);
 
@@ -34,6 +34,17 @@
 #include "../libDCM/gpsParseCommon.h"
 #include <stdlib.h>
 
+#if (LOGO_UPLOAD_INSTRUCTIONS > 0)
+// Include MAVlink library for checksums
+#include "../MAVLink/include/mavlink_types.h"
+#include "../MAVLink/include/checksum.h"
+#endif
+#if (USE_LOGO_STORE)
+#include "data_storage.h"
+#include "parameter_datatypes.h"
+#include "../libUDB/events.h"
+#endif
+
 //#if (FLIGHT_PLAN_TYPE == FP_LOGO)
 
 
@@ -254,11 +265,52 @@ static union longww absoluteXLong;
 static struct logoInstructionDef *currentInstructionSet = (struct logoInstructionDef*)instructions;
 static int16_t numInstructionsInCurrentSet = NUM_INSTRUCTIONS;
 
-// If we've processed this many instructions without commanding the plane to fly,
-// then stop and continue on the next run through
-#define MAX_INSTRUCTIONS_PER_CYCLE  32
+#if (LOGO_UPLOAD_INSTRUCTIONS > 0)
+// An uploaded program is received into one buffer while the other one is
+// flown. The RTL instructions, if any, follow the main instructions.
+struct logoProgram {
+	uint16_t magic;
+	uint16_t numInstructions;
+	uint16_t numRTLInstructions;
+	uint16_t checksum;
+	struct logoInstructionDef instructions[LOGO_UPLOAD_INSTRUCTIONS];
+};
+static struct logoProgram logoPrograms[2];
+static struct logoProgram* logoActiveProgram = NULL;    // NULL flies the compiled in instructions
+static struct logoProgram* logoPendingProgram = NULL;   // checked, waiting for a safe point to start
+static uint16_t logoUploadRecords = 0;
+static int16_t logoCurrentPlan = 0;
+
+#define LOGO_MAX_SET_SIZE           ((NUM_INSTRUCTIONS > LOGO_UPLOAD_INSTRUCTIONS) ? NUM_INSTRUCTIONS : LOGO_UPLOAD_INSTRUCTIONS)
+#else
+#define LOGO_MAX_SET_SIZE           NUM_INSTRUCTIONS
+#endif
+
+// Jump targets resolved when an instruction set is started, so that running
+// DO, EXEC, IF, ELSE and interrupt instructions does not scan the program.
+// Each entry holds the target for the instruction at the same index.
+#define LOGO_JUMP_TABLE_SIZE ((LOGO_MAX_SET_SIZE > NUM_RTL_INSTRUCTIONS) ? LOGO_MAX_SET_SIZE : NUM_RTL_INSTRUCTIONS)
+static int16_t logoJumpTable[LOGO_JUMP_TABLE_SIZE];
+static const struct logoInstructionDef* logoCompiledSet = NULL;
+
+// Subroutine entry points, for injected instructions and PARAM interrupts
+#define LOGO_MAX_SUBROUTINES        32
+struct logoSubroutineDef {
+	int16_t id;
+	int16_t index;
+};
+static struct logoSubroutineDef logoSubroutines[LOGO_MAX_SUBROUTINES];
+static int16_t numLogoSubroutines = 0;      // -1 if there were too many to list
+
+// Open REPEAT and IF blocks tracked while resolving jumps
+#define LOGO_COMPILE_DEPTH          16
+
 static int16_t instructionsProcessed = 0;
 
+#if (LOGO_PROFILE == 1)
+struct logoProfile logo_profile;
+#endif
+
 // Storage for command injection
 static struct logoInstructionDef logo_inject_instr;
 static uint8_t logo_inject_pos = 0;
@@ -268,9 +320,6 @@ static uint8_t logo_inject_pos = 0;
 static int16_t interruptIndex = 0;     // instruction index of the beginning of the interrupt function
 static int8_t interruptStackBase = 0;  // stack depth when entering interrupt (clear interrupt when dropping below this depth)
 
-// How many layers deep can Ifs, Repeats and Subroutines be nested
-#define LOGO_STACK_DEPTH            12
-
 struct logoStackFrame {
 	uint16_t frameType              :  2;
 	int16_t returnInstructionIndex  : 14;   // instructionIndex before the first instruction of the subroutine (a TO or REPEAT line, or -1 for MAIN)
@@ -299,9 +348,14 @@ static int16_t turtleAngles[2] = {0, 0};
 static uint8_t currentTurtle;
 static int16_t penState;
 
-static boolean process_one_instruction(struct logoInstructionDef instr);
+static boolean process_one_instruction(struct logoInstructionDef instr, int16_t jump);
+static int16_t logo_jump_target(int16_t index, struct logoInstructionDef instr);
+static void logo_compile(void);
 static void update_goal_from(struct relative3D old_waypoint);
 static void process_instructions(void);
+#if (LOGO_UPLOAD_INSTRUCTIONS > 0)
+static void logo_upload_activate(void);
+#endif
 
 int16_t flightplan_logo_index_get(void)
 {
@@ -325,15 +379,44 @@ void flightplan_logo_begin(int16_t flightplanNum)
 	int8_t earth_yaw;
 	int16_t angle;
 
+#if (LOGO_UPLOAD_INSTRUCTIONS > 0)
+	if (flightplanNum == 0 || flightplanNum == 1)
+	{
+		logoCurrentPlan = flightplanNum;
+	}
+	if (logoPendingProgram != NULL)
+	{
+		logo_upload_activate();
+		flightplanNum = logoCurrentPlan;
+	}
+#endif
 	if (flightplanNum == 1) // RTL instructions set
 	{
 		currentInstructionSet = (struct logoInstructionDef*)rtlInstructions;
 		numInstructionsInCurrentSet = NUM_RTL_INSTRUCTIONS;
+#if (LOGO_UPLOAD_INSTRUCTIONS > 0)
+		if (logoActiveProgram != NULL && logoActiveProgram->numRTLInstructions > 0)
+		{
+			currentInstructionSet = &logoActiveProgram->instructions[logoActiveProgram->numInstructions];
+			numInstructionsInCurrentSet = logoActiveProgram->numRTLInstructions;
+		}
+#endif
 	}
 	else if (flightplanNum == 0) // Main instructions set
 	{
 		currentInstructionSet = (struct logoInstructionDef*)instructions;
 		numInstructionsInCurrentSet = NUM_INSTRUCTIONS;
+#if (LOGO_UPLOAD_INSTRUCTIONS > 0)
+		if (logoActiveProgram != NULL && logoActiveProgram->numInstructions > 0)
+		{
+			currentInstructionSet = logoActiveProgram->instructions;
+			numInstructionsInCurrentSet = logoActiveProgram->numInstructions;
+		}
+#endif
+	}
+	if (logoCompiledSet != currentInstructionSet)
+	{
+		logo_compile();
 	}
 
 	instructionIndex = 0;
@@ -422,10 +505,20 @@ static void update_goal_from(struct relative3D old_goal)
 
 void flightplan_logo_update(void)
 {
+#if (LOGO_UPLOAD_INSTRUCTIONS > 0)
+	// start a newly uploaded program, unless an injected instruction or an
+	// interrupt routine is part way through
+	if (logoPendingProgram != NULL && logo_inject_pos != LOGO_INJECT_READY && !interruptStackBase)
+	{
+		flightplan_logo_begin(logoCurrentPlan);
+		return;
+	}
+#endif
+
 	// first run any injected instruction from the serial port
 	if (logo_inject_pos == LOGO_INJECT_READY)
 	{
-		process_one_instruction(logo_inject_instr);
+		process_one_instruction(logo_inject_instr, logo_jump_target(instructionIndex, logo_inject_instr));
 		if (logo_inject_instr.cmd == 2 || logo_inject_instr.cmd == 10) // DO / EXEC
 		{
 			instructionIndex++;
@@ -504,6 +597,17 @@ static int16_t find_start_of_subroutine(uint8_t subcmd)
 
 	if (subcmd == 0) return -1; // subcmd 0 is reserved to always mean the start of the logo program
 
+	if (numLogoSubroutines >= 0)
+	{
+		for (i = 0; i < numLogoSubroutines; i++)
+		{
+			if (logoSubroutines[i].id == subcmd)
+			{
+				return logoSubroutines[i].index;
+			}
+		}
+		return -1;
+	}
 	for (i = 0; i < numInstructionsInCurrentSet; i++)
 	{
 		if (currentInstructionSet[i].cmd == 1 && currentInstructionSet[i].subcmd == 2 && currentInstructionSet[i].arg == subcmd)
@@ -516,12 +620,12 @@ static int16_t find_start_of_subroutine(uint8_t subcmd)
 
 // When an IF condition was false, use this to skip to ELSE or END
 // When an IF condition was true, and we ran the block, and reach an ELSE, skips to the END
-static uint16_t find_end_of_current_if_block(void)
+static uint16_t find_end_of_if_block(int16_t index)
 {
 	int16_t i;
 	int16_t nestedDepth = 0;
 
-	for (i = instructionIndex+1; i < numInstructionsInCurrentSet; i++)
+	for (i = index+1; i < numInstructionsInCurrentSet; i++)
 	{
 		if (currentInstructionSet[i].cmd == 1 && currentInstructionSet[i].subcmd == 0) nestedDepth++; // into a REPEAT
 		else if (currentInstructionSet[i].cmd >= 14 && currentInstructionSet[i].cmd <= 19) nestedDepth++; // into an IF
@@ -535,6 +639,103 @@ static uint16_t find_end_of_current_if_block(void)
 	return 0;
 }
 
+// Resolve the jump of a single instruction by scanning the program
+static int16_t logo_jump_target(int16_t index, struct logoInstructionDef instr)
+{
+	switch (instr.cmd)
+	{
+		case 1: // Else
+			if (instr.subcmd == 3) return find_end_of_if_block(index);
+			break;
+		case 2: // Do
+		case 10: // Exec
+			return find_start_of_subroutine(instr.subcmd);
+		case 12: // Set interrupt
+			if (instr.subcmd == 1) return find_start_of_subroutine(instr.arg);
+			break;
+		case 14: // IF commands
+		case 15:
+		case 16:
+		case 17:
+		case 18:
+		case 19:
+			return find_end_of_if_block(index);
+	}
+	return 0;
+}
+
+// Fill in the jump table for the current instruction set. The first pass
+// lists the subroutines, the second matches each IF and ELSE with the ELSE
+// or END it skips to, keeping the open blocks on a stack.
+static void logo_compile(void)
+{
+	int16_t openBlocks[LOGO_COMPILE_DEPTH];     // IF or ELSE index, or -1 for a REPEAT
+	int16_t depth = 0;
+	int16_t i;
+
+	numLogoSubroutines = 0;
+	for (i = 0; i < numInstructionsInCurrentSet; i++)
+	{
+		if (currentInstructionSet[i].cmd == 1 && currentInstructionSet[i].subcmd == 2)
+		{
+			if (numLogoSubroutines < 0 || numLogoSubroutines >= LOGO_MAX_SUBROUTINES)
+			{
+				numLogoSubroutines = -1;    // too many, look them up by scanning
+				break;
+			}
+			logoSubroutines[numLogoSubroutines].id = currentInstructionSet[i].arg;
+			logoSubroutines[numLogoSubroutines].index = i;
+			numLogoSubroutines++;
+		}
+	}
+
+	for (i = 0; i < numInstructionsInCurrentSet; i++)
+	{
+		struct logoInstructionDef instr = currentInstructionSet[i];
+
+		logoJumpTable[i] = 0;
+		if (instr.cmd == 1 && instr.subcmd == 0) // REPEAT
+		{
+			if (depth < LOGO_COMPILE_DEPTH) openBlocks[depth] = -1;
+			depth++;
+		}
+		else if (instr.cmd >= 14 && instr.cmd <= 19) // IF
+		{
+			if (depth < LOGO_COMPILE_DEPTH) openBlocks[depth] = i;
+			else logoJumpTable[i] = find_end_of_if_block(i);
+			depth++;
+		}
+		else if (instr.cmd == 1 && instr.subcmd == 3) // ELSE
+		{
+			if (depth > 0 && depth <= LOGO_COMPILE_DEPTH && openBlocks[depth-1] >= 0)
+			{
+				logoJumpTable[openBlocks[depth-1]] = i;
+				openBlocks[depth-1] = i;
+			}
+			else
+			{
+				logoJumpTable[i] = find_end_of_if_block(i);
+			}
+		}
+		else if (instr.cmd == 1 && instr.subcmd == 1) // END
+		{
+			if (depth > 0)
+			{
+				depth--;
+				if (depth < LOGO_COMPILE_DEPTH && openBlocks[depth] >= 0)
+				{
+					logoJumpTable[openBlocks[depth]] = i;
+				}
+			}
+		}
+		else
+		{
+			logoJumpTable[i] = logo_jump_target(i, instr);
+		}
+	}
+	logoCompiledSet = currentInstructionSet;
+}
+
 // Referencing PARAM in a LOGO program uses the PARAM from the current subroutine frame, even if
 // we're also nested deeper inside of IF or REPEAT frames.  This finds the current subroutine's frame.
 static int16_t get_current_stack_parameter_frame_index(void)
@@ -671,7 +872,8 @@ static int16_t logo_value_for_identifier(uint8_t ident)
 	return 0;
 }
 
-static boolean process_one_instruction(struct logoInstructionDef instr)
+// jump is the resolved target of a DO, EXEC, IF, ELSE or interrupt instruction
+static boolean process_one_instruction(struct logoInstructionDef instr, int16_t jump)
 {
 	if (instr.use_param)
 	{
@@ -742,7 +944,7 @@ static boolean process_one_instruction(struct logoInstructionDef instr)
 				case 3: // Else
 					if (logoStack[logoStackIndex].frameType == LOGO_FRAME_TYPE_IF)
 					{
-						instructionIndex = find_end_of_current_if_block();
+						instructionIndex = jump;
 						logoStackIndex--;
 					}
 					break;
@@ -760,7 +962,7 @@ static boolean process_one_instruction(struct logoInstructionDef instr)
 			break;
 
 		case 10: // Exec (reset the stack and then call a subroutine)
-			instructionIndex = find_start_of_subroutine(instr.subcmd);
+			instructionIndex = jump;
 			logoStack[0].returnInstructionIndex = instructionIndex;
 			logoStackIndex = 0;
 			interruptStackBase = 0;
@@ -774,7 +976,7 @@ static boolean process_one_instruction(struct logoInstructionDef instr)
 				logoStack[logoStackIndex].arg = instr.arg;
 				logoStack[logoStackIndex].returnInstructionIndex = instructionIndex;
 			}
-			instructionIndex = find_start_of_subroutine(instr.subcmd);
+			instructionIndex = jump;
 			break;
 
 		case 3: // Forward/Back
@@ -972,7 +1174,8 @@ static boolean process_one_instruction(struct logoInstructionDef instr)
 		case 12: // Interrupts
 			switch (instr.subcmd) {
 				case 1: // Set
-					interruptIndex = find_start_of_subroutine(instr.arg);
+					// the subroutine can only be resolved here when it comes from PARAM
+					interruptIndex = instr.use_param ? find_start_of_subroutine(instr.arg) : jump;
 					break;
 				case 0: // Clear
 					interruptIndex = 0;
@@ -1015,7 +1218,7 @@ static boolean process_one_instruction(struct logoInstructionDef instr)
 			else
 			{
 				// jump to the matching END or ELSE
-				instructionIndex = find_end_of_current_if_block();
+				instructionIndex = jump;
 				if (currentInstructionSet[instructionIndex].subcmd == 3) // is entering an ELSE block
 				{
 					if (logoStackIndex < LOGO_STACK_DEPTH-1)
@@ -1037,18 +1240,39 @@ static void process_instructions(void)
 
 	while (1)
 	{
-		boolean do_fly = process_one_instruction(currentInstructionSet[instructionIndex]);
+		boolean do_fly = process_one_instruction(currentInstructionSet[instructionIndex], logoJumpTable[instructionIndex]);
 
 		instructionsProcessed++;
 		instructionIndex++;
-		if (instructionIndex >= numInstructionsInCurrentSet) instructionIndex = 0;
+		if (instructionIndex >= numInstructionsInCurrentSet)
+		{
+			instructionIndex = 0;
+#if (LOGO_PROFILE == 1)
+			logo_profile.restarts++;
+#endif
+		}
+#if (LOGO_PROFILE == 1)
+		logo_profile.instructions++;
+		if (logoStackIndex > logo_profile.maxStackDepth) logo_profile.maxStackDepth = logoStackIndex;
+#endif
 
 		if (do_fly && penState == 0 && currentTurtle == PLANE)
 			break;
 
 		if (instructionsProcessed >= MAX_INSTRUCTIONS_PER_CYCLE)
+		{
+#if (LOGO_PROFILE == 1)
+			logo_profile.cycles++;
+			logo_profile.cyclesAtLimit++;
+			logo_profile.perCycle[MAX_INSTRUCTIONS_PER_CYCLE]++;
+#endif
 			return;  // don't update goal if we didn't hit a FLY command
+		}
 	}
+#if (LOGO_PROFILE == 1)
+	logo_profile.cycles++;
+	logo_profile.perCycle[instructionsProcessed]++;
+#endif
 
 	waypointIndex = instructionIndex - 1;
 
@@ -1120,4 +1344,285 @@ void flightplan_logo_live_commit(void)
 	}
 }
 
+#if (LOGO_UPLOAD_INSTRUCTIONS > 0)
+
+// The buffer that is not being flown receives uploads
+static struct logoProgram* logo_upload_buffer(void)
+{
+	return (logoActiveProgram == &logoPrograms[0]) ? &logoPrograms[1] : &logoPrograms[0];
+}
+
+// Check that a program only holds instructions this interpreter knows, that
+// its blocks are nested properly and that the subroutines it calls exist.
+// Each TO must be closed by its own END, so a block left open inside a
+// subroutine shows up as a TO that is still open.
+static int16_t logo_validate(const struct logoInstructionDef* set, int16_t count)
+{
+	uint8_t blocks[LOGO_STACK_DEPTH];   // open REPEAT and IF blocks, 0 for an IF past its ELSE
+	int16_t depth = 0;
+	boolean in_subroutine = false;
+	int16_t fn;
+	int16_t i, j;
+
+	for (i = 0; i < count; i++)
+	{
+		fn = 0;
+		switch (set[i].cmd)
+		{
+			case 1:
+				switch (set[i].subcmd)
+				{
+					case 0: // Repeat
+						if (depth >= LOGO_STACK_DEPTH) return LOGO_UPLOAD_BAD_NESTING;
+						blocks[depth++] = LOGO_FRAME_TYPE_REPEAT;
+						break;
+					case 1: // End, of a block or of a subroutine
+						if (depth > 0) depth--;
+						else in_subroutine = false;
+						break;
+					case 2: // To
+						if (depth != 0 || in_subroutine) return LOGO_UPLOAD_BAD_NESTING;
+						in_subroutine = true;
+						break;
+					case 3: // Else
+						if (depth == 0 || blocks[depth-1] != LOGO_FRAME_TYPE_IF) return LOGO_UPLOAD_BAD_NESTING;
+						blocks[depth-1] = 0;
+						break;
+					default:
+						return LOGO_UPLOAD_BAD_INSTRUCTION;
+				}
+				break;
+			case 2: // Do
+			case 10: // Exec
+				fn = set[i].subcmd;
+				break;
+			case 12: // Set interrupt
+				if (set[i].subcmd == 1) fn = (uint8_t)set[i].arg;
+				break;
+			case 14: // IF commands
+			case 15:
+			case 16:
+			case 17:
+			case 18:
+			case 19:
+				if (depth >= LOGO_STACK_DEPTH) return LOGO_UPLOAD_BAD_NESTING;
+				blocks[depth++] = LOGO_FRAME_TYPE_IF;
+				break;
+			default:
+				if (set[i].cmd == 0 || set[i].cmd > 19) return LOGO_UPLOAD_BAD_INSTRUCTION;
+				break;
+		}
+		if (fn != 0)
+		{
+			for (j = 0; j < count; j++)
+			{
+				if (set[j].cmd == 1 && set[j].subcmd == 2 && set[j].arg == fn) break;
+			}
+			if (j == count) return LOGO_UPLOAD_NO_SUBROUTINE;
+		}
+	}
+	return (depth == 0 && !in_subroutine) ? LOGO_UPLOAD_OK : LOGO_UPLOAD_BAD_NESTING;
+}
+
+static int16_t logo_check_program(const struct logoProgram* program)
+{
+	int16_t result;
+
+	if (program->numInstructions + program->numRTLInstructions == 0 ||
+	    program->numInstructions + program->numRTLInstructions > LOGO_UPLOAD_INSTRUCTIONS)
+	{
+		return LOGO_UPLOAD_BAD_SIZE;
+	}
+	result = logo_validate(program->instructions, program->numInstructions);
+	if (result != LOGO_UPLOAD_OK) return result;
+	return logo_validate(&program->instructions[program->numInstructions], program->numRTLInstructions);
+}
+
+// Fly the pending program from now on. The jump table is rebuilt when the
+// program is started.
+static void logo_upload_activate(void)
+{
+	logoActiveProgram = logoPendingProgram;
+	logoPendingProgram = NULL;
+	logoCompiledSet = NULL;
+}
+
+#if (USE_LOGO_STORE)
+enum
+{
+	LOGO_STORE_NOT_STARTED,
+	LOGO_STORE_BUSY,
+	LOGO_STORE_IDLE,
+};
+
+static uint8_t logoStoreState = LOGO_STORE_NOT_STARTED;
+static struct logoProgram* logoStoreProgram = NULL;     // committed, waiting to be written
+static uint16_t logo_store_event_handle = INVALID_HANDLE;
+#endif
+
+int16_t flightplan_logo_upload_begin(uint16_t numRecords)
+{
+#if (USE_LOGO_STORE)
+	// the receive buffer may be being read or written
+	if (logoStoreState == LOGO_STORE_BUSY || logoStoreProgram != NULL) return LOGO_UPLOAD_BUSY;
+#endif
+	if (numRecords == 0 || numRecords > LOGO_UPLOAD_INSTRUCTIONS) return LOGO_UPLOAD_BAD_SIZE;
+
+	// a newer upload replaces one that has not started yet
+	logoPendingProgram = NULL;
+	logoUploadRecords = numRecords;
+	return LOGO_UPLOAD_OK;
+}
+
+void flightplan_logo_upload_data(uint16_t offset, const uint8_t* data, uint16_t length)
+{
+	struct logoInstructionDef* instr;
+	uint16_t index = offset / LOGO_RECORD_SIZE;
+	uint8_t field = offset % LOGO_RECORD_SIZE;
+
+	while (length > 0 && index < logoUploadRecords)
+	{
+		instr = &logo_upload_buffer()->instructions[index];
+		switch (field)
+		{
+			case 0:
+				instr->cmd = (*data < 64) ? *data : 0; // out of range, rejected by logo_validate()
+				break;
+			case 1:
+				instr->subcmd = *data;
+				break;
+			case 2:
+				instr->do_fly = (*data >> 4) & 1;
+				instr->use_param = *data & 1;
+				break;
+			case 3:
+				instr->arg = (int16_t)(((uint16_t)instr->arg & 0x00FF) | ((uint16_t)*data << 8));
+				break;
+			case 4:
+				instr->arg = (int16_t)(((uint16_t)instr->arg & 0xFF00) | *data);
+				break;
+		}
+		data++;
+		length--;
+		if (++field == LOGO_RECORD_SIZE)
+		{
+			field = 0;
+			index++;
+		}
+	}
+}
+
+int16_t flightplan_logo_upload_commit(uint16_t numInstructions, uint16_t numRTLInstructions, uint16_t checksum)
+{
+	struct logoProgram* program = logo_upload_buffer();
+	uint16_t crc = X25_INIT_CRC;
+	int16_t result;
+	uint16_t i;
+
+	if (logoUploadRecords == 0 || numInstructions + numRTLInstructions != logoUploadRecords)
+	{
+		return LOGO_UPLOAD_BAD_SIZE;
+	}
+	for (i = 0; i < logoUploadRecords; i++)
+	{
+		crc_accumulate(program->instructions[i].cmd, &crc);
+		crc_accumulate(program->instructions[i].subcmd, &crc);
+		crc_accumulate((program->instructions[i].do_fly << 4) | program->instructions[i].use_param, &crc);
+		crc_accumulate((uint16_t)program->instructions[i].arg >> 8, &crc);
+		crc_accumulate(program->instructions[i].arg & 0xFF, &crc);
+	}
+	logoUploadRecords = 0;
+	if (crc != checksum) return LOGO_UPLOAD_BAD_CHECKSUM;
+
+	program->magic = LOGO_PROGRAM_MAGIC;
+	program->numInstructions = numInstructions;
+	program->numRTLInstructions = numRTLInstructions;
+	program->checksum = checksum;
+	result = logo_check_program(program);
+	if (result != LOGO_UPLOAD_OK) return result;
+
+	logoPendingProgram = program;
+#if (USE_LOGO_STORE)
+	logoStoreProgram = program;
+#endif
+	return LOGO_UPLOAD_OK;
+}
+
+#if (USE_LOGO_STORE)
+static void logo_store_read_callback(boolean success)
+{
+	struct logoProgram* program = logo_upload_buffer();
+
+	if (success && program->magic == LOGO_PROGRAM_MAGIC && logo_check_program(program) == LOGO_UPLOAD_OK)
+	{
+		logoPendingProgram = program;
+	}
+	logoStoreState = LOGO_STORE_IDLE;
+}
+
+static void logo_store_create_callback(boolean success)
+{
+	logoStoreState = LOGO_STORE_IDLE;
+}
+
+static void logo_store_callback(boolean success)
+{
+	// a failed write is not retried, the program is still flown from RAM
+	logoStoreProgram = NULL;
+	logoStoreState = LOGO_STORE_IDLE;
+}
+
+// Low priority service routine, loads the saved program at startup and
+// saves each new one
+static void logo_store_service(void)
+{
+	switch (logoStoreState)
+	{
+	case LOGO_STORE_NOT_STARTED:
+		if (!storage_services_started()) return;
+		if (storage_check_area_exists(STORAGE_HANDLE_LOGO_PROGRAM, sizeof(struct logoProgram), DATA_STORAGE_CHECKSUM_STRUCT))
+		{
+			if (logoUploadRecords != 0 || logoPendingProgram != NULL || logoActiveProgram != NULL)
+			{
+				logoStoreState = LOGO_STORE_IDLE;   // already replaced by an upload
+			}
+			else if (storage_read(STORAGE_HANDLE_LOGO_PROGRAM, (uint8_t*)logo_upload_buffer(), sizeof(struct logoProgram), &logo_store_read_callback))
+			{
+				logoStoreState = LOGO_STORE_BUSY;
+			}
+		}
+		else
+		{
+			if (storage_create_area(STORAGE_HANDLE_LOGO_PROGRAM, sizeof(struct logoProgram), DATA_STORAGE_CHECKSUM_STRUCT, &logo_store_create_callback))
+			{
+				logoStoreState = LOGO_STORE_BUSY;
+			}
+		}
+		break;
+
+	case LOGO_STORE_IDLE:
+		if (logoStoreProgram != NULL)
+		{
+			if (storage_write(STORAGE_HANDLE_LOGO_PROGRAM, (uint8_t*)logoStoreProgram, sizeof(struct logoProgram), &logo_store_callback))
+			{
+				logoStoreState = LOGO_STORE_BUSY;
+			}
+		}
+		break;
+	}
+}
+
+void flightplan_logo_store_init(void)
+{
+	logo_store_event_handle = register_event(&logo_store_service);
+}
+
+void flightplan_logo_store_trigger(void)
+{
+	trigger_event(logo_store_event_handle);
+}
+#endif // USE_LOGO_STORE
+
+#endif // LOGO_UPLOAD_INSTRUCTIONS
+
 //#endif // (FLIGHT_PLAN_TYPE == FP_LOGO)
@@ -26,6 +26,7 @@
 #include "flightplan.h"
 #include "cameraCntrl.h"
 #include "flightplan_waypoints.h"
+#include "mission_store.h"
 #include "../libDCM/deadReckoning.h"
 #include "../libDCM/gpsData.h"
 #include "options_mavlink.h"
@@ -39,7 +40,6 @@ struct relWaypointDef { struct relative3D_32 loc; int16_t flags; struct relative
 #else
 struct relWaypointDef { struct relative3D loc; int16_t flags; struct relative3D viewpoint; };
 #endif // USE_EXTENDED_NAV
-struct waypointDef { struct waypoint3D loc; int16_t flags; struct waypoint3D viewpoint; };
 
 #include "flightplan-waypoints.h"
 
@@ -58,6 +58,25 @@ static const struct waypointDef* currentWaypointSet = (struct waypointDef*)waypo
 static int16_t numPointsInCurrentSet = NUMBER_POINTS;
 #endif
 
+// Each leg runs from the previous waypoint to the waypoint at its index.
+// Legs are compiled into relative coordinates once, so that leg changes
+// are table lookups. The cache is direct mapped on the waypoint index.
+struct relLegDef { int16_t index; int8_t extended; struct waypointparameters goal; struct relWaypointDef to; };
+
+#define LEG_INVALID -1
+
+static struct relLegDef legCache[WAYPOINT_LEG_CACHE_SIZE];
+
+// Set when the current leg could not be started because its points were
+// paged out, the leg is then started again on the next update.
+enum { LEG_READY, LEG_PENDING_BEGIN, LEG_PENDING_SET };
+static int8_t leg_pending = LEG_READY;
+
+#if (USE_MISSION_STORE)
+static boolean mission_stored = false;  // current set is the stored mission
+static boolean mission_resumed = false; // stored mission resume index used since power up
+#endif
+
 static struct relWaypointDef current_waypoint;
 static struct waypointDef wp_inject;
 static uint8_t wp_inject_pos = 0;
@@ -69,6 +88,20 @@ int16_t waypoint_count(void)
 	return numPointsInCurrentSet;
 }
 
+// Fetch the point at index from the current set.
+// Returns false if the point is paged out, it is then fetched in the background.
+static boolean waypoint_fetch(int16_t index, struct waypointDef* wp)
+{
+#if (USE_MISSION_STORE)
+	if (mission_stored)
+	{
+		return mission_store_get(index, wp);
+	}
+#endif
+	*wp = currentWaypointSet[index];
+	return true;
+}
+
 // For a relative waypoint, wp_to_relative() just passes the relative
 // waypoint location through unchanged.
 // For an absolute waypoint, wp_to_relative() converts the waypoint's
@@ -100,6 +133,89 @@ static struct relWaypointDef wp_to_relative(struct waypointDef wp)
 	return rel;
 }
 
+static void leg_cache_clear(void)
+{
+	int16_t i;
+
+	for (i = 0; i < WAYPOINT_LEG_CACHE_SIZE; i++)
+	{
+		legCache[i].index = LEG_INVALID;
+	}
+}
+
+// Returns NULL if the points of the leg are paged out
+static struct relLegDef* leg_lookup(int16_t index)
+{
+	struct relLegDef* leg = &legCache[index % WAYPOINT_LEG_CACHE_SIZE];
+
+	if (leg->index != index)
+	{
+		int16_t from_index = (index == 0) ? numPointsInCurrentSet - 1 : index - 1;
+		struct relLegDef* from_leg = &legCache[from_index % WAYPOINT_LEG_CACHE_SIZE];
+		struct relWaypointDef from;
+		struct waypointDef wp;
+
+		// reuse the previous leg's end point if it is already compiled
+		if (from_leg->index == from_index)
+		{
+			from = from_leg->to;
+		}
+		else
+		{
+			if (!waypoint_fetch(from_index, &wp)) return NULL;
+			from = wp_to_relative(wp);
+		}
+		if (!waypoint_fetch(index, &wp)) return NULL;
+		leg->to = wp_to_relative(wp);
+		leg->extended = navigate_compute_goal(from.loc, leg->to.loc, &leg->goal);
+		leg->index = index;
+	}
+	return leg;
+}
+
+// Compile at most one leg ahead of the current waypoint per call, so that
+// a newly loaded plan is compiled without a spike in the heartbeat.
+static void leg_cache_prefetch(void)
+{
+	int16_t ahead;
+	int16_t index;
+
+	if (numPointsInCurrentSet < 2) return;
+
+	for (ahead = 1; ahead < WAYPOINT_LEG_CACHE_SIZE && ahead < numPointsInCurrentSet; ahead++)
+	{
+		index = (waypointIndex + ahead) % numPointsInCurrentSet;
+		if (legCache[index % WAYPOINT_LEG_CACHE_SIZE].index != index)
+		{
+			leg_lookup(index);
+			return;
+		}
+	}
+}
+
+// The relative location of the waypoint at index, from the cache when possible.
+// Returns false if the point is paged out.
+static boolean waypoint_relative(int16_t index, struct relWaypointDef* rel)
+{
+	struct waypointDef wp;
+
+	if (numPointsInCurrentSet > 1)
+	{
+		struct relLegDef* leg = leg_lookup(index);
+		if (leg == NULL) return false;
+		*rel = leg->to;
+		return true;
+	}
+	if (!waypoint_fetch(index, &wp)) return false;
+	*rel = wp_to_relative(wp);
+	return true;
+}
+
+void flightplan_waypoints_origin_changed(void)
+{
+	leg_cache_clear();
+}
+
 //struct relWaypointDef wp_to_absolute(struct waypointDef wp)
 
 //struct waypoint3D wp_to_absolute(struct waypointDef wp)
@@ -123,18 +239,53 @@ static vect3_32t wp_to_absolute_coords(struct waypointDef wp)
 	return v;
 }
 
+#if (USE_MISSION_STORE)
+static void select_stored_mission(void)
+{
+	mission_stored = true;
+	numPointsInCurrentSet = mission_store_count();
+	leg_cache_clear();
+}
+#endif
+
 void clear_flightplan(void)
 {
+#if (USE_MISSION_STORE)
+	mission_store_clear();
+	select_stored_mission();
+#else
 	numPointsInCurrentSet = 0;
+	leg_cache_clear();
+#endif
+}
+
+// Called once all the points of an uploaded mission have been added
+void commit_flightplan(void)
+{
+#if (USE_MISSION_STORE)
+	mission_store_commit();
+	select_stored_mission();
+	mission_resumed = true;     // a new mission starts from its first point
+#endif
 }
 
 // X is Longitude in degrees * 10^7
 // Y is Latitude in degrees * 10^7
 // Z is altitude above sea level, in meters, as a floating point value.
 
-void add_waypoint(struct waypoint3D wp, int16_t flags)
+// Returns false if the point could not be taken yet and should be added again
+boolean add_waypoint(struct waypoint3D wp, int16_t flags)
 {
-#ifdef USE_DYNAMIC_WAYPOINTS
+#if (USE_MISSION_STORE)
+	struct waypointDef def;
+
+	def.loc = wp;
+	def.flags = flags;
+	def.viewpoint.x = 0;
+	def.viewpoint.y = 0;
+	def.viewpoint.z = 0;
+	return mission_store_append(&def);
+#elif defined(USE_DYNAMIC_WAYPOINTS)
 	DPRINT("add_waypoint(%li, %li, %i\r\n", wp.x, wp.y, wp.z);
 	if (numPointsInCurrentSet < MAX_WAYPOINTS)
 	{
@@ -143,6 +294,7 @@ void add_waypoint(struct waypoint3D wp, int16_t flags)
 		currentWaypointSet[numPointsInCurrentSet].loc.z = wp.z;
 		currentWaypointSet[numPointsInCurrentSet].flags = flags;
 		numPointsInCurrentSet++;
+		leg_cache_clear();
 	}
 	else
 	{
@@ -152,6 +304,7 @@ void add_waypoint(struct waypoint3D wp, int16_t flags)
 	DPRINT("Must define USE_DYNAMIC_WAYPOINTS in order to add waypoints\r\n");
 
 #endif // USE_DYNAMIC_WAYPOINTS
+	return true;
 }
 /*
 void add_waypoint(int32_t x, int32_t y, int16_t z, int16_t flags)
@@ -196,6 +349,10 @@ static void load_flightplan(const struct waypointDef* waypoints, int count)
 		dst_wp->viewpoint = src_wp->viewpoint;
 	}
 	numPointsInCurrentSet = count;
+	leg_cache_clear();
+#if (USE_MISSION_STORE)
+	mission_stored = false;
+#endif
 }
 
 #else
@@ -204,6 +361,10 @@ static void load_flightplan(const struct waypointDef* waypoints, int count)
 {
 	currentWaypointSet = waypoints;
 	numPointsInCurrentSet = count;
+	leg_cache_clear();
+#if (USE_MISSION_STORE)
+	mission_stored = false;
+#endif
 }
 
 #endif
@@ -218,11 +379,26 @@ void flightplan_waypoints_init(void)
 	load_flightplan(waypoints, NUMBER_POINTS);
 }
 
+// Start the first leg of a flight plan, from the current location
+static void begin_leg(void)
+{
+	if (!waypoint_relative(waypointIndex, &current_waypoint))
+	{
+		leg_pending = LEG_PENDING_BEGIN;
+		return;
+	}
+	leg_pending = LEG_READY;
+	navigate_set_goal(GPSlocation, current_waypoint.loc);
+	set_camera_view(current_waypoint.viewpoint);
+	setBehavior(current_waypoint.flags);
+}
+
 // In the future, we could include more than 2 waypoint sets...
 // flightplanNum is 0 for main waypoints, and 1 for RTL waypoints
 //void init_flightplan(int16_t flightplanNum)
 void flightplan_waypoints_begin(int16_t flightplanNum)
 {
+	waypointIndex = 0;
 	if (flightplanNum == 1)         // RTL waypoint set
 	{
 		load_flightplan(rtlWaypoints, NUMBER_RTL_POINTS);
@@ -231,27 +407,40 @@ void flightplan_waypoints_begin(int16_t flightplanNum)
 	}
 	else if (flightplanNum == 0)    // Main waypoint set
 	{
+#if (USE_MISSION_STORE)
+		// an uploaded mission replaces the main waypoint set, and after a
+		// power cycle carries on from the leg it was flying
+		if (mission_store_count() > 0)
+		{
+			select_stored_mission();
+			if (!mission_resumed)
+			{
+				waypointIndex = mission_store_resume_index();
+				mission_resumed = true;
+			}
+		}
+		else
+#endif
 		load_flightplan(waypoints, NUMBER_POINTS);
 //		currentWaypointSet = (struct waypointDef*)waypoints;
 //		numPointsInCurrentSet = NUMBER_POINTS;
 	}
-	waypointIndex = 0;
-	current_waypoint = wp_to_relative(currentWaypointSet[0]);
-	navigate_set_goal(GPSlocation, current_waypoint.loc);
-	set_camera_view(current_waypoint.viewpoint);
-	setBehavior(current_waypoint.flags);
+	begin_leg();
 	// udb_background_trigger();    // trigger navigation immediately
 }
 
 //struct waypoint3D getWaypoint3D(uint16_t wp)
-vect3_32t getWaypoint3D(uint16_t wp)
+// Returns false if the point is paged out, it is then fetched in the background.
+boolean getWaypoint3D(uint16_t wp, vect3_32t* v)
 {
 //struct waypoint3D    { int32_t x; int32_t y; int16_t z; };
 //	struct waypoint3D = currentWaypointSet[wp].loc;
 
-	vect3_32t v;
-	v = wp_to_absolute_coords(currentWaypointSet[wp]);
-	return v;
+	struct waypointDef def;
+
+	if (!waypoint_fetch(wp, &def)) return false;
+	*v = wp_to_absolute_coords(def);
+	return true;
 
 //	return currentWaypointSet[wp].loc;
 }
@@ -261,6 +450,37 @@ void mavlink_waypoint_reached(int16_t waypoint);
 void mavlink_waypoint_changed(int16_t waypoint);
 #endif
 
+// Start the leg into waypointIndex
+static void set_leg(void)
+{
+	if (numPointsInCurrentSet > 1)
+	{
+		struct relLegDef* leg = leg_lookup(waypointIndex);
+		if (leg == NULL)
+		{
+			leg_pending = LEG_PENDING_SET;
+			return;
+		}
+		current_waypoint = leg->to;
+		navigate_set_goal_params(&leg->goal, leg->extended);
+	}
+	else
+	{
+		if (!waypoint_relative(0, &current_waypoint))
+		{
+			leg_pending = LEG_PENDING_SET;
+			return;
+		}
+		navigate_set_goal(GPSlocation, current_waypoint.loc);
+	}
+	leg_pending = LEG_READY;
+	set_camera_view(current_waypoint.viewpoint);
+	setBehavior(current_waypoint.flags);
+#if (DEADRECKONING == 0)
+	navigate_compute_bearing_to_goal();
+#endif
+}
+
 void set_waypoint(int16_t index)
 {
 	DPRINT("set_waypoint(%u)\r\n", index);
@@ -271,34 +491,13 @@ void set_waypoint(int16_t index)
 #if (USE_MAVLINK == 1)
 		mavlink_waypoint_changed(waypointIndex);
 #endif
-		if (waypointIndex == 0)
+#if (USE_MISSION_STORE)
+		if (mission_stored)
 		{
-			if (numPointsInCurrentSet > 1)
-			{
-				struct relWaypointDef previous_waypoint = wp_to_relative(currentWaypointSet[numPointsInCurrentSet-1]);
-				current_waypoint  = wp_to_relative(currentWaypointSet[0]);
-				navigate_set_goal(previous_waypoint.loc, current_waypoint.loc);
-				set_camera_view(current_waypoint.viewpoint);
-			}
-			else
-			{
-				current_waypoint = wp_to_relative(currentWaypointSet[0]);
-				navigate_set_goal(GPSlocation, current_waypoint.loc);
-				set_camera_view(current_waypoint.viewpoint);
-			}
-			setBehavior(currentWaypointSet[0].flags);
+			mission_store_set_resume(waypointIndex);
 		}
-		else
-		{
-			struct relWaypointDef previous_waypoint = wp_to_relative(currentWaypointSet[waypointIndex-1]);
-			current_waypoint = wp_to_relative(currentWaypointSet[waypointIndex]);
-			navigate_set_goal(previous_waypoint.loc, current_waypoint.loc);
-			set_camera_view(current_waypoint.viewpoint);
-			setBehavior(current_waypoint.flags);
-		}
-#if (DEADRECKONING == 0)
-		navigate_compute_bearing_to_goal();
 #endif
+		set_leg();
 	}
 }
 
@@ -357,6 +556,23 @@ static void next_waypoint(void)
 //void run_flightplan(void)
 void flightplan_waypoints_update(void)
 {
+#if (USE_MISSION_STORE)
+	if (mission_stored)
+	{
+		mission_store_set_window(waypointIndex);
+	}
+#endif
+	// retry a leg that was waiting for its points to be paged in
+	if (leg_pending == LEG_PENDING_BEGIN)
+	{
+		begin_leg();
+	}
+	else if (leg_pending == LEG_PENDING_SET)
+	{
+		set_leg();
+	}
+	leg_cache_prefetch();
+
 	// first run any injected wp from the serial port
 	if (wp_inject_pos == WP_INJECT_READY)
 	{
@@ -390,7 +606,13 @@ void flightplan_waypoints_update(void)
 		{
 			if (desired_behavior._.loiter)
 			{
-				navigate_set_goal(GPSlocation, wp_to_relative(currentWaypointSet[waypointIndex]).loc);
+				struct relWaypointDef loiter_waypoint;
+
+				if (!waypoint_relative(waypointIndex, &loiter_waypoint))
+				{
+					loiter_waypoint = current_waypoint;
+				}
+				navigate_set_goal(GPSlocation, loiter_waypoint.loc);
 			}
 			else
 			{
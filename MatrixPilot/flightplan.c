@@ -120,6 +120,14 @@ void flightplan_live_commit(void)
 	}
 }
 
+void flightplan_origin_changed(void)
+{
+	// only the waypoint legs are cached in relative coordinates
+	if (!flightplan_logo_active) {
+		flightplan_waypoints_origin_changed();
+	}
+}
+
 #else
 
 void flightplan_init(void) {}
@@ -129,5 +137,6 @@ int16_t flightplan_index_get(void) { return 0; }
 void flightplan_live_begin(void) {}
 void flightplan_live_received_byte(uint8_t inbyte) {}
 void flightplan_live_commit(void) {}
+void flightplan_origin_changed(void) {}
 
 #endif // FLIGHT_PLAN_TYPE
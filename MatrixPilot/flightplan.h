@@ -33,5 +33,6 @@ int16_t flightplan_index_get(void);
 void flightplan_live_begin(void);
 void flightplan_live_received_byte(uint8_t inbyte);
 void flightplan_live_commit(void);
+void flightplan_origin_changed(void);
 
 #endif // FLIGHTPLAN_H
@@ -22,6 +22,78 @@
 #ifndef FLIGHTPLAN_LOGO_H
 #define FLIGHTPLAN_LOGO_H
 
+#include "options_mavlink.h"
+
+// If we've processed this many instructions without commanding the plane to fly,
+// then stop and continue on the next run through
+#ifndef MAX_INSTRUCTIONS_PER_CYCLE
+#define MAX_INSTRUCTIONS_PER_CYCLE  32
+#endif
+
+// How many layers deep can Ifs, Repeats and Subroutines be nested
+#ifndef LOGO_STACK_DEPTH
+#define LOGO_STACK_DEPTH            12
+#endif
+
+// Set to 1 to gather interpreter statistics, used by Tools/LogoSim
+#ifndef LOGO_PROFILE
+#define LOGO_PROFILE                0
+#endif
+
+#if (LOGO_PROFILE == 1)
+struct logoProfile {
+	uint32_t cycles;                // runs of the interpreter
+	uint32_t cyclesAtLimit;         // runs stopped by MAX_INSTRUCTIONS_PER_CYCLE
+	uint32_t instructions;          // instructions interpreted
+	uint32_t restarts;              // times the program ran off its end back to the top
+	int16_t  maxStackDepth;         // high water mark of the stack index
+	uint32_t perCycle[MAX_INSTRUCTIONS_PER_CYCLE + 1]; // runs by number of instructions
+};
+extern struct logoProfile logo_profile;
+#endif
+
+// Largest Logo program that can be uploaded, see options_mavlink.h
+#ifndef LOGO_UPLOAD_INSTRUCTIONS
+#define LOGO_UPLOAD_INSTRUCTIONS    0
+#endif
+
+// Uploaded programs are kept in non volatile memory when it is available
+#define USE_LOGO_STORE              (USE_NV_MEMORY == 1 && LOGO_UPLOAD_INSTRUCTIONS > 0)
+
+#if (LOGO_UPLOAD_INSTRUCTIONS > 0)
+// Each uploaded instruction is a record of 5 bytes:
+// cmd, subcmd, flags (do_fly in bit 4, use_param in bit 0), arg high byte, arg low byte
+#define LOGO_RECORD_SIZE            5
+
+// First word of an uploaded or saved program
+#define LOGO_PROGRAM_MAGIC          0x4F4C
+
+// Results of an upload
+enum {
+	LOGO_UPLOAD_OK = 0,
+	LOGO_UPLOAD_BUSY,               // the previous program is still being saved
+	LOGO_UPLOAD_BAD_SIZE,           // too big, or not the size announced
+	LOGO_UPLOAD_BAD_CHECKSUM,
+	LOGO_UPLOAD_BAD_INSTRUCTION,
+	LOGO_UPLOAD_BAD_NESTING,        // unmatched END or ELSE, TO inside a block, or TO without its END
+	LOGO_UPLOAD_NO_SUBROUTINE,      // DO, EXEC or SET_INTERRUPT of a missing TO
+	LOGO_UPLOAD_BAD_MAGIC,          // the header does not start with LOGO_PROGRAM_MAGIC
+};
+
+// Start receiving a program of numRecords instructions, main and RTL together
+int16_t flightplan_logo_upload_begin(uint16_t numRecords);
+// Store record bytes, starting at byte offset into the records
+void flightplan_logo_upload_data(uint16_t offset, const uint8_t* data, uint16_t length);
+// Check the received program. If it is good, it replaces the running program
+// at the next safe point and is saved to non volatile memory.
+int16_t flightplan_logo_upload_commit(uint16_t numInstructions, uint16_t numRTLInstructions, uint16_t checksum);
+#endif // LOGO_UPLOAD_INSTRUCTIONS
+
+#if (USE_LOGO_STORE)
+void flightplan_logo_store_init(void);
+void flightplan_logo_store_trigger(void);
+#endif
+
 
 void flightplan_logo_init(void);
 void flightplan_logo_begin(int16_t flightplanNum);
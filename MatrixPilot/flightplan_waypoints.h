@@ -26,13 +26,29 @@
 //#define USE_DYNAMIC_WAYPOINTS
 #define MAX_WAYPOINTS 20
 
+// Largest mission that can be uploaded over MAVLink
+#if (USE_NV_MEMORY == 1 && MISSION_STORE_POINTS > 0)
+#define MAX_MISSION_POINTS MISSION_STORE_POINTS
+#else
+#define MAX_MISSION_POINTS MAX_WAYPOINTS
+#endif
+
+// Number of legs held in the relative leg cache. Plans with more points
+// than this are compiled a window of legs ahead of the current waypoint.
+#ifndef WAYPOINT_LEG_CACHE_SIZE
+#define WAYPOINT_LEG_CACHE_SIZE 16
+#endif
+
+struct waypointDef { struct waypoint3D loc; int16_t flags; struct waypoint3D viewpoint; };
+
 extern int16_t waypointIndex;
 
-vect3_32t getWaypoint3D(uint16_t wp);
+boolean getWaypoint3D(uint16_t wp, vect3_32t* v);
 int16_t waypoint_count(void);
 void set_waypoint(int16_t index);
 void clear_flightplan(void);
-void add_waypoint(struct waypoint3D wp, int16_t flags);
+boolean add_waypoint(struct waypoint3D wp, int16_t flags);
+void commit_flightplan(void);
 
 void flightplan_waypoints_init(void);
 void flightplan_waypoints_begin(int16_t flightplanNum);
@@ -41,6 +57,7 @@ int16_t flightplan_waypoints_index_get(void);
 void flightplan_waypoints_live_begin(void);
 void flightplan_waypoints_live_received_byte(uint8_t inbyte);
 void flightplan_waypoints_live_commit(void);
+void flightplan_waypoints_origin_changed(void);
 
 
 #endif // FLIGHTPLAN_WAYPOINTS_H
@@ -31,8 +31,10 @@
 #include "../libDCM/deadReckoning.h"
 #include "../libDCM/mathlibNAV.h"
 #include "../libDCM/rmat.h"
+#include "../libUDB/events.h"
 #include <math.h>
 #include <stdlib.h> // for declaration of function abs() under gcc
+#include <string.h>
 #include "options_airspeed.h" 
 
 //#ifndef RTL_PITCH_DOWN
@@ -69,12 +71,32 @@
 #define AOA_INVERTED       ((int16_t)(turns.AngleOfAttackInverted*(RMAX/57.3)))
 #define ELEV_TRIM_NORMAL   ((int16_t)SERVORANGE*turns.ElevatorTrimNormal)
 #define ELEV_TRIM_INVERTED ((int16_t)SERVORANGE*turns.ElevatorTrimInverted)
-#define STALL_SPEED_CM_SEC ((uint16_t)turns.RefSpeed*50.0) // assume stall speed approximately 1/2 of reference speed
-
-#define AOA_OFFSET           ((int16_t)((AOA_NORMAL + AOA_INVERTED)/2)) // offset is the average of the two values
-#define AOA_SLOPE            ((int16_t)((AOA_NORMAL - AOA_INVERTED) * 4)) // multiply by 4 because base speed is 1/2 of cruise
-#define ELEVATOR_TRIM_OFFSET ((int16_t)((ELEV_TRIM_NORMAL + ELEV_TRIM_INVERTED)/2)) // offset is the average of the two values
-#define ELEVATOR_TRIM_SLOPE  ((int16_t)((ELEV_TRIM_NORMAL - ELEV_TRIM_INVERTED) * 4)) // multiply by 4 because base speed is 1/2 of cruise
+#define STALL_SPEED_CM_SEC ((uint16_t)(turns.RefSpeed*50.0)) // assume stall speed approximately 1/2 of reference speed
+
+// (V0/V)**2 is tabulated with a 16 bit fraction at equal steps of airspeed,
+// from the stall speed V0 up to at least 5 times the stall speed.
+// The step is a power of 2 so that the table is indexed with a shift.
+#define SPEED_TABLE_SIZE     65
+
+struct wing_model {
+	int16_t aoaOffset;              // offset is the average of the two values
+	int16_t aoaSlope;               // multiply by 4 because base speed is 1/2 of cruise
+	int16_t elevatorTrimOffset;     // offset is the average of the two values
+	int16_t elevatorTrimSlope;      // multiply by 4 because base speed is 1/2 of cruise
+	uint16_t stallSpeed;            // centimeters per second
+	int16_t speedTableShift;
+	uint16_t speedRatioSquared[SPEED_TABLE_SIZE];
+};
+
+// The wing loading model is computed from the turns options by init_helicalTurnCntrl(),
+// and again from a low priority event, polled at 2Hz by helicalTurnCntrl(), when they
+// change. The new model is built in the spare buffer and then switched to, so the
+// control loop never sees a part built model.
+static struct wing_model wingModels[2];
+static struct wing_model* volatile wingModel = &wingModels[0];
+static struct turns_variables turnsModel; // the turns options the model was computed from
+static uint16_t wing_model_event_handle = INVALID_HANDLE;
+#define WING_MODEL_CHECK_COUNT 20   // 2Hz at the 40Hz control rate
 
 #define GRAVITYCMSECSEC      (981)
 #define RADSTOGYRO           ((uint16_t)48*SCALEGYRO) // used in the conversion from radians per second to raw gyro units
@@ -142,29 +164,42 @@ static int16_t wingLift(int16_t X, int16_t Z, int16_t XoverZ)
 // Implement as 8*((2**16)*(a/(16g))*(V0/V)**2
 //
 
-static int16_t relativeWingLoading(int16_t wingLoad, uint16_t airSpeed)
+static uint16_t speed_ratio_squared(const struct wing_model* model, uint16_t airSpeed)
+{
+	// airSpeed must be more than the stall speed
+	// returns (2**16)*(V0/V)**2, interpolated from the table
+	const uint16_t* table = model->speedRatioSquared;
+	int16_t shift = model->speedTableShift;
+	uint16_t offset = airSpeed - model->stallSpeed;
+	uint16_t index = offset >> shift;
+	uint16_t fraction;
+
+	if (index >= SPEED_TABLE_SIZE - 1)
+	{
+		return table[SPEED_TABLE_SIZE - 1];
+	}
+	fraction = (offset - (index << shift)) << (16 - shift);
+	return table[index] -
+	    (uint16_t)(__builtin_muluu(table[index] - table[index + 1], fraction) >> 16);
+}
+
+static int16_t relativeWingLoading(const struct wing_model* model, int16_t wingLoad, uint16_t airSpeed)
 {
 	// wingLoad is(2**16)*((wing_load / mass*gravity) / 16)
 	// stallSpeed is the stall speed in centimeters per second
 	// airSpeed is the air speed in centimeters per second
 
-	uint16_t stallSpeed = STALL_SPEED_CM_SEC;
 	int16_t result = 0;
-	uint32_t long_unsigned_accum;
 	union longww long_signed_accum;
 	uint16_t unsigned_accum;
 
 	// if airspeed is less than or equal to stall speed, return zero
-	if (airSpeed <= stallSpeed)
+	if (airSpeed <= model->stallSpeed)
 	{
 		return 0;
 	}
 
-	long_unsigned_accum = (uint32_t)stallSpeed;
-	long_unsigned_accum = long_unsigned_accum << 16; //(2**16)*V0, 32 bits unsigned
-	unsigned_accum = __builtin_divud(long_unsigned_accum, airSpeed); //(2**16)*(V0/V), 16 bits unsigned
-	long_unsigned_accum = __builtin_muluu(unsigned_accum, unsigned_accum); //(2**32)*(V0/V)**2, 32 bits unsigned
-	unsigned_accum = long_unsigned_accum >> 16; //(2**16)*(V0/V)**2, 16 bits unsigned
+	unsigned_accum = speed_ratio_squared(model, airSpeed); //(2**16)*(V0/V)**2, 16 bits unsigned
 	long_signed_accum.WW = __builtin_mulus(unsigned_accum, wingLoad); //(2**32)*(a/16g)*(V0/V)**2, 32 bits unsigned
 	if (abs(long_signed_accum._.W1) < 4095)
 	{
@@ -186,6 +221,59 @@ static int16_t relativeWingLoading(int16_t wingLoad, uint16_t airSpeed)
 }
 
 
+// Build the wing loading model from the turns options into the spare buffer,
+// then switch the control loop over to it
+static void build_wing_model(void)
+{
+	struct wing_model* model = (wingModel == &wingModels[0]) ? &wingModels[1] : &wingModels[0];
+	uint16_t stallSpeed;
+	uint32_t span;
+	uint32_t ratio;
+	int16_t i;
+
+	turnsModel = turns;
+	model->aoaOffset          = (int16_t)((AOA_NORMAL + AOA_INVERTED)/2);
+	model->aoaSlope           = (int16_t)((AOA_NORMAL - AOA_INVERTED) * 4);
+	model->elevatorTrimOffset = (int16_t)((ELEV_TRIM_NORMAL + ELEV_TRIM_INVERTED)/2);
+	model->elevatorTrimSlope  = (int16_t)((ELEV_TRIM_NORMAL - ELEV_TRIM_INVERTED) * 4);
+	stallSpeed = STALL_SPEED_CM_SEC;
+	if (stallSpeed == 0) stallSpeed = 1;
+	model->stallSpeed = stallSpeed;
+
+	span = 4 * (uint32_t)stallSpeed;
+	model->speedTableShift = 0;
+	while (((uint32_t)(SPEED_TABLE_SIZE - 1) << model->speedTableShift) < span)
+	{
+		model->speedTableShift++;
+	}
+	model->speedRatioSquared[0] = 0xFFFF;
+	for (i = 1; i < SPEED_TABLE_SIZE; i++)
+	{
+		ratio = ((uint32_t)stallSpeed << 16) / (stallSpeed + ((uint32_t)i << model->speedTableShift)); //(2**16)*(V0/V)
+		model->speedRatioSquared[i] = (ratio * ratio) >> 16;
+	}
+	wingModel = model;
+}
+
+// Low priority event, rebuilds the model if the turns options have been
+// changed, by a parameter set or a load from nv memory
+static void wing_model_service(void)
+{
+	if (memcmp(&turnsModel, &turns, sizeof(turns)) != 0)
+	{
+		build_wing_model();
+	}
+}
+
+void init_helicalTurnCntrl(void)
+{
+	if (wing_model_event_handle == INVALID_HANDLE)
+	{
+		wing_model_event_handle = register_event_p(&wing_model_service, EVENT_PRIORITY_LOW);
+	}
+	build_wing_model();
+}
+
 // helicalTurnCntrl determines the values of the elements of the bottom row of rmat
 // as well as the required rotation rates in the body frame that are required to make a coordinated turn.
 // The required values for the bottom row of rmat are placed in the vector desiredTilt.
@@ -216,6 +304,14 @@ void helicalTurnCntrl(void)
 	int16_t pitchError;
 	int16_t pitchEarthBodyProjection[2];
 	int16_t angleOfAttack;
+	const struct wing_model* model = wingModel;
+	static uint8_t wing_model_counter = 0;
+
+	if (++wing_model_counter >= WING_MODEL_CHECK_COUNT)
+	{
+		wing_model_counter = 0;
+		trigger_event(wing_model_event_handle);
+	}
 #ifdef TestGains
 	state_flags._.GPS_steering = 0;   // turn off navigation
 	state_flags._.pitch_feedback = 1; // turn on stabilization
@@ -306,24 +402,28 @@ void helicalTurnCntrl(void)
 	// gravity is 981 centimeters per second per second 
 
 	desiredTilt.WW = - __builtin_mulsu(desiredTurnRateRadians, airSpeed);
-	desiredTilt.WW /= GRAVITYCMSECSEC;
 
 	// limit the lateral acceleration to +- 4 times gravity, total wing loading approximately 4.12 times gravity
+	// the limits are checked before the divide by gravity, so that the quotient fits in 16 bits
 
-	if (desiredTilt.WW > (int32_t)2 * (int32_t)RMAX - 1)
+	if (desiredTilt.WW > ((int32_t)2 * (int32_t)RMAX - 1) * GRAVITYCMSECSEC)
 	{
 		desiredTilt.WW = (int32_t)2 * (int32_t)RMAX - 1;
 		accum.WW = __builtin_mulsu(-desiredTilt._.W0, GRAVITYCMSECSEC);
 		accum.WW /= airSpeed;
 		desiredTurnRateRadians = accum._.W0;
 	}
-	else if (desiredTilt.WW < -(int32_t)2 * (int32_t)RMAX + 1)
+	else if (desiredTilt.WW < (-(int32_t)2 * (int32_t)RMAX + 1) * GRAVITYCMSECSEC)
 	{
 		desiredTilt.WW = -(int32_t)2 * (int32_t)RMAX + 1;
 		accum.WW = __builtin_mulsu(-desiredTilt._.W0, GRAVITYCMSECSEC);
 		accum.WW /= airSpeed;
 		desiredTurnRateRadians = accum._.W0;
 	}
+	else
+	{
+		desiredTilt.WW = __builtin_divsd(desiredTilt.WW, GRAVITYCMSECSEC);
+	}
 
 	// Compute the amount of lift needed to perform the desired turn
 	// Tests show that the best estimate of lift is obtained using
@@ -342,23 +442,23 @@ void helicalTurnCntrl(void)
 	// If airspeed is greater than stall speed, compute angle of attack and elevator trim,
 	// otherwise set AoA and trim to zero.
 
-	if (air_speed_3DIMU > STALL_SPEED_CM_SEC)
+	if (air_speed_3DIMU > model->stallSpeed)
 	{
 		// compute "x/2", the relative wing loading
-		relativeLoading = relativeWingLoading(estimatedLift, air_speed_3DIMU);
+		relativeLoading = relativeWingLoading(model, estimatedLift, air_speed_3DIMU);
 
 		// multiply x/2 by 2m for angle of attack
-		accum.WW = __builtin_mulss(AOA_SLOPE, relativeLoading);
+		accum.WW = __builtin_mulss(model->aoaSlope, relativeLoading);
 		// add mx to b
-		angleOfAttack = AOA_OFFSET + accum._.W1;
+		angleOfAttack = model->aoaOffset + accum._.W1;
 
 		// project angle of attack into the earth frame
 		accum.WW =(__builtin_mulss(angleOfAttack, rmat[8])) << 2;
 		pitchAdjustAngleOfAttack = accum._.W1;
 
 		// similarly, compute elevator trim
-		accum.WW = __builtin_mulss(ELEVATOR_TRIM_SLOPE, relativeLoading);
-		elevatorLoadingTrim = ELEVATOR_TRIM_OFFSET + accum._.W1;
+		accum.WW = __builtin_mulss(model->elevatorTrimSlope, relativeLoading);
+		elevatorLoadingTrim = model->elevatorTrimOffset + accum._.W1;
 	}
 	else
 	{
@@ -371,7 +471,7 @@ void helicalTurnCntrl(void)
 	// convert desired turn rate from radians/second to gyro units
 
 	accum.WW = (((int32_t)desiredTurnRateRadians) << 4);  // desired turn rate in radians times 16 to provide resolution for the divide to follow
-	accum.WW = accum.WW / RADSTOGYRO; // at this point accum._.W0 has 2 times the required gyro signal for the turn.
+	accum.WW = __builtin_divsd(accum.WW, RADSTOGYRO); // at this point accum._.W0 has 2 times the required gyro signal for the turn.
 
 	// compute desired rotation rate vector in body frame, scaling is same as gyro signal
 
@@ -24,4 +24,5 @@ extern int16_t desiredRotationRateRadians[3];
 extern int16_t rotationRateError[3];
 //extern int16_t angleOfAttack;
 
+void init_helicalTurnCntrl(void);
 void helicalTurnCntrl(void);
@@ -46,10 +46,13 @@
 #include "options_mavlink.h"
 #include <setjmp.h>
 
-//#include "../libFlashFS/filesys.h"
+#include "../libFlashFS/filesys.h"
 
 #if (USE_TELELOG == 1)
 #include "telemetry_log.h"
+#if (USE_MAVLINK == 1)
+#include "MAVLogs.h"
+#endif
 #endif
 
 #if (USE_USB == 1)
@@ -73,7 +76,7 @@ int matrixpilot_init(void)
 #endif
 	gps_init();     // this sets function pointers so i'm calling it early for now
 	udb_init();     // configure clocks and enables global interrupts
-//	filesys_init(); // attempts to mount a file system
+	filesys_init(); // attempts to mount a file system
 	config_init();  // reads .ini files otherwise initialises with defaults
 	dcm_init();
 #if (FLIGHT_PLAN_TYPE == FP_WAYPOINTS)
@@ -98,6 +101,9 @@ int matrixpilot_loop(void)
 {
 #if (USE_TELELOG == 1)
 	telemetry_log();
+#if (USE_MAVLINK == 1)
+	MAVLogsService();
+#endif
 #endif
 #if (USE_USB == 1)
 	USBPollingService();
@@ -33,7 +33,10 @@
 //#define NDEBUG
 
 #define MININI_IMPLEMENTATION
-#if (WIN == 1 || NIX == 1 || PX4 == 1 || NOFS == 1)
+#if (WIN == 1 || NIX == 1)
+#include "../libUDB/libUDB.h"   // SILSIM_MEDIA, the SIL storage
+#endif
+#if ((WIN == 1 || NIX == 1) && (SILSIM_MEDIA == SILSIM_MEDIA_HOST)) || (PX4 == 1 || NOFS == 1)
 #include "minGlue.h"
 #else
 #include "minGlue-mdd.h"
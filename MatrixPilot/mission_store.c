@@ -0,0 +1,460 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2015 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+//******************************************************************/
+// MISSION STORE
+// Keeps uploaded missions in a self managed data storage area, so that
+// missions can be much larger than RAM and survive a power cycle.
+// A few pages of points are held in RAM: the window of upcoming legs,
+// prefetched in the background, plus any page that has been asked for.
+//
+// Layout of the storage area:
+//   header (count, resume index, checksum)
+//   MISSION_STORE_POINTS x struct waypointDef
+//
+
+#include "defines.h"
+#include "flightplan_waypoints.h"
+#include "mission_store.h"
+
+#if (USE_MISSION_STORE)
+
+#include "data_storage.h"
+#include "parameter_datatypes.h"
+#include "../libUDB/events.h"
+#include <string.h>
+
+// Include MAVlink library for checksums
+#include "../MAVLink/include/mavlink_types.h"
+#include "../MAVLink/include/checksum.h"
+
+#define MISSION_STORE_PAGE_COUNT    ((MISSION_STORE_POINTS + MISSION_PAGE_POINTS - 1) / MISSION_PAGE_POINTS)
+#define MISSION_PAGE_SIZE           (MISSION_PAGE_POINTS * sizeof(struct waypointDef))
+#define MISSION_STORE_SIZE          (sizeof(struct mission_header) + MISSION_STORE_PAGE_COUNT * MISSION_PAGE_SIZE)
+
+#define MISSION_MAGIC               0x4D53
+
+enum
+{
+	MISSION_STORE_NOT_STARTED,
+	MISSION_STORE_CREATING,
+	MISSION_STORE_READING_HEADER,
+	MISSION_STORE_IDLE,
+	MISSION_STORE_BUSY,
+};
+
+enum
+{
+	PAGE_EMPTY,
+	PAGE_LOADING,       // being read from nv memory
+	PAGE_VALID,         // same as nv memory
+	PAGE_FILLING,       // being uploaded, not yet complete
+	PAGE_DIRTY,         // waiting to be written
+	PAGE_WRITING,       // being written to nv memory
+};
+
+struct mission_header
+{
+	uint16_t magic;
+	int16_t  count;
+	int16_t  resume;
+	uint16_t checksum;
+};
+
+struct mission_page
+{
+	int16_t page;
+	uint8_t state;
+	struct waypointDef wp[MISSION_PAGE_POINTS];
+};
+
+static struct mission_page mission_pages[MISSION_PAGES];
+static struct mission_header mission_header;        // committed mission
+static struct mission_header mission_header_buffer; // header being read or written
+static boolean mission_header_dirty = false;
+static boolean mission_clear_pending = false;
+
+static uint16_t mission_store_state = MISSION_STORE_NOT_STARTED;
+static uint16_t mission_store_event_handle = INVALID_HANDLE;
+static struct mission_page* mission_active_page = NULL;
+
+static int16_t mission_upload_count = 0;
+static int16_t mission_window_page = 0;
+static int16_t mission_requested_page = -1;
+
+static uint16_t mission_header_checksum(const struct mission_header* header)
+{
+	return crc_calculate((uint8_t*)header, sizeof(struct mission_header) - sizeof(header->checksum));
+}
+
+static uint16_t mission_page_offset(int16_t page)
+{
+	return sizeof(struct mission_header) + page * MISSION_PAGE_SIZE;
+}
+
+static struct mission_page* mission_find_page(int16_t page)
+{
+	int16_t i;
+
+	for (i = 0; i < MISSION_PAGES; i++)
+	{
+		if (mission_pages[i].page == page && mission_pages[i].state != PAGE_EMPTY && mission_pages[i].state != PAGE_LOADING)
+		{
+			return &mission_pages[i];
+		}
+	}
+	return NULL;
+}
+
+// A page is wanted if it is in the window of upcoming legs, or was asked for
+static boolean mission_page_wanted(int16_t page)
+{
+	if (page == mission_requested_page) return true;
+	return (page >= mission_window_page && page < mission_window_page + MISSION_PAGES - 1);
+}
+
+// Find a RAM page that can be reused for another page of the mission
+static struct mission_page* mission_free_page(void)
+{
+	int16_t i;
+
+	for (i = 0; i < MISSION_PAGES; i++)
+	{
+		if (mission_pages[i].state == PAGE_EMPTY) return &mission_pages[i];
+	}
+	for (i = 0; i < MISSION_PAGES; i++)
+	{
+		if (mission_pages[i].state == PAGE_VALID && !mission_page_wanted(mission_pages[i].page)) return &mission_pages[i];
+	}
+	return NULL;
+}
+
+static void mission_create_callback(boolean success)
+{
+	if (success)
+	{
+		mission_header.count = 0;
+		mission_header.resume = 0;
+		mission_clear_pending = true;
+		mission_store_state = MISSION_STORE_IDLE;
+	}
+	else
+	{
+		mission_store_state = MISSION_STORE_NOT_STARTED;
+	}
+}
+
+static void mission_read_header_callback(boolean success)
+{
+	if (success &&
+	    mission_header_buffer.magic == MISSION_MAGIC &&
+	    mission_header_buffer.checksum == mission_header_checksum(&mission_header_buffer) &&
+	    mission_header_buffer.count <= MISSION_STORE_POINTS)
+	{
+		mission_header = mission_header_buffer;
+	}
+	else
+	{
+		mission_header.count = 0;
+		mission_header.resume = 0;
+	}
+	mission_store_state = MISSION_STORE_IDLE;
+}
+
+static void mission_write_header_callback(boolean success)
+{
+	if (mission_clear_pending)
+	{
+		if (success)
+		{
+			mission_clear_pending = false;
+			if (mission_header.count == 0) mission_header_dirty = false;
+		}
+	}
+	else if (!success)
+	{
+		mission_header_dirty = true;
+	}
+	mission_store_state = MISSION_STORE_IDLE;
+}
+
+static void mission_write_page_callback(boolean success)
+{
+	// the page may have been discarded by a new upload while it was written
+	if (mission_active_page->state == PAGE_WRITING)
+	{
+		mission_active_page->state = success ? PAGE_VALID : PAGE_DIRTY;
+	}
+	mission_store_state = MISSION_STORE_IDLE;
+}
+
+static void mission_read_page_callback(boolean success)
+{
+	if (mission_active_page->state == PAGE_LOADING)
+	{
+		mission_active_page->state = success ? PAGE_VALID : PAGE_EMPTY;
+	}
+	mission_store_state = MISSION_STORE_IDLE;
+}
+
+static boolean mission_write_dirty_page(void)
+{
+	int16_t i;
+
+	if (mission_clear_pending) return false;
+
+	for (i = 0; i < MISSION_PAGES; i++)
+	{
+		struct mission_page* p = &mission_pages[i];
+
+		if (p->state == PAGE_DIRTY)
+		{
+			mission_active_page = p;
+			p->state = PAGE_WRITING;
+			if (storage_write_part(STORAGE_HANDLE_WAYPOINTS, (uint8_t*)p->wp, mission_page_offset(p->page), MISSION_PAGE_SIZE, &mission_write_page_callback))
+			{
+				mission_store_state = MISSION_STORE_BUSY;
+			}
+			else
+			{
+				p->state = PAGE_DIRTY;
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+static boolean mission_write_header(void)
+{
+	int16_t i;
+
+	if (!mission_header_dirty && !mission_clear_pending) return false;
+
+	mission_header_buffer = mission_header;
+	if (mission_clear_pending)
+	{
+		// The cleared header goes first, before any page of a new mission
+		// is written, so that a power cycle part way through an upload
+		// leaves no mission rather than a broken one.
+		mission_header_buffer.count = 0;
+		mission_header_buffer.resume = 0;
+	}
+	else
+	{
+		// A committed mission is only written after all of its pages
+		for (i = 0; i < MISSION_PAGES; i++)
+		{
+			if (mission_pages[i].state >= PAGE_FILLING) return false;
+		}
+		mission_header_dirty = false;
+	}
+	mission_header_buffer.magic = MISSION_MAGIC;
+	mission_header_buffer.checksum = mission_header_checksum(&mission_header_buffer);
+
+	if (storage_write_part(STORAGE_HANDLE_WAYPOINTS, (uint8_t*)&mission_header_buffer, 0, sizeof(mission_header_buffer), &mission_write_header_callback))
+	{
+		mission_store_state = MISSION_STORE_BUSY;
+	}
+	else if (!mission_clear_pending)
+	{
+		mission_header_dirty = true;
+	}
+	return true;
+}
+
+static boolean mission_prefetch_page(int16_t page)
+{
+	struct mission_page* p;
+
+	if (page < 0 || page * MISSION_PAGE_POINTS >= mission_header.count) return false;
+	if (mission_find_page(page) != NULL) return false;
+	if ((p = mission_free_page()) == NULL) return false;
+
+	mission_active_page = p;
+	p->state = PAGE_LOADING;
+	p->page = page;
+	if (storage_read_part(STORAGE_HANDLE_WAYPOINTS, (uint8_t*)p->wp, mission_page_offset(page), MISSION_PAGE_SIZE, &mission_read_page_callback))
+	{
+		mission_store_state = MISSION_STORE_BUSY;
+	}
+	else
+	{
+		p->state = PAGE_EMPTY;
+	}
+	return true;
+}
+
+// Low priority service routine, one nv memory access at a time
+static void mission_store_service(void)
+{
+	int16_t page;
+
+	switch (mission_store_state)
+	{
+	case MISSION_STORE_NOT_STARTED:
+		if (!storage_services_started()) return;
+		if (storage_check_area_exists(STORAGE_HANDLE_WAYPOINTS, MISSION_STORE_SIZE, DATA_STORAGE_SELF_MANAGED))
+		{
+			if (storage_read_part(STORAGE_HANDLE_WAYPOINTS, (uint8_t*)&mission_header_buffer, 0, sizeof(mission_header_buffer), &mission_read_header_callback))
+			{
+				mission_store_state = MISSION_STORE_READING_HEADER;
+			}
+		}
+		else
+		{
+			if (storage_create_area(STORAGE_HANDLE_WAYPOINTS, MISSION_STORE_SIZE, DATA_STORAGE_SELF_MANAGED, &mission_create_callback))
+			{
+				mission_store_state = MISSION_STORE_CREATING;
+			}
+		}
+		break;
+
+	case MISSION_STORE_IDLE:
+		if (mission_write_header()) return;
+		if (mission_write_dirty_page()) return;
+		if (mission_prefetch_page(mission_requested_page)) return;
+		for (page = mission_window_page; page < mission_window_page + MISSION_PAGES - 1; page++)
+		{
+			if (mission_prefetch_page(page)) return;
+		}
+		break;
+	}
+}
+
+void mission_store_init(void)
+{
+	int16_t i;
+
+	for (i = 0; i < MISSION_PAGES; i++)
+	{
+		mission_pages[i].state = PAGE_EMPTY;
+		mission_pages[i].page = -1;
+	}
+	mission_store_event_handle = register_event(&mission_store_service);
+}
+
+void mission_store_trigger(void)
+{
+	trigger_event(mission_store_event_handle);
+}
+
+int16_t mission_store_count(void)
+{
+	return mission_header.count;
+}
+
+int16_t mission_store_resume_index(void)
+{
+	return (mission_header.resume < mission_header.count) ? mission_header.resume : 0;
+}
+
+void mission_store_set_resume(int16_t index)
+{
+	if (mission_header.resume != index)
+	{
+		mission_header.resume = index;
+		mission_header_dirty = true;
+	}
+}
+
+boolean mission_store_get(int16_t index, struct waypointDef* wp)
+{
+	struct mission_page* p;
+
+	if (index < 0 || index >= mission_header.count) return false;
+
+	p = mission_find_page(index / MISSION_PAGE_POINTS);
+	if (p == NULL)
+	{
+		mission_requested_page = index / MISSION_PAGE_POINTS;
+		return false;
+	}
+	*wp = p->wp[index % MISSION_PAGE_POINTS];
+	return true;
+}
+
+void mission_store_set_window(int16_t index)
+{
+	// the window starts one page back, so that the leg into index is covered
+	int16_t page = index / MISSION_PAGE_POINTS;
+	mission_window_page = (index % MISSION_PAGE_POINTS == 0 && page > 0) ? page - 1 : page;
+}
+
+void mission_store_clear(void)
+{
+	int16_t i;
+
+	for (i = 0; i < MISSION_PAGES; i++)
+	{
+		mission_pages[i].state = PAGE_EMPTY;
+		mission_pages[i].page = -1;
+	}
+	mission_upload_count = 0;
+	mission_requested_page = -1;
+	mission_header.count = 0;
+	mission_header.resume = 0;
+	mission_header_dirty = false;
+	mission_clear_pending = true;
+}
+
+boolean mission_store_append(const struct waypointDef* wp)
+{
+	int16_t page = mission_upload_count / MISSION_PAGE_POINTS;
+	struct mission_page* p;
+
+	if (mission_upload_count >= MISSION_STORE_POINTS) return true;  // dropped, store is full
+
+	p = mission_find_page(page);
+	if (p == NULL)
+	{
+		if ((p = mission_free_page()) == NULL) return false;
+		p->page = page;
+		p->state = PAGE_FILLING;
+	}
+	else if (p->state != PAGE_FILLING)
+	{
+		return false;
+	}
+	p->wp[mission_upload_count % MISSION_PAGE_POINTS] = *wp;
+	mission_upload_count++;
+	if (mission_upload_count % MISSION_PAGE_POINTS == 0)
+	{
+		p->state = PAGE_DIRTY;
+	}
+	return true;
+}
+
+void mission_store_commit(void)
+{
+	struct mission_page* p = mission_find_page(mission_upload_count / MISSION_PAGE_POINTS);
+
+	if (p != NULL && p->state == PAGE_FILLING)
+	{
+		p->state = PAGE_DIRTY;
+	}
+	mission_header.count = mission_upload_count;
+	mission_header.resume = 0;
+	mission_header_dirty = true;
+}
+
+#endif // USE_MISSION_STORE
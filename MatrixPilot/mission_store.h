@@ -0,0 +1,64 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2015 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+#ifndef MISSION_STORE_H
+#define MISSION_STORE_H
+
+struct waypointDef;             // flightplan_waypoints.h
+
+// Missions are paged through non volatile memory only when both the nv
+// memory and a mission store size are configured.
+#define USE_MISSION_STORE       (USE_NV_MEMORY == 1 && MISSION_STORE_POINTS > 0)
+
+#if (USE_MISSION_STORE)
+
+// Points are paged between nv memory and RAM in pages of this many points
+#define MISSION_PAGE_POINTS     8
+
+// Number of pages held in RAM, the window of upcoming legs
+#define MISSION_PAGES           3
+
+void mission_store_init(void);
+void mission_store_trigger(void);
+
+// Number of points in the committed mission, 0 if none is stored
+int16_t mission_store_count(void);
+
+// Waypoint index to resume at after a power cycle
+int16_t mission_store_resume_index(void);
+void mission_store_set_resume(int16_t index);
+
+// Copy a point if its page is in RAM, otherwise request the page and return false
+boolean mission_store_get(int16_t index, struct waypointDef* wp);
+
+// Keep the pages from index onwards in RAM
+void mission_store_set_window(int16_t index);
+
+// Upload a new mission. mission_store_append returns false while the
+// pages are busy being written, the point should then be offered again.
+void mission_store_clear(void);
+boolean mission_store_append(const struct waypointDef* wp);
+void mission_store_commit(void);
+
+#endif // USE_MISSION_STORE
+
+#endif // MISSION_STORE_H
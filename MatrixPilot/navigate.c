@@ -37,6 +37,10 @@
 #include "../libDCM/mathlib.h"
 #include "../libDCM/gpsData.h"
 #include "../libDCM/rmat.h"
+#include "../libDCM/mag_drift.h"
+#if (USE_NV_MEMORY == 1)
+#include "data_services.h"
+#endif
 #include <stdlib.h>
 
 // Compute actual and desired courses.
@@ -56,18 +60,6 @@ int16_t progress_to_goal = 0;
 int8_t desired_dir = 0;
 int8_t extended_range = 0;
 
-
-struct waypointparameters {
-	int16_t x;
-	int16_t y;
-	int16_t cosphi;
-	int16_t sinphi;
-	int8_t  phi;
-	int16_t height;
-	int16_t fromHeight;
-	int16_t legDist;
-};
-
 static struct waypointparameters navgoal;
 static int16_t desired_bearing_over_ground_vector[2];
 
@@ -122,6 +114,7 @@ void dcm_callback_gps_location_updated(void)
 		// extend this code.
 		state_flags._.save_origin = 0;
 		setup_origin();
+		flightplan_origin_changed();
 #if (USE_BAROMETER_ALTITUDE == 1)
 		altimeter_calibrate();
 #endif
@@ -136,14 +129,45 @@ void dcm_callback_gps_location_updated(void)
 // the interrupt handler will simply skip some of the navigation passes.
 }
 
+#if (USE_NV_MEMORY == 1)
+static boolean mag_calib_save_pending = false;
+#endif
+
+void dcm_callback_mag_calibrated(void)
+{
+#if (USE_NV_MEMORY == 1)
+	// if data services are busy the save is retried by navigate_save_pending_40hz
+	mag_calib_save_pending = true;
+	navigate_save_pending_40hz();
+#endif
+}
+
+// Called at 40Hz
+void navigate_save_pending_40hz(void)
+{
+#if (USE_NV_MEMORY == 1)
+	if (mag_calib_save_pending)
+	{
+		if (data_services_save_specific(STORAGE_HANDLE_MAG_CALIB, NULL))
+		{
+			mag_calib_save_pending = false;
+		}
+	}
+#endif
+}
+
+// Compute the goal parameters for the leg from fromPoint to toPoint,
+// without making it the current goal.
+// Returns 1 if the leg had to be shortened to fit the extended range.
 #ifdef USE_EXTENDED_NAV
-void navigate_set_goal(struct relative3D_32 fromPoint, struct relative3D_32 toPoint)
+int8_t navigate_compute_goal(struct relative3D_32 fromPoint, struct relative3D_32 toPoint, struct waypointparameters* goal)
 #else
-void navigate_set_goal(struct relative3D fromPoint, struct relative3D toPoint)
+int8_t navigate_compute_goal(struct relative3D fromPoint, struct relative3D toPoint, struct waypointparameters* goal)
 #endif // USE_EXTENDED_NAV
 {
 	struct relative2D courseLeg;
 	int16_t courseDirection[2];
+	int8_t extended = 0;
 
 #ifdef USE_EXTENDED_NAV
 	union longww from_to_x;
@@ -179,18 +203,14 @@ void navigate_set_goal(struct relative3D fromPoint, struct relative3D toPoint)
 		toPoint.y = fromPoint.y + from_to_y.WW;
 		toPoint.z = fromPoint.z + from_to_z;
 
-		extended_range = 1;
-	}
-	else
-	{
-		extended_range = 0;
+		extended = 1;
 	}
 #endif // USE_EXTENDED_NAV
 
-	navgoal.x = toPoint.x;
-	navgoal.y = toPoint.y;
-	navgoal.height = toPoint.z;
-	navgoal.fromHeight = fromPoint.z;
+	goal->x = toPoint.x;
+	goal->y = toPoint.y;
+	goal->height = toPoint.z;
+	goal->fromHeight = fromPoint.z;
 
 	courseLeg.x = toPoint.x - fromPoint.x;
 	courseLeg.y = toPoint.y - fromPoint.y;
@@ -203,8 +223,8 @@ void navigate_set_goal(struct relative3D fromPoint, struct relative3D toPoint)
 //  an angle, and also the leg distance is required.
 //  But leg distance is produced as a by product of vector2_normalize.
 //  TODO: revise the following two lines.
-	navgoal.phi = rect_to_polar(&courseLeg); // binary angle (0 - 256 = 360 degrees)
-	navgoal.legDist = courseLeg.x;
+	goal->phi = rect_to_polar(&courseLeg); // binary angle (0 - 256 = 360 degrees)
+	goal->legDist = courseLeg.x;
 
 //struct waypointparameters { int16_t x; int16_t y; int16_t cosphi; int16_t sinphi; int8_t phi; int16_t height; int16_t fromHeight; int16_t legDist; };
 //extern struct waypointparameters navgoal;
@@ -212,8 +232,25 @@ void navigate_set_goal(struct relative3D fromPoint, struct relative3D toPoint)
 
 //  New method for computing cosine and sine of course direction
 	vector2_normalize(&courseDirection[0], &courseDirection[0]);
-	navgoal.cosphi = courseDirection[0];
-	navgoal.sinphi = courseDirection[1];
+	goal->cosphi = courseDirection[0];
+	goal->sinphi = courseDirection[1];
+	return extended;
+}
+
+// Make a previously computed leg the current goal
+void navigate_set_goal_params(const struct waypointparameters* goal, int8_t extended)
+{
+	navgoal = *goal;
+	extended_range = extended;
+}
+
+#ifdef USE_EXTENDED_NAV
+void navigate_set_goal(struct relative3D_32 fromPoint, struct relative3D_32 toPoint)
+#else
+void navigate_set_goal(struct relative3D fromPoint, struct relative3D toPoint)
+#endif // USE_EXTENDED_NAV
+{
+	extended_range = navigate_compute_goal(fromPoint, toPoint, &navgoal);
 }
 
 void navigate_set_goal_height(int16_t z)
@@ -275,42 +312,41 @@ int16_t navigate_desired_height(void)
 	return height;
 }
 
-static void cross_track(void)
+// Using Cross Tracking
+// CROSS_TRACK_MARGIN is the value of cross track error in meters
+// beyond which cross tracking correction saturates at 45 degrees
+#if (CROSS_TRACK_MARGIN >= 1024)
+#error ("CTMARGIN is too large, it must be less than 1024")
+#endif
+
+// CROSS_TRACK_LOOKAHEAD_TIME, in seconds, lengthens the cross track margin
+// to the distance flown along the leg in that time, when that is longer.
+// The aircraft then steers toward a point that far ahead on the track.
+#ifndef CROSS_TRACK_LOOKAHEAD_TIME
+#define CROSS_TRACK_LOOKAHEAD_TIME          0
+#endif
+
+#define CROSS_TRACK_LOOKAHEAD_MAX           2047    // meters, 16 times this must fit in an int16_t
+
+static void cross_track(int32_t crosstrack, int16_t along_speed)
 {
-// INPUTS: navgoal, IMUlocation, IMUintegralAcceleration
+// INPUTS: navgoal, crosstrack error and speed along the leg
 // OUTPUT: desired_bearing_over_ground_vector
 //
+	union longww crossVector;
+	int16_t cross_rotate[2];
+	int16_t lookahead = CROSS_TRACK_MARGIN;
 
-//struct ww   { int16_t W0; int16_t W1; };
-//union longww     { int32_t WW;  struct ww _; };
-
-	// Using Cross Tracking
-	// CROSS_TRACK_MARGIN is the value of cross track error in meters
-	// beyond which cross tracking correction saturates at 45 degrees 
-#if (CROSS_TRACK_MARGIN >= 1024)
-#error ("CTMARGIN is too large, it must be less than 1024")
+#if (CROSS_TRACK_LOOKAHEAD_TIME > 0)
+	// along_speed is in centimeters per second
+	int32_t distance = __builtin_mulss(along_speed, CROSS_TRACK_LOOKAHEAD_TIME) / 100;
+	if (distance > lookahead)
+	{
+		lookahead = (distance < CROSS_TRACK_LOOKAHEAD_MAX) ? distance : CROSS_TRACK_LOOKAHEAD_MAX;
+	}
+#else
+	(void)along_speed;
 #endif
-	union longww crossVector[2];
-	int16_t cross_rotate[2];
-	int16_t crosstrack;
-
-	// cross_rotate is a vector parallel to the desired course track
-	cross_rotate[0] =  navgoal.cosphi;
-	cross_rotate[1] = -navgoal.sinphi;
-
-	// cross_vector is a weighted sum of cross track distance error and cross velocity.
-	// IMU velocity is in centimeters per second, so right shifting by 4 produces
-	// about 6 times the IMU velocity in meters per second.
-	// This sets the time constant of the exponential decay to about 6 seconds
-	crossVector[0]._.W1 = navgoal.x;
-	crossVector[1]._.W1 = navgoal.y;
-	crossVector[0].WW -= IMUlocationx.WW + ((IMUintegralAccelerationx.WW) >> 4);
-	crossVector[1].WW -= IMUlocationy.WW + ((IMUintegralAccelerationy.WW) >> 4);
-
-	// The following rotation transforms the cross track error vector into the
-	// frame of the desired course track
-	rotate_2D_long_vector_by_vector(&crossVector[0].WW, cross_rotate);
-	crosstrack = crossVector[1]._.W1;
 
 	// Compute the adjusted desired bearing over ground.
 	// Start with the straight line between waypoints.
@@ -318,21 +354,22 @@ static void cross_track(void)
 	desired_bearing_over_ground_vector[1] = navgoal.sinphi;
 
 	// Determine if the crosstrack error is within saturation limit.
-	// If so, then multiply by 64 to pick up an extra 6 bits of resolution.
-	if (abs(crosstrack) < ((uint16_t)(CROSS_TRACK_MARGIN)))
+	// If so, then multiply by 16 to pick up an extra 4 bits of resolution.
+	crossVector.WW = crosstrack;
+	if (abs(crossVector._.W1) < lookahead)
 	{
-		crossVector[1].WW <<= 6;
-		cross_rotate[1] = crossVector[1]._.W1;
-		cross_rotate[0] = 64*((uint16_t)(CROSS_TRACK_MARGIN));
+		crossVector.WW <<= 4;
+		cross_rotate[1] = crossVector._.W1;
+		cross_rotate[0] = 16 * lookahead;
 		vector2_normalize(cross_rotate, cross_rotate);
 		// At this point, the implicit angle of the cross correction rotation
-		// is atan of (the cross error divided by the cross margin).
+		// is atan of (the cross error divided by the lookahead distance).
 		// Rotate the base course by the cross correction
 		rotate_2D_vector_by_vector(desired_bearing_over_ground_vector, cross_rotate);
 	}
 	else
 	{
-		if (crosstrack > 0)
+		if (crossVector._.W1 > 0)
 		{
 			rotate_2D_vector_by_angle(desired_bearing_over_ground_vector, (int8_t) (32));
 		}
@@ -343,41 +380,64 @@ static void cross_track(void)
 	}
 }
 
+// With dead reckoning this runs at 40Hz on the dead reckoned position,
+// otherwise on each GPS fix.
 void navigate_compute_bearing_to_goal(void)
 {
-	struct relative2D togoal;
+	union longww togoal[2];
 	union longww temporary;
+	int16_t togoal_direct[2];
+	int16_t leg_rotate[2];
+	int16_t along_speed;
+	int16_t cross_speed;
 
-	// compute the goal vector from present position to waypoint target in meters:
+	// compute the goal vector from present position to waypoint target,
+	// in meters with a 16 bit fraction:
 #if (DEADRECKONING == 1)
-	togoal.x = navgoal.x - IMUlocationx._.W1;
-	togoal.y = navgoal.y - IMUlocationy._.W1;
+	togoal[0].WW = ((int32_t)navgoal.x << 16) - IMUlocationx.WW;
+	togoal[1].WW = ((int32_t)navgoal.y << 16) - IMUlocationy.WW;
 #else
-	togoal.x = navgoal.x - GPSlocation.x;
-	togoal.y = navgoal.y - GPSlocation.y;
+	togoal[0].WW = (int32_t)(navgoal.x - GPSlocation.x) << 16;
+	togoal[1].WW = (int32_t)(navgoal.y - GPSlocation.y) << 16;
 #endif
-
-	// project the goal vector onto the direction vector between waypoints
-	// to get the distance to the "finish" line:
-	temporary.WW = (__builtin_mulss(togoal.x, navgoal.cosphi)
-	              + __builtin_mulss(togoal.y, navgoal.sinphi))<<2;
-	tofinish_line = temporary._.W1;
+	togoal_direct[0] = togoal[0]._.W1;
+	togoal_direct[1] = togoal[1]._.W1;
+
+	// Rotate the goal vector into the frame of the leg, given by the unit
+	// vector between waypoints computed when the goal was set.
+	// The first component is the distance to the "finish" line, the second
+	// is the cross track error.
+	leg_rotate[0] =  navgoal.cosphi;
+	leg_rotate[1] = -navgoal.sinphi;
+	rotate_2D_long_vector_by_vector(&togoal[0].WW, leg_rotate);
+	tofinish_line = togoal[0]._.W1;
+
+	// The same rotation of the IMU velocity, in centimeters per second.
+	temporary.WW = (__builtin_mulss(IMUintegralAccelerationx._.W1, navgoal.cosphi)
+	              + __builtin_mulss(IMUintegralAccelerationy._.W1, navgoal.sinphi)) << 2;
+	along_speed = temporary._.W1;
+	temporary.WW = (__builtin_mulss(IMUintegralAccelerationy._.W1, navgoal.cosphi)
+	              - __builtin_mulss(IMUintegralAccelerationx._.W1, navgoal.sinphi)) << 2;
+	cross_speed = temporary._.W1;
 
 	// Determine if aircraft is making forward progress.
 	// If not, do not apply cross track correction.
 	// This is done to prevent "waggles" during a 180 degree turn.
-	temporary.WW = (__builtin_mulss(IMUintegralAccelerationx._.W1, navgoal.cosphi)
-	              + __builtin_mulss(IMUintegralAccelerationy._.W1, navgoal.sinphi));
-	if ((desired_behavior._.cross_track) && (temporary._.W1 > 0))
+	if ((desired_behavior._.cross_track) && (along_speed > 0))
 	{
-		cross_track();
+		// The cross track error is a weighted sum of cross track distance
+		// error and cross velocity. Shifting the velocity in centimeters per
+		// second by 12 into the 16 bit fraction gives about 6 times the
+		// velocity in meters per second, which sets the time constant of the
+		// exponential decay to about 6 seconds.
+		cross_track(togoal[1].WW - ((int32_t)cross_speed << 12), along_speed);
 	}
 	else
 	{
 			// If not using Cross Tracking
 			// the desired bearing unit vector is simply the normalized to goal vector
-			desired_bearing_over_ground_vector[0] = togoal.x;
-			desired_bearing_over_ground_vector[1] = togoal.y;
+			desired_bearing_over_ground_vector[0] = togoal_direct[0];
+			desired_bearing_over_ground_vector[1] = togoal_direct[1];
 			vector2_normalize(desired_bearing_over_ground_vector, desired_bearing_over_ground_vector);
 	}
 	if (state_flags._.GPS_steering)   // return to home or waypoints state
@@ -28,18 +28,33 @@ extern int8_t desired_dir;
 extern uint16_t turngainfbw; // fly by wire turn gain
 extern uint16_t turngainnav; // waypoints turn gain
 
+struct waypointparameters {
+	int16_t x;
+	int16_t y;
+	int16_t cosphi;
+	int16_t sinphi;
+	int8_t  phi;
+	int16_t height;
+	int16_t fromHeight;
+	int16_t legDist;
+};
+
 void init_navigation(void);
 void save_navigation(void);
 #ifdef USE_EXTENDED_NAV
 void navigate_set_goal(struct relative3D_32 fromPoint, struct relative3D_32 toPoint);
+int8_t navigate_compute_goal(struct relative3D_32 fromPoint, struct relative3D_32 toPoint, struct waypointparameters* goal);
 #else
 void navigate_set_goal(struct relative3D fromPoint , struct relative3D toPoint);
+int8_t navigate_compute_goal(struct relative3D fromPoint, struct relative3D toPoint, struct waypointparameters* goal);
 #endif // USE_EXTENDED_NAV
+void navigate_set_goal_params(const struct waypointparameters* goal, int8_t extended);
 void navigate_set_goal_height(int16_t z);
 void navigate_compute_bearing_to_goal(void);
 void navigate_process_flightplan(void);
 int16_t navigate_determine_deflection(char navType);
 int16_t navigate_desired_height(void);
+void navigate_save_pending_40hz(void);
 
 // NEW STUFF:
 int16_t navigate_get_goal(vect3_16t* goal);
@@ -14,6 +14,7 @@ const mavlink_parameter_block mavlink_parameter_blocks[] = {
 	{ STORAGE_HANDLE_THROTTLE_HEIGHT_OPTIONS, 43, 9, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT, NULL },
 	{ STORAGE_HANDLE_AIRSPEED_OPTIONS, 52, 10, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT, NULL },
 	{ STORAGE_HANDLE_TURNS_OPTIONS, 62, 8, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT, NULL },
+	{ STORAGE_HANDLE_MIXER, 70, 108, STORAGE_FLAG_LOAD_AT_STARTUP | STORAGE_FLAG_LOAD_AT_REBOOT, NULL },
 };
 
 
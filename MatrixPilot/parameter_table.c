@@ -12,6 +12,7 @@
 #include "altitudeCntrl.h"
 #include "airspeedCntrl.h"
 #include "config.h"
+#include "servoMix.h"
 
 #include "gain_variables.h"
 
@@ -111,6 +112,115 @@ const mavlink_parameter mavlink_parameters_list[] = {
 	{"TURN_RATE_NAV", {.param_float=0.0}, {.param_float=100.0}, UDB_TYPE_FLOAT, PARAMETER_READWRITE, (void*)&turns.TurnRateNav, sizeof(turns.TurnRateNav) },
 	{"TURN_RATE_FBW", {.param_float=0.0}, {.param_float=100.0}, UDB_TYPE_FLOAT, PARAMETER_READWRITE, (void*)&turns.TurnRateFBW, sizeof(turns.TurnRateFBW) },
 
+	{"MIX_AIL_OUT", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].output, sizeof(servo_mix[MIX_ROW_AILERON].output) },
+	{"MIX_AIL_IN", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].input, sizeof(servo_mix[MIX_ROW_AILERON].input) },
+	{"MIX_AIL_CROSS", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].cross, sizeof(servo_mix[MIX_ROW_AILERON].cross) },
+	{"MIX_AIL_MAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_AILERON].manual[MIX_STICK_INPUT]) },
+	{"MIX_AIL_STAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_AILERON].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_AIL_XMAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_AILERON].manual[MIX_STICK_CROSS]) },
+	{"MIX_AIL_XSTAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_AILERON].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_AIL_ROLL", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_AILERON].control[MIX_ROLL]) },
+	{"MIX_AIL_PITCH", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_AILERON].control[MIX_PITCH]) },
+	{"MIX_AIL_YAW", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_AILERON].control[MIX_YAW]) },
+	{"MIX_AIL_THROT", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_AILERON].control[MIX_THROTTLE]) },
+	{"MIX_AIL_WAGGLE", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_AILERON].control[MIX_WAGGLE]) },
+	{"MIX_AIL2_OUT", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].output, sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].output) },
+	{"MIX_AIL2_IN", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].input, sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].input) },
+	{"MIX_AIL2_CROSS", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].cross, sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].cross) },
+	{"MIX_AIL2_MAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].manual[MIX_STICK_INPUT]) },
+	{"MIX_AIL2_STAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_AIL2_XMAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].manual[MIX_STICK_CROSS]) },
+	{"MIX_AIL2_XSTAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_AIL2_ROLL", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_ROLL]) },
+	{"MIX_AIL2_PITCH", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_PITCH]) },
+	{"MIX_AIL2_YAW", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_YAW]) },
+	{"MIX_AIL2_THROT", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_THROTTLE]) },
+	{"MIX_AIL2_WAGGLE", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_WAGGLE]) },
+	{"MIX_ELE_OUT", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].output, sizeof(servo_mix[MIX_ROW_ELEVATOR].output) },
+	{"MIX_ELE_IN", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].input, sizeof(servo_mix[MIX_ROW_ELEVATOR].input) },
+	{"MIX_ELE_CROSS", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].cross, sizeof(servo_mix[MIX_ROW_ELEVATOR].cross) },
+	{"MIX_ELE_MAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_ELEVATOR].manual[MIX_STICK_INPUT]) },
+	{"MIX_ELE_STAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_ELEVATOR].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_ELE_XMAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_ELEVATOR].manual[MIX_STICK_CROSS]) },
+	{"MIX_ELE_XSTAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_ELEVATOR].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_ELE_ROLL", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_ELEVATOR].control[MIX_ROLL]) },
+	{"MIX_ELE_PITCH", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_ELEVATOR].control[MIX_PITCH]) },
+	{"MIX_ELE_YAW", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_ELEVATOR].control[MIX_YAW]) },
+	{"MIX_ELE_THROT", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_ELEVATOR].control[MIX_THROTTLE]) },
+	{"MIX_ELE_WAGGLE", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_ELEVATOR].control[MIX_WAGGLE]) },
+	{"MIX_RUD_OUT", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].output, sizeof(servo_mix[MIX_ROW_RUDDER].output) },
+	{"MIX_RUD_IN", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].input, sizeof(servo_mix[MIX_ROW_RUDDER].input) },
+	{"MIX_RUD_CROSS", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].cross, sizeof(servo_mix[MIX_ROW_RUDDER].cross) },
+	{"MIX_RUD_MAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_RUDDER].manual[MIX_STICK_INPUT]) },
+	{"MIX_RUD_STAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_RUDDER].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_RUD_XMAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_RUDDER].manual[MIX_STICK_CROSS]) },
+	{"MIX_RUD_XSTAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_RUDDER].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_RUD_ROLL", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_RUDDER].control[MIX_ROLL]) },
+	{"MIX_RUD_PITCH", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_RUDDER].control[MIX_PITCH]) },
+	{"MIX_RUD_YAW", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_RUDDER].control[MIX_YAW]) },
+	{"MIX_RUD_THROT", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_RUDDER].control[MIX_THROTTLE]) },
+	{"MIX_RUD_WAGGLE", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_RUDDER].control[MIX_WAGGLE]) },
+	{"MIX_THR_OUT", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].output, sizeof(servo_mix[MIX_ROW_THROTTLE].output) },
+	{"MIX_THR_IN", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].input, sizeof(servo_mix[MIX_ROW_THROTTLE].input) },
+	{"MIX_THR_CROSS", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].cross, sizeof(servo_mix[MIX_ROW_THROTTLE].cross) },
+	{"MIX_THR_MAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_THROTTLE].manual[MIX_STICK_INPUT]) },
+	{"MIX_THR_STAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_THROTTLE].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_THR_XMAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_THROTTLE].manual[MIX_STICK_CROSS]) },
+	{"MIX_THR_XSTAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_THROTTLE].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_THR_ROLL", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_THROTTLE].control[MIX_ROLL]) },
+	{"MIX_THR_PITCH", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_THROTTLE].control[MIX_PITCH]) },
+	{"MIX_THR_YAW", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_THROTTLE].control[MIX_YAW]) },
+	{"MIX_THR_THROT", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_THROTTLE].control[MIX_THROTTLE]) },
+	{"MIX_THR_WAGGLE", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_THROTTLE].control[MIX_WAGGLE]) },
+	{"MIX_PTA_OUT", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].output, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].output) },
+	{"MIX_PTA_IN", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].input, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].input) },
+	{"MIX_PTA_CROSS", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].cross, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].cross) },
+	{"MIX_PTA_MAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].manual[MIX_STICK_INPUT]) },
+	{"MIX_PTA_STAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_PTA_XMAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].manual[MIX_STICK_CROSS]) },
+	{"MIX_PTA_XSTAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_PTA_ROLL", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_ROLL]) },
+	{"MIX_PTA_PITCH", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_PITCH]) },
+	{"MIX_PTA_YAW", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_YAW]) },
+	{"MIX_PTA_THROT", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_THROTTLE]) },
+	{"MIX_PTA_WAGGLE", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_WAGGLE]) },
+	{"MIX_PTB_OUT", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].output, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].output) },
+	{"MIX_PTB_IN", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].input, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].input) },
+	{"MIX_PTB_CROSS", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].cross, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].cross) },
+	{"MIX_PTB_MAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].manual[MIX_STICK_INPUT]) },
+	{"MIX_PTB_STAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_PTB_XMAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].manual[MIX_STICK_CROSS]) },
+	{"MIX_PTB_XSTAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_PTB_ROLL", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_ROLL]) },
+	{"MIX_PTB_PITCH", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_PITCH]) },
+	{"MIX_PTB_YAW", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_YAW]) },
+	{"MIX_PTB_THROT", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_THROTTLE]) },
+	{"MIX_PTB_WAGGLE", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_WAGGLE]) },
+	{"MIX_PTC_OUT", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].output, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].output) },
+	{"MIX_PTC_IN", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].input, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].input) },
+	{"MIX_PTC_CROSS", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].cross, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].cross) },
+	{"MIX_PTC_MAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].manual[MIX_STICK_INPUT]) },
+	{"MIX_PTC_STAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_PTC_XMAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].manual[MIX_STICK_CROSS]) },
+	{"MIX_PTC_XSTAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_PTC_ROLL", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_ROLL]) },
+	{"MIX_PTC_PITCH", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_PITCH]) },
+	{"MIX_PTC_YAW", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_YAW]) },
+	{"MIX_PTC_THROT", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_THROTTLE]) },
+	{"MIX_PTC_WAGGLE", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_WAGGLE]) },
+	{"MIX_PTD_OUT", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].output, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].output) },
+	{"MIX_PTD_IN", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].input, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].input) },
+	{"MIX_PTD_CROSS", {.param_int32=0}, {.param_int32=16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].cross, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].cross) },
+	{"MIX_PTD_MAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].manual[MIX_STICK_INPUT]) },
+	{"MIX_PTD_STAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_PTD_XMAN", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].manual[MIX_STICK_CROSS]) },
+	{"MIX_PTD_XSTAB", {.param_int32=-32767}, {.param_int32=32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_PTD_ROLL", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_ROLL]) },
+	{"MIX_PTD_PITCH", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_PITCH]) },
+	{"MIX_PTD_YAW", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_YAW]) },
+	{"MIX_PTD_THROT", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_THROTTLE]) },
+	{"MIX_PTD_WAGGLE", {.param_float=-2.0}, {.param_float=1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_WAGGLE]) },
+
 };
 
 const uint16_t count_of_parameters_list = sizeof(mavlink_parameters_list) / sizeof(mavlink_parameter);
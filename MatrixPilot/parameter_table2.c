@@ -12,6 +12,7 @@
 #include "altitudeCntrl.h"
 #include "airspeedCntrl.h"
 #include "config.h"
+#include "servoMix.h"
 
 #include "gain_variables.h"
 
@@ -111,6 +112,115 @@ const mavlink_parameter mavlink_parameters_list[] = {
 	{"TURN_RATE_NAV", {0.0}, {100.0}, UDB_TYPE_FLOAT, PARAMETER_READWRITE, (void*)&turns.TurnRateNav, sizeof(turns.TurnRateNav) },
 	{"TURN_RATE_FBW", {0.0}, {100.0}, UDB_TYPE_FLOAT, PARAMETER_READWRITE, (void*)&turns.TurnRateFBW, sizeof(turns.TurnRateFBW) },
 
+	{"MIX_AIL_OUT", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].output, sizeof(servo_mix[MIX_ROW_AILERON].output) },
+	{"MIX_AIL_IN", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].input, sizeof(servo_mix[MIX_ROW_AILERON].input) },
+	{"MIX_AIL_CROSS", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].cross, sizeof(servo_mix[MIX_ROW_AILERON].cross) },
+	{"MIX_AIL_MAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_AILERON].manual[MIX_STICK_INPUT]) },
+	{"MIX_AIL_STAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_AILERON].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_AIL_XMAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_AILERON].manual[MIX_STICK_CROSS]) },
+	{"MIX_AIL_XSTAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_AILERON].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_AIL_ROLL", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_AILERON].control[MIX_ROLL]) },
+	{"MIX_AIL_PITCH", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_AILERON].control[MIX_PITCH]) },
+	{"MIX_AIL_YAW", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_AILERON].control[MIX_YAW]) },
+	{"MIX_AIL_THROT", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_AILERON].control[MIX_THROTTLE]) },
+	{"MIX_AIL_WAGGLE", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_AILERON].control[MIX_WAGGLE]) },
+	{"MIX_AIL2_OUT", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].output, sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].output) },
+	{"MIX_AIL2_IN", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].input, sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].input) },
+	{"MIX_AIL2_CROSS", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].cross, sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].cross) },
+	{"MIX_AIL2_MAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].manual[MIX_STICK_INPUT]) },
+	{"MIX_AIL2_STAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_AIL2_XMAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].manual[MIX_STICK_CROSS]) },
+	{"MIX_AIL2_XSTAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_AIL2_ROLL", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_ROLL]) },
+	{"MIX_AIL2_PITCH", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_PITCH]) },
+	{"MIX_AIL2_YAW", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_YAW]) },
+	{"MIX_AIL2_THROT", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_THROTTLE]) },
+	{"MIX_AIL2_WAGGLE", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_WAGGLE]) },
+	{"MIX_ELE_OUT", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].output, sizeof(servo_mix[MIX_ROW_ELEVATOR].output) },
+	{"MIX_ELE_IN", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].input, sizeof(servo_mix[MIX_ROW_ELEVATOR].input) },
+	{"MIX_ELE_CROSS", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].cross, sizeof(servo_mix[MIX_ROW_ELEVATOR].cross) },
+	{"MIX_ELE_MAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_ELEVATOR].manual[MIX_STICK_INPUT]) },
+	{"MIX_ELE_STAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_ELEVATOR].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_ELE_XMAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_ELEVATOR].manual[MIX_STICK_CROSS]) },
+	{"MIX_ELE_XSTAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_ELEVATOR].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_ELE_ROLL", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_ELEVATOR].control[MIX_ROLL]) },
+	{"MIX_ELE_PITCH", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_ELEVATOR].control[MIX_PITCH]) },
+	{"MIX_ELE_YAW", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_ELEVATOR].control[MIX_YAW]) },
+	{"MIX_ELE_THROT", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_ELEVATOR].control[MIX_THROTTLE]) },
+	{"MIX_ELE_WAGGLE", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_ELEVATOR].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_ELEVATOR].control[MIX_WAGGLE]) },
+	{"MIX_RUD_OUT", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].output, sizeof(servo_mix[MIX_ROW_RUDDER].output) },
+	{"MIX_RUD_IN", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].input, sizeof(servo_mix[MIX_ROW_RUDDER].input) },
+	{"MIX_RUD_CROSS", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].cross, sizeof(servo_mix[MIX_ROW_RUDDER].cross) },
+	{"MIX_RUD_MAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_RUDDER].manual[MIX_STICK_INPUT]) },
+	{"MIX_RUD_STAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_RUDDER].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_RUD_XMAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_RUDDER].manual[MIX_STICK_CROSS]) },
+	{"MIX_RUD_XSTAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_RUDDER].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_RUD_ROLL", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_RUDDER].control[MIX_ROLL]) },
+	{"MIX_RUD_PITCH", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_RUDDER].control[MIX_PITCH]) },
+	{"MIX_RUD_YAW", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_RUDDER].control[MIX_YAW]) },
+	{"MIX_RUD_THROT", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_RUDDER].control[MIX_THROTTLE]) },
+	{"MIX_RUD_WAGGLE", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_RUDDER].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_RUDDER].control[MIX_WAGGLE]) },
+	{"MIX_THR_OUT", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].output, sizeof(servo_mix[MIX_ROW_THROTTLE].output) },
+	{"MIX_THR_IN", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].input, sizeof(servo_mix[MIX_ROW_THROTTLE].input) },
+	{"MIX_THR_CROSS", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].cross, sizeof(servo_mix[MIX_ROW_THROTTLE].cross) },
+	{"MIX_THR_MAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_THROTTLE].manual[MIX_STICK_INPUT]) },
+	{"MIX_THR_STAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_THROTTLE].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_THR_XMAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_THROTTLE].manual[MIX_STICK_CROSS]) },
+	{"MIX_THR_XSTAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_THROTTLE].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_THR_ROLL", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_THROTTLE].control[MIX_ROLL]) },
+	{"MIX_THR_PITCH", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_THROTTLE].control[MIX_PITCH]) },
+	{"MIX_THR_YAW", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_THROTTLE].control[MIX_YAW]) },
+	{"MIX_THR_THROT", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_THROTTLE].control[MIX_THROTTLE]) },
+	{"MIX_THR_WAGGLE", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_THROTTLE].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_THROTTLE].control[MIX_WAGGLE]) },
+	{"MIX_PTA_OUT", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].output, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].output) },
+	{"MIX_PTA_IN", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].input, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].input) },
+	{"MIX_PTA_CROSS", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].cross, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].cross) },
+	{"MIX_PTA_MAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].manual[MIX_STICK_INPUT]) },
+	{"MIX_PTA_STAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_PTA_XMAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].manual[MIX_STICK_CROSS]) },
+	{"MIX_PTA_XSTAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_PTA_ROLL", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_ROLL]) },
+	{"MIX_PTA_PITCH", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_PITCH]) },
+	{"MIX_PTA_YAW", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_YAW]) },
+	{"MIX_PTA_THROT", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_THROTTLE]) },
+	{"MIX_PTA_WAGGLE", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_WAGGLE]) },
+	{"MIX_PTB_OUT", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].output, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].output) },
+	{"MIX_PTB_IN", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].input, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].input) },
+	{"MIX_PTB_CROSS", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].cross, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].cross) },
+	{"MIX_PTB_MAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].manual[MIX_STICK_INPUT]) },
+	{"MIX_PTB_STAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_PTB_XMAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].manual[MIX_STICK_CROSS]) },
+	{"MIX_PTB_XSTAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_PTB_ROLL", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_ROLL]) },
+	{"MIX_PTB_PITCH", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_PITCH]) },
+	{"MIX_PTB_YAW", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_YAW]) },
+	{"MIX_PTB_THROT", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_THROTTLE]) },
+	{"MIX_PTB_WAGGLE", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_WAGGLE]) },
+	{"MIX_PTC_OUT", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].output, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].output) },
+	{"MIX_PTC_IN", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].input, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].input) },
+	{"MIX_PTC_CROSS", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].cross, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].cross) },
+	{"MIX_PTC_MAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].manual[MIX_STICK_INPUT]) },
+	{"MIX_PTC_STAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_PTC_XMAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].manual[MIX_STICK_CROSS]) },
+	{"MIX_PTC_XSTAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_PTC_ROLL", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_ROLL]) },
+	{"MIX_PTC_PITCH", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_PITCH]) },
+	{"MIX_PTC_YAW", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_YAW]) },
+	{"MIX_PTC_THROT", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_THROTTLE]) },
+	{"MIX_PTC_WAGGLE", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_WAGGLE]) },
+	{"MIX_PTD_OUT", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].output, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].output) },
+	{"MIX_PTD_IN", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].input, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].input) },
+	{"MIX_PTD_CROSS", {0}, {16}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].cross, sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].cross) },
+	{"MIX_PTD_MAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].manual[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].manual[MIX_STICK_INPUT]) },
+	{"MIX_PTD_STAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].stabilized[MIX_STICK_INPUT], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].stabilized[MIX_STICK_INPUT]) },
+	{"MIX_PTD_XMAN", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].manual[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].manual[MIX_STICK_CROSS]) },
+	{"MIX_PTD_XSTAB", {-32767}, {32767}, UDB_TYPE_INT, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].stabilized[MIX_STICK_CROSS], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].stabilized[MIX_STICK_CROSS]) },
+	{"MIX_PTD_ROLL", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_ROLL], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_ROLL]) },
+	{"MIX_PTD_PITCH", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_PITCH], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_PITCH]) },
+	{"MIX_PTD_YAW", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_YAW], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_YAW]) },
+	{"MIX_PTD_THROT", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_THROTTLE], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_THROTTLE]) },
+	{"MIX_PTD_WAGGLE", {-2.0}, {1.99}, UDB_TYPE_Q14, PARAMETER_READWRITE, (void*)&servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_WAGGLE], sizeof(servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_WAGGLE]) },
+
 };
 
 const uint16_t count_of_parameters_list = sizeof(mavlink_parameters_list) / sizeof(mavlink_parameter);
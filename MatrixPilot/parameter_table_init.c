@@ -91,6 +91,115 @@ void parameter_table_init(void)
 	mavlink_parameters_list[68].min.param_float=0.0; mavlink_parameters_list[68].max.param_float=100.0; // turns.TurnRateNav - TURN_RATE_NAV
 	mavlink_parameters_list[69].min.param_float=0.0; mavlink_parameters_list[69].max.param_float=100.0; // turns.TurnRateFBW - TURN_RATE_FBW
 
+	mavlink_parameters_list[70].min.param_int32=0; mavlink_parameters_list[70].max.param_int32=16; // servo_mix[MIX_ROW_AILERON].output - MIX_AIL_OUT
+	mavlink_parameters_list[71].min.param_int32=0; mavlink_parameters_list[71].max.param_int32=16; // servo_mix[MIX_ROW_AILERON].input - MIX_AIL_IN
+	mavlink_parameters_list[72].min.param_int32=0; mavlink_parameters_list[72].max.param_int32=16; // servo_mix[MIX_ROW_AILERON].cross - MIX_AIL_CROSS
+	mavlink_parameters_list[73].min.param_int32=-32767; mavlink_parameters_list[73].max.param_int32=32767; // servo_mix[MIX_ROW_AILERON].manual[MIX_STICK_INPUT] - MIX_AIL_MAN
+	mavlink_parameters_list[74].min.param_int32=-32767; mavlink_parameters_list[74].max.param_int32=32767; // servo_mix[MIX_ROW_AILERON].stabilized[MIX_STICK_INPUT] - MIX_AIL_STAB
+	mavlink_parameters_list[75].min.param_int32=-32767; mavlink_parameters_list[75].max.param_int32=32767; // servo_mix[MIX_ROW_AILERON].manual[MIX_STICK_CROSS] - MIX_AIL_XMAN
+	mavlink_parameters_list[76].min.param_int32=-32767; mavlink_parameters_list[76].max.param_int32=32767; // servo_mix[MIX_ROW_AILERON].stabilized[MIX_STICK_CROSS] - MIX_AIL_XSTAB
+	mavlink_parameters_list[77].min.param_float=-2.0; mavlink_parameters_list[77].max.param_float=1.99; // servo_mix[MIX_ROW_AILERON].control[MIX_ROLL] - MIX_AIL_ROLL
+	mavlink_parameters_list[78].min.param_float=-2.0; mavlink_parameters_list[78].max.param_float=1.99; // servo_mix[MIX_ROW_AILERON].control[MIX_PITCH] - MIX_AIL_PITCH
+	mavlink_parameters_list[79].min.param_float=-2.0; mavlink_parameters_list[79].max.param_float=1.99; // servo_mix[MIX_ROW_AILERON].control[MIX_YAW] - MIX_AIL_YAW
+	mavlink_parameters_list[80].min.param_float=-2.0; mavlink_parameters_list[80].max.param_float=1.99; // servo_mix[MIX_ROW_AILERON].control[MIX_THROTTLE] - MIX_AIL_THROT
+	mavlink_parameters_list[81].min.param_float=-2.0; mavlink_parameters_list[81].max.param_float=1.99; // servo_mix[MIX_ROW_AILERON].control[MIX_WAGGLE] - MIX_AIL_WAGGLE
+	mavlink_parameters_list[82].min.param_int32=0; mavlink_parameters_list[82].max.param_int32=16; // servo_mix[MIX_ROW_AILERON_SECONDARY].output - MIX_AIL2_OUT
+	mavlink_parameters_list[83].min.param_int32=0; mavlink_parameters_list[83].max.param_int32=16; // servo_mix[MIX_ROW_AILERON_SECONDARY].input - MIX_AIL2_IN
+	mavlink_parameters_list[84].min.param_int32=0; mavlink_parameters_list[84].max.param_int32=16; // servo_mix[MIX_ROW_AILERON_SECONDARY].cross - MIX_AIL2_CROSS
+	mavlink_parameters_list[85].min.param_int32=-32767; mavlink_parameters_list[85].max.param_int32=32767; // servo_mix[MIX_ROW_AILERON_SECONDARY].manual[MIX_STICK_INPUT] - MIX_AIL2_MAN
+	mavlink_parameters_list[86].min.param_int32=-32767; mavlink_parameters_list[86].max.param_int32=32767; // servo_mix[MIX_ROW_AILERON_SECONDARY].stabilized[MIX_STICK_INPUT] - MIX_AIL2_STAB
+	mavlink_parameters_list[87].min.param_int32=-32767; mavlink_parameters_list[87].max.param_int32=32767; // servo_mix[MIX_ROW_AILERON_SECONDARY].manual[MIX_STICK_CROSS] - MIX_AIL2_XMAN
+	mavlink_parameters_list[88].min.param_int32=-32767; mavlink_parameters_list[88].max.param_int32=32767; // servo_mix[MIX_ROW_AILERON_SECONDARY].stabilized[MIX_STICK_CROSS] - MIX_AIL2_XSTAB
+	mavlink_parameters_list[89].min.param_float=-2.0; mavlink_parameters_list[89].max.param_float=1.99; // servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_ROLL] - MIX_AIL2_ROLL
+	mavlink_parameters_list[90].min.param_float=-2.0; mavlink_parameters_list[90].max.param_float=1.99; // servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_PITCH] - MIX_AIL2_PITCH
+	mavlink_parameters_list[91].min.param_float=-2.0; mavlink_parameters_list[91].max.param_float=1.99; // servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_YAW] - MIX_AIL2_YAW
+	mavlink_parameters_list[92].min.param_float=-2.0; mavlink_parameters_list[92].max.param_float=1.99; // servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_THROTTLE] - MIX_AIL2_THROT
+	mavlink_parameters_list[93].min.param_float=-2.0; mavlink_parameters_list[93].max.param_float=1.99; // servo_mix[MIX_ROW_AILERON_SECONDARY].control[MIX_WAGGLE] - MIX_AIL2_WAGGLE
+	mavlink_parameters_list[94].min.param_int32=0; mavlink_parameters_list[94].max.param_int32=16; // servo_mix[MIX_ROW_ELEVATOR].output - MIX_ELE_OUT
+	mavlink_parameters_list[95].min.param_int32=0; mavlink_parameters_list[95].max.param_int32=16; // servo_mix[MIX_ROW_ELEVATOR].input - MIX_ELE_IN
+	mavlink_parameters_list[96].min.param_int32=0; mavlink_parameters_list[96].max.param_int32=16; // servo_mix[MIX_ROW_ELEVATOR].cross - MIX_ELE_CROSS
+	mavlink_parameters_list[97].min.param_int32=-32767; mavlink_parameters_list[97].max.param_int32=32767; // servo_mix[MIX_ROW_ELEVATOR].manual[MIX_STICK_INPUT] - MIX_ELE_MAN
+	mavlink_parameters_list[98].min.param_int32=-32767; mavlink_parameters_list[98].max.param_int32=32767; // servo_mix[MIX_ROW_ELEVATOR].stabilized[MIX_STICK_INPUT] - MIX_ELE_STAB
+	mavlink_parameters_list[99].min.param_int32=-32767; mavlink_parameters_list[99].max.param_int32=32767; // servo_mix[MIX_ROW_ELEVATOR].manual[MIX_STICK_CROSS] - MIX_ELE_XMAN
+	mavlink_parameters_list[100].min.param_int32=-32767; mavlink_parameters_list[100].max.param_int32=32767; // servo_mix[MIX_ROW_ELEVATOR].stabilized[MIX_STICK_CROSS] - MIX_ELE_XSTAB
+	mavlink_parameters_list[101].min.param_float=-2.0; mavlink_parameters_list[101].max.param_float=1.99; // servo_mix[MIX_ROW_ELEVATOR].control[MIX_ROLL] - MIX_ELE_ROLL
+	mavlink_parameters_list[102].min.param_float=-2.0; mavlink_parameters_list[102].max.param_float=1.99; // servo_mix[MIX_ROW_ELEVATOR].control[MIX_PITCH] - MIX_ELE_PITCH
+	mavlink_parameters_list[103].min.param_float=-2.0; mavlink_parameters_list[103].max.param_float=1.99; // servo_mix[MIX_ROW_ELEVATOR].control[MIX_YAW] - MIX_ELE_YAW
+	mavlink_parameters_list[104].min.param_float=-2.0; mavlink_parameters_list[104].max.param_float=1.99; // servo_mix[MIX_ROW_ELEVATOR].control[MIX_THROTTLE] - MIX_ELE_THROT
+	mavlink_parameters_list[105].min.param_float=-2.0; mavlink_parameters_list[105].max.param_float=1.99; // servo_mix[MIX_ROW_ELEVATOR].control[MIX_WAGGLE] - MIX_ELE_WAGGLE
+	mavlink_parameters_list[106].min.param_int32=0; mavlink_parameters_list[106].max.param_int32=16; // servo_mix[MIX_ROW_RUDDER].output - MIX_RUD_OUT
+	mavlink_parameters_list[107].min.param_int32=0; mavlink_parameters_list[107].max.param_int32=16; // servo_mix[MIX_ROW_RUDDER].input - MIX_RUD_IN
+	mavlink_parameters_list[108].min.param_int32=0; mavlink_parameters_list[108].max.param_int32=16; // servo_mix[MIX_ROW_RUDDER].cross - MIX_RUD_CROSS
+	mavlink_parameters_list[109].min.param_int32=-32767; mavlink_parameters_list[109].max.param_int32=32767; // servo_mix[MIX_ROW_RUDDER].manual[MIX_STICK_INPUT] - MIX_RUD_MAN
+	mavlink_parameters_list[110].min.param_int32=-32767; mavlink_parameters_list[110].max.param_int32=32767; // servo_mix[MIX_ROW_RUDDER].stabilized[MIX_STICK_INPUT] - MIX_RUD_STAB
+	mavlink_parameters_list[111].min.param_int32=-32767; mavlink_parameters_list[111].max.param_int32=32767; // servo_mix[MIX_ROW_RUDDER].manual[MIX_STICK_CROSS] - MIX_RUD_XMAN
+	mavlink_parameters_list[112].min.param_int32=-32767; mavlink_parameters_list[112].max.param_int32=32767; // servo_mix[MIX_ROW_RUDDER].stabilized[MIX_STICK_CROSS] - MIX_RUD_XSTAB
+	mavlink_parameters_list[113].min.param_float=-2.0; mavlink_parameters_list[113].max.param_float=1.99; // servo_mix[MIX_ROW_RUDDER].control[MIX_ROLL] - MIX_RUD_ROLL
+	mavlink_parameters_list[114].min.param_float=-2.0; mavlink_parameters_list[114].max.param_float=1.99; // servo_mix[MIX_ROW_RUDDER].control[MIX_PITCH] - MIX_RUD_PITCH
+	mavlink_parameters_list[115].min.param_float=-2.0; mavlink_parameters_list[115].max.param_float=1.99; // servo_mix[MIX_ROW_RUDDER].control[MIX_YAW] - MIX_RUD_YAW
+	mavlink_parameters_list[116].min.param_float=-2.0; mavlink_parameters_list[116].max.param_float=1.99; // servo_mix[MIX_ROW_RUDDER].control[MIX_THROTTLE] - MIX_RUD_THROT
+	mavlink_parameters_list[117].min.param_float=-2.0; mavlink_parameters_list[117].max.param_float=1.99; // servo_mix[MIX_ROW_RUDDER].control[MIX_WAGGLE] - MIX_RUD_WAGGLE
+	mavlink_parameters_list[118].min.param_int32=0; mavlink_parameters_list[118].max.param_int32=16; // servo_mix[MIX_ROW_THROTTLE].output - MIX_THR_OUT
+	mavlink_parameters_list[119].min.param_int32=0; mavlink_parameters_list[119].max.param_int32=16; // servo_mix[MIX_ROW_THROTTLE].input - MIX_THR_IN
+	mavlink_parameters_list[120].min.param_int32=0; mavlink_parameters_list[120].max.param_int32=16; // servo_mix[MIX_ROW_THROTTLE].cross - MIX_THR_CROSS
+	mavlink_parameters_list[121].min.param_int32=-32767; mavlink_parameters_list[121].max.param_int32=32767; // servo_mix[MIX_ROW_THROTTLE].manual[MIX_STICK_INPUT] - MIX_THR_MAN
+	mavlink_parameters_list[122].min.param_int32=-32767; mavlink_parameters_list[122].max.param_int32=32767; // servo_mix[MIX_ROW_THROTTLE].stabilized[MIX_STICK_INPUT] - MIX_THR_STAB
+	mavlink_parameters_list[123].min.param_int32=-32767; mavlink_parameters_list[123].max.param_int32=32767; // servo_mix[MIX_ROW_THROTTLE].manual[MIX_STICK_CROSS] - MIX_THR_XMAN
+	mavlink_parameters_list[124].min.param_int32=-32767; mavlink_parameters_list[124].max.param_int32=32767; // servo_mix[MIX_ROW_THROTTLE].stabilized[MIX_STICK_CROSS] - MIX_THR_XSTAB
+	mavlink_parameters_list[125].min.param_float=-2.0; mavlink_parameters_list[125].max.param_float=1.99; // servo_mix[MIX_ROW_THROTTLE].control[MIX_ROLL] - MIX_THR_ROLL
+	mavlink_parameters_list[126].min.param_float=-2.0; mavlink_parameters_list[126].max.param_float=1.99; // servo_mix[MIX_ROW_THROTTLE].control[MIX_PITCH] - MIX_THR_PITCH
+	mavlink_parameters_list[127].min.param_float=-2.0; mavlink_parameters_list[127].max.param_float=1.99; // servo_mix[MIX_ROW_THROTTLE].control[MIX_YAW] - MIX_THR_YAW
+	mavlink_parameters_list[128].min.param_float=-2.0; mavlink_parameters_list[128].max.param_float=1.99; // servo_mix[MIX_ROW_THROTTLE].control[MIX_THROTTLE] - MIX_THR_THROT
+	mavlink_parameters_list[129].min.param_float=-2.0; mavlink_parameters_list[129].max.param_float=1.99; // servo_mix[MIX_ROW_THROTTLE].control[MIX_WAGGLE] - MIX_THR_WAGGLE
+	mavlink_parameters_list[130].min.param_int32=0; mavlink_parameters_list[130].max.param_int32=16; // servo_mix[MIX_ROW_PASSTHROUGH_A].output - MIX_PTA_OUT
+	mavlink_parameters_list[131].min.param_int32=0; mavlink_parameters_list[131].max.param_int32=16; // servo_mix[MIX_ROW_PASSTHROUGH_A].input - MIX_PTA_IN
+	mavlink_parameters_list[132].min.param_int32=0; mavlink_parameters_list[132].max.param_int32=16; // servo_mix[MIX_ROW_PASSTHROUGH_A].cross - MIX_PTA_CROSS
+	mavlink_parameters_list[133].min.param_int32=-32767; mavlink_parameters_list[133].max.param_int32=32767; // servo_mix[MIX_ROW_PASSTHROUGH_A].manual[MIX_STICK_INPUT] - MIX_PTA_MAN
+	mavlink_parameters_list[134].min.param_int32=-32767; mavlink_parameters_list[134].max.param_int32=32767; // servo_mix[MIX_ROW_PASSTHROUGH_A].stabilized[MIX_STICK_INPUT] - MIX_PTA_STAB
+	mavlink_parameters_list[135].min.param_int32=-32767; mavlink_parameters_list[135].max.param_int32=32767; // servo_mix[MIX_ROW_PASSTHROUGH_A].manual[MIX_STICK_CROSS] - MIX_PTA_XMAN
+	mavlink_parameters_list[136].min.param_int32=-32767; mavlink_parameters_list[136].max.param_int32=32767; // servo_mix[MIX_ROW_PASSTHROUGH_A].stabilized[MIX_STICK_CROSS] - MIX_PTA_XSTAB
+	mavlink_parameters_list[137].min.param_float=-2.0; mavlink_parameters_list[137].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_ROLL] - MIX_PTA_ROLL
+	mavlink_parameters_list[138].min.param_float=-2.0; mavlink_parameters_list[138].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_PITCH] - MIX_PTA_PITCH
+	mavlink_parameters_list[139].min.param_float=-2.0; mavlink_parameters_list[139].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_YAW] - MIX_PTA_YAW
+	mavlink_parameters_list[140].min.param_float=-2.0; mavlink_parameters_list[140].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_THROTTLE] - MIX_PTA_THROT
+	mavlink_parameters_list[141].min.param_float=-2.0; mavlink_parameters_list[141].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_A].control[MIX_WAGGLE] - MIX_PTA_WAGGLE
+	mavlink_parameters_list[142].min.param_int32=0; mavlink_parameters_list[142].max.param_int32=16; // servo_mix[MIX_ROW_PASSTHROUGH_B].output - MIX_PTB_OUT
+	mavlink_parameters_list[143].min.param_int32=0; mavlink_parameters_list[143].max.param_int32=16; // servo_mix[MIX_ROW_PASSTHROUGH_B].input - MIX_PTB_IN
+	mavlink_parameters_list[144].min.param_int32=0; mavlink_parameters_list[144].max.param_int32=16; // servo_mix[MIX_ROW_PASSTHROUGH_B].cross - MIX_PTB_CROSS
+	mavlink_parameters_list[145].min.param_int32=-32767; mavlink_parameters_list[145].max.param_int32=32767; // servo_mix[MIX_ROW_PASSTHROUGH_B].manual[MIX_STICK_INPUT] - MIX_PTB_MAN
+	mavlink_parameters_list[146].min.param_int32=-32767; mavlink_parameters_list[146].max.param_int32=32767; // servo_mix[MIX_ROW_PASSTHROUGH_B].stabilized[MIX_STICK_INPUT] - MIX_PTB_STAB
+	mavlink_parameters_list[147].min.param_int32=-32767; mavlink_parameters_list[147].max.param_int32=32767; // servo_mix[MIX_ROW_PASSTHROUGH_B].manual[MIX_STICK_CROSS] - MIX_PTB_XMAN
+	mavlink_parameters_list[148].min.param_int32=-32767; mavlink_parameters_list[148].max.param_int32=32767; // servo_mix[MIX_ROW_PASSTHROUGH_B].stabilized[MIX_STICK_CROSS] - MIX_PTB_XSTAB
+	mavlink_parameters_list[149].min.param_float=-2.0; mavlink_parameters_list[149].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_ROLL] - MIX_PTB_ROLL
+	mavlink_parameters_list[150].min.param_float=-2.0; mavlink_parameters_list[150].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_PITCH] - MIX_PTB_PITCH
+	mavlink_parameters_list[151].min.param_float=-2.0; mavlink_parameters_list[151].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_YAW] - MIX_PTB_YAW
+	mavlink_parameters_list[152].min.param_float=-2.0; mavlink_parameters_list[152].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_THROTTLE] - MIX_PTB_THROT
+	mavlink_parameters_list[153].min.param_float=-2.0; mavlink_parameters_list[153].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_B].control[MIX_WAGGLE] - MIX_PTB_WAGGLE
+	mavlink_parameters_list[154].min.param_int32=0; mavlink_parameters_list[154].max.param_int32=16; // servo_mix[MIX_ROW_PASSTHROUGH_C].output - MIX_PTC_OUT
+	mavlink_parameters_list[155].min.param_int32=0; mavlink_parameters_list[155].max.param_int32=16; // servo_mix[MIX_ROW_PASSTHROUGH_C].input - MIX_PTC_IN
+	mavlink_parameters_list[156].min.param_int32=0; mavlink_parameters_list[156].max.param_int32=16; // servo_mix[MIX_ROW_PASSTHROUGH_C].cross - MIX_PTC_CROSS
+	mavlink_parameters_list[157].min.param_int32=-32767; mavlink_parameters_list[157].max.param_int32=32767; // servo_mix[MIX_ROW_PASSTHROUGH_C].manual[MIX_STICK_INPUT] - MIX_PTC_MAN
+	mavlink_parameters_list[158].min.param_int32=-32767; mavlink_parameters_list[158].max.param_int32=32767; // servo_mix[MIX_ROW_PASSTHROUGH_C].stabilized[MIX_STICK_INPUT] - MIX_PTC_STAB
+	mavlink_parameters_list[159].min.param_int32=-32767; mavlink_parameters_list[159].max.param_int32=32767; // servo_mix[MIX_ROW_PASSTHROUGH_C].manual[MIX_STICK_CROSS] - MIX_PTC_XMAN
+	mavlink_parameters_list[160].min.param_int32=-32767; mavlink_parameters_list[160].max.param_int32=32767; // servo_mix[MIX_ROW_PASSTHROUGH_C].stabilized[MIX_STICK_CROSS] - MIX_PTC_XSTAB
+	mavlink_parameters_list[161].min.param_float=-2.0; mavlink_parameters_list[161].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_ROLL] - MIX_PTC_ROLL
+	mavlink_parameters_list[162].min.param_float=-2.0; mavlink_parameters_list[162].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_PITCH] - MIX_PTC_PITCH
+	mavlink_parameters_list[163].min.param_float=-2.0; mavlink_parameters_list[163].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_YAW] - MIX_PTC_YAW
+	mavlink_parameters_list[164].min.param_float=-2.0; mavlink_parameters_list[164].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_THROTTLE] - MIX_PTC_THROT
+	mavlink_parameters_list[165].min.param_float=-2.0; mavlink_parameters_list[165].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_C].control[MIX_WAGGLE] - MIX_PTC_WAGGLE
+	mavlink_parameters_list[166].min.param_int32=0; mavlink_parameters_list[166].max.param_int32=16; // servo_mix[MIX_ROW_PASSTHROUGH_D].output - MIX_PTD_OUT
+	mavlink_parameters_list[167].min.param_int32=0; mavlink_parameters_list[167].max.param_int32=16; // servo_mix[MIX_ROW_PASSTHROUGH_D].input - MIX_PTD_IN
+	mavlink_parameters_list[168].min.param_int32=0; mavlink_parameters_list[168].max.param_int32=16; // servo_mix[MIX_ROW_PASSTHROUGH_D].cross - MIX_PTD_CROSS
+	mavlink_parameters_list[169].min.param_int32=-32767; mavlink_parameters_list[169].max.param_int32=32767; // servo_mix[MIX_ROW_PASSTHROUGH_D].manual[MIX_STICK_INPUT] - MIX_PTD_MAN
+	mavlink_parameters_list[170].min.param_int32=-32767; mavlink_parameters_list[170].max.param_int32=32767; // servo_mix[MIX_ROW_PASSTHROUGH_D].stabilized[MIX_STICK_INPUT] - MIX_PTD_STAB
+	mavlink_parameters_list[171].min.param_int32=-32767; mavlink_parameters_list[171].max.param_int32=32767; // servo_mix[MIX_ROW_PASSTHROUGH_D].manual[MIX_STICK_CROSS] - MIX_PTD_XMAN
+	mavlink_parameters_list[172].min.param_int32=-32767; mavlink_parameters_list[172].max.param_int32=32767; // servo_mix[MIX_ROW_PASSTHROUGH_D].stabilized[MIX_STICK_CROSS] - MIX_PTD_XSTAB
+	mavlink_parameters_list[173].min.param_float=-2.0; mavlink_parameters_list[173].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_ROLL] - MIX_PTD_ROLL
+	mavlink_parameters_list[174].min.param_float=-2.0; mavlink_parameters_list[174].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_PITCH] - MIX_PTD_PITCH
+	mavlink_parameters_list[175].min.param_float=-2.0; mavlink_parameters_list[175].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_YAW] - MIX_PTD_YAW
+	mavlink_parameters_list[176].min.param_float=-2.0; mavlink_parameters_list[176].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_THROTTLE] - MIX_PTD_THROT
+	mavlink_parameters_list[177].min.param_float=-2.0; mavlink_parameters_list[177].max.param_float=1.99; // servo_mix[MIX_ROW_PASSTHROUGH_D].control[MIX_WAGGLE] - MIX_PTD_WAGGLE
+
 };
 
 #endif // (USE_MAVLINK == 1)
@@ -27,6 +27,7 @@
 #include "states.h"
 #include "cameraCntrl.h"
 #include "../libUDB/servoOut.h"
+#include <string.h>
 
 #if (AIRFRAME_TYPE == AIRFRAME_GLIDER)
 #include "airspeedCntrl.h"
@@ -80,16 +81,218 @@ static int32_t throttleSteps = 0;//range: 0..2000
 // Use the radio to determine the baseline pulse widths if the radio is on.
 // Otherwise, use the trim pulse width measured during power up.
 //
-// Mix computed roll and pitch controls into the output channels for the compiled airframe type.
+// The airframe type selects the mixing matrix built by servoMix_init(), the
+// glider flaps and brakes are still mixed by hand below. The glider rows have
+// no output, they only give the control terms that the hand mixing adds in.
+
+struct servoMixRow servo_mix[MIX_ROWS];
 
 static int16_t elevatorbgain = 0;
 static int16_t rudderbgain   = 0;
 
+// Clear a row and point it at an output
+static struct servoMixRow* mix_row(int16_t row, int16_t output, int16_t input, int16_t flags)
+{
+	struct servoMixRow* r = &servo_mix[row];
+
+	memset(r, 0, sizeof(struct servoMixRow));
+	r->output = output;
+	r->input = input;
+	r->cross = CHANNEL_UNUSED;
+	r->flags = flags;
+	return r;
+}
+
+// Set the stick coefficient of an input channel, for manual and stabilized
+// modes. Any channel other than the row's input becomes its cross input.
+static void mix_manual(struct servoMixRow* r, int16_t input, int32_t manual, int32_t stabilized)
+{
+	int16_t stick = MIX_STICK_INPUT;
+
+	if (input != r->input)
+	{
+		r->cross = input;
+		stick = MIX_STICK_CROSS;
+	}
+	r->manual[stick] += manual;
+	r->stabilized[stick] += stabilized;
+}
+
+static void mix_passthrough(int16_t row, int16_t output, int16_t input)
+{
+	struct servoMixRow* r = mix_row(row, output, input, 0);
+	mix_manual(r, input, MIX_MANUAL_ONE, MIX_MANUAL_ONE);
+}
+
+#if (AIRFRAME_TYPE != AIRFRAME_GLIDER)
+// The manual throttle is passed through with throttle_control added, and
+// cuts the throttle when the throttle input is lost
+static void mix_throttle(void)
+{
+	struct servoMixRow* r = mix_row(MIX_ROW_THROTTLE, THROTTLE_OUTPUT_CHANNEL, THROTTLE_INPUT_CHANNEL, MIX_THROTTLE_CUT);
+	r->control[MIX_THROTTLE] = REVERSE_IF_NEEDED(THROTTLE_CHANNEL_REVERSED, RMAX);
+	mix_manual(r, THROTTLE_INPUT_CHANNEL, MIX_MANUAL_ONE, MIX_MANUAL_ONE);
+}
+#endif
+
+#if (AIRFRAME_TYPE == AIRFRAME_STANDARD || AIRFRAME_TYPE == AIRFRAME_VTAIL)
+// Aileron with waggle, the manual aileron is accounted for in the turn control
+// when stabilized. The secondary aileron follows the first, reversed if needed.
+static void mix_ailerons(void)
+{
+	struct servoMixRow* r = mix_row(MIX_ROW_AILERON, AILERON_OUTPUT_CHANNEL, AILERON_INPUT_CHANNEL, 0);
+	r->control[MIX_ROLL] = REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, RMAX);
+	r->control[MIX_WAGGLE] = REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, RMAX);
+	mix_manual(r, AILERON_INPUT_CHANNEL, MIX_MANUAL_ONE, 0);
+
+	r = mix_row(MIX_ROW_AILERON_SECONDARY, AILERON_SECONDARY_OUTPUT_CHANNEL, AILERON_INPUT_CHANNEL, 0);
+	r->control[MIX_ROLL] = REVERSE_IF_NEEDED(AILERON_SECONDARY_CHANNEL_REVERSED, REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, RMAX));
+	r->control[MIX_WAGGLE] = r->control[MIX_ROLL];
+	mix_manual(r, AILERON_INPUT_CHANNEL, REVERSE_IF_NEEDED(AILERON_SECONDARY_CHANNEL_REVERSED, MIX_MANUAL_ONE), 0);
+}
+#endif
+
 void servoMix_init(void)
 {
+	struct servoMixRow* r;
+#if (AIRFRAME_TYPE != AIRFRAME_GLIDER && AIRFRAME_TYPE != AIRFRAME_HELI)
+	int32_t elevatorBoost;
+	int32_t rudderBoost;
+#endif
+
 	elevatorbgain = (int16_t)(8.0*gains.ElevatorBoost);
 	rudderbgain   = (int16_t)(8.0*gains.RudderBoost);
 
+	memset(servo_mix, 0, sizeof(servo_mix));
+
+#if (AIRFRAME_TYPE != AIRFRAME_GLIDER && AIRFRAME_TYPE != AIRFRAME_HELI)
+	// stick coefficients of the boosted elevator and rudder, when stabilized
+	elevatorBoost = ((int32_t)(elevatorbgain + 8) * MIX_MANUAL_ONE) >> 3;
+	rudderBoost   = ((int32_t)(rudderbgain + 8) * MIX_MANUAL_ONE) >> 3;
+#endif
+
+	// Standard airplane airframe
+	// Mix roll_control into ailerons
+	// Mix pitch_control into elevators
+	// Mix yaw control and waggle into rudder
+#if (AIRFRAME_TYPE == AIRFRAME_STANDARD)
+	mix_ailerons();
+
+	r = mix_row(MIX_ROW_ELEVATOR, ELEVATOR_OUTPUT_CHANNEL, ELEVATOR_INPUT_CHANNEL, 0);
+	r->control[MIX_PITCH] = REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, RMAX);
+	mix_manual(r, ELEVATOR_INPUT_CHANNEL, MIX_MANUAL_ONE, elevatorBoost);
+
+	r = mix_row(MIX_ROW_RUDDER, RUDDER_OUTPUT_CHANNEL, RUDDER_INPUT_CHANNEL, 0);
+	r->control[MIX_YAW] = REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, RMAX);
+	r->control[MIX_WAGGLE] = REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, -RMAX);
+	mix_manual(r, RUDDER_INPUT_CHANNEL, MIX_MANUAL_ONE, rudderBoost);
+
+	mix_throttle();
+#endif // AIRFRAME_STANDARD
+
+	// V-Tail airplane airframe
+	// Mix roll_control and waggle into ailerons
+	// Mix pitch_control and yaw_control into both elevator and rudder
+	// The sticks are unmixed into pitch and yaw, each half of both surfaces,
+	// and boosted when stabilized.
+#if (AIRFRAME_TYPE == AIRFRAME_VTAIL)
+	mix_ailerons();
+
+	r = mix_row(MIX_ROW_ELEVATOR, ELEVATOR_OUTPUT_CHANNEL, ELEVATOR_INPUT_CHANNEL, 0);
+	r->control[MIX_PITCH] = REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, RMAX);
+	r->control[MIX_YAW] = REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, REVERSE_IF_NEEDED(ELEVON_VTAIL_SURFACES_REVERSED, RMAX));
+	mix_manual(r, ELEVATOR_INPUT_CHANNEL, MIX_MANUAL_ONE, (elevatorBoost + rudderBoost) / 2);
+	mix_manual(r, RUDDER_INPUT_CHANNEL, 0,
+	    REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, (elevatorBoost - rudderBoost) / 2)));
+
+	r = mix_row(MIX_ROW_RUDDER, RUDDER_OUTPUT_CHANNEL, RUDDER_INPUT_CHANNEL, 0);
+	r->control[MIX_PITCH] = REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, RMAX);
+	r->control[MIX_YAW] = REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, REVERSE_IF_NEEDED(ELEVON_VTAIL_SURFACES_REVERSED, -RMAX));
+	mix_manual(r, RUDDER_INPUT_CHANNEL, MIX_MANUAL_ONE, (elevatorBoost + rudderBoost) / 2);
+	mix_manual(r, ELEVATOR_INPUT_CHANNEL, 0,
+	    REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, (elevatorBoost - rudderBoost) / 2)));
+
+	mix_throttle();
+#endif // AIRFRAME_VTAIL
+
+	// Delta-Wing airplane airframe
+	// Mix roll_control, pitch_control, and waggle into aileron and elevator
+	// Mix rudder_control into  rudder
+	// When stabilized the elevon sticks only command pitch, boosted.
+#if (AIRFRAME_TYPE == AIRFRAME_DELTA)
+	r = mix_row(MIX_ROW_AILERON, AILERON_OUTPUT_CHANNEL, AILERON_INPUT_CHANNEL, 0);
+	r->control[MIX_ROLL] = REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, REVERSE_IF_NEEDED(ELEVON_VTAIL_SURFACES_REVERSED, -RMAX));
+	r->control[MIX_PITCH] = REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, RMAX);
+	r->control[MIX_WAGGLE] = REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, -RMAX);
+	mix_manual(r, AILERON_INPUT_CHANNEL, MIX_MANUAL_ONE, elevatorBoost / 2);
+	mix_manual(r, ELEVATOR_INPUT_CHANNEL, 0,
+	    REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, elevatorBoost / 2)));
+
+	r = mix_row(MIX_ROW_ELEVATOR, ELEVATOR_OUTPUT_CHANNEL, ELEVATOR_INPUT_CHANNEL, 0);
+	r->control[MIX_ROLL] = REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, REVERSE_IF_NEEDED(ELEVON_VTAIL_SURFACES_REVERSED, RMAX));
+	r->control[MIX_PITCH] = REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, RMAX);
+	r->control[MIX_WAGGLE] = REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, RMAX);
+	mix_manual(r, ELEVATOR_INPUT_CHANNEL, MIX_MANUAL_ONE, elevatorBoost / 2);
+	mix_manual(r, AILERON_INPUT_CHANNEL, 0,
+	    REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, elevatorBoost / 2)));
+
+	r = mix_row(MIX_ROW_RUDDER, RUDDER_OUTPUT_CHANNEL, RUDDER_INPUT_CHANNEL, 0);
+	r->control[MIX_YAW] = REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, RMAX);
+	r->control[MIX_WAGGLE] = REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, -RMAX);
+	mix_manual(r, RUDDER_INPUT_CHANNEL, MIX_MANUAL_ONE, rudderBoost);
+
+	mix_throttle();
+#endif // AIRFRAME_DELTA
+
+	// Helicopter airframe
+	// Mix half of roll_control and half of pitch_control into aileron channels
+	// Mix full pitch_control into elevator
+	// Ignore waggle for now
+#if (AIRFRAME_TYPE == AIRFRAME_HELI)
+	r = mix_row(MIX_ROW_AILERON, AILERON_OUTPUT_CHANNEL, AILERON_INPUT_CHANNEL, 0);
+	r->control[MIX_ROLL] = REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, RMAX/2);
+	r->control[MIX_PITCH] = REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, RMAX/2);
+	mix_manual(r, AILERON_INPUT_CHANNEL, MIX_MANUAL_ONE, MIX_MANUAL_ONE);
+
+	r = mix_row(MIX_ROW_ELEVATOR, ELEVATOR_OUTPUT_CHANNEL, ELEVATOR_INPUT_CHANNEL, 0);
+	r->control[MIX_PITCH] = REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, RMAX);
+	mix_manual(r, ELEVATOR_INPUT_CHANNEL, MIX_MANUAL_ONE, MIX_MANUAL_ONE);
+
+	r = mix_row(MIX_ROW_AILERON_SECONDARY, AILERON_SECONDARY_OUTPUT_CHANNEL, AILERON_SECONDARY_OUTPUT_CHANNEL, 0);
+	r->control[MIX_ROLL] = REVERSE_IF_NEEDED(AILERON_SECONDARY_CHANNEL_REVERSED, -RMAX/2);
+	r->control[MIX_PITCH] = REVERSE_IF_NEEDED(AILERON_SECONDARY_CHANNEL_REVERSED, RMAX/2);
+	mix_manual(r, AILERON_SECONDARY_OUTPUT_CHANNEL, MIX_MANUAL_ONE, MIX_MANUAL_ONE);
+
+	r = mix_row(MIX_ROW_RUDDER, RUDDER_OUTPUT_CHANNEL, RUDDER_INPUT_CHANNEL, 0);
+	mix_manual(r, RUDDER_INPUT_CHANNEL, MIX_MANUAL_ONE, MIX_MANUAL_ONE);
+
+	mix_throttle();
+#endif // AIRFRAME_HELI
+
+	// Glider airframe
+	// Mix roll_control and waggle into the aileron input of the flap mixer
+	// Mix pitch_control into elevator, yaw_control and waggle into rudder
+	// Mix throttle_control into throttle
+#if (AIRFRAME_TYPE == AIRFRAME_GLIDER)
+	r = mix_row(MIX_ROW_AILERON, CHANNEL_UNUSED, AILERON_INPUT_CHANNEL, 0);
+	r->control[MIX_ROLL] = REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, RMAX);
+	r->control[MIX_WAGGLE] = REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, RMAX);
+
+	r = mix_row(MIX_ROW_ELEVATOR, CHANNEL_UNUSED, ELEVATOR_INPUT_CHANNEL, 0);
+	r->control[MIX_PITCH] = REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, RMAX);
+
+	r = mix_row(MIX_ROW_RUDDER, CHANNEL_UNUSED, RUDDER_INPUT_CHANNEL, 0);
+	r->control[MIX_YAW] = REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, RMAX);
+	r->control[MIX_WAGGLE] = REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, -RMAX);
+
+	r = mix_row(MIX_ROW_THROTTLE, CHANNEL_UNUSED, THROTTLE_INPUT_CHANNEL, 0);
+	r->control[MIX_THROTTLE] = REVERSE_IF_NEEDED(THROTTLE_CHANNEL_REVERSED, RMAX);
+#endif // AIRFRAME_GLIDER
+
+	mix_passthrough(MIX_ROW_PASSTHROUGH_A, PASSTHROUGH_A_OUTPUT_CHANNEL, PASSTHROUGH_A_INPUT_CHANNEL);
+	mix_passthrough(MIX_ROW_PASSTHROUGH_B, PASSTHROUGH_B_OUTPUT_CHANNEL, PASSTHROUGH_B_INPUT_CHANNEL);
+	mix_passthrough(MIX_ROW_PASSTHROUGH_C, PASSTHROUGH_C_OUTPUT_CHANNEL, PASSTHROUGH_C_INPUT_CHANNEL);
+	mix_passthrough(MIX_ROW_PASSTHROUGH_D, PASSTHROUGH_D_OUTPUT_CHANNEL, PASSTHROUGH_D_INPUT_CHANNEL);
 
 #if (AIRFRAME_TYPE == AIRFRAME_GLIDER)
 	//convert fraction to x*32 integer;(0.03 resolution) 0.03 = 1 , 1.0 = 32 //only once, to save resources
@@ -136,57 +339,76 @@ void servoMix_init(void)
 #endif //AIRFRAME_GLIDER
 }
 
-void servoMix(void)
+static void mix_controls(int32_t controls[])
 {
-	int32_t temp;
-	int16_t pwManual[NUM_INPUTS+1];
+	controls[MIX_ROLL] = roll_control;
+	controls[MIX_PITCH] = pitch_control;
+	controls[MIX_YAW] = yaw_control;
+	controls[MIX_THROTTLE] = throttle_control;
+	controls[MIX_WAGGLE] = waggle;
+}
 
-	// If radio is off, use udb_pwTrim values instead of the udb_pwIn values
-	for (temp = 0; temp <= NUM_INPUTS; temp++)
+// Sum of the control terms of a row, in the Q14 coefficients, before the
+// shift down to pulse width units
+static int32_t mix_control(const struct servoMixRow* r, const int32_t controls[])
+{
+	int32_t control = 0;
+	int16_t i;
+
+	for (i = 0; i < MIX_CONTROLS; i++)
 	{
-		if (udb_flags._.radio_on)
-			pwManual[temp] = udb_pwIn[temp];
-		else
-			pwManual[temp] = udb_pwTrim[temp];
+		control += r->control[i] * controls[i];
 	}
+	return control;
+}
 
+// Stick deflection from trim of an input channel, zero while the radio is off
+static int16_t mix_deflection(int16_t input)
+{
+	if (!udb_flags._.radio_on || input == CHANNEL_UNUSED)
+		return 0;
+	return udb_pwIn[input] - udb_pwTrim[input];
+}
 
-	// Standard airplane airframe
-	// Mix roll_control into ailerons
-	// Mix pitch_control into elevators
-	// Mix yaw control and waggle into rudder
-#if (AIRFRAME_TYPE == AIRFRAME_STANDARD)
-	// Apply boosts to elevator and rudder if in a controlled mode
-	// It does not matter whether the radio is on or not
-	if (state_flags._.pitch_feedback)
-	{
-		pwManual[AILERON_INPUT_CHANNEL] = udb_pwTrim[AILERON_INPUT_CHANNEL] ; // in fly by wire or navigate mode, manual input is accounted for in the turn control
-		pwManual[ELEVATOR_INPUT_CHANNEL] += ((pwManual[ELEVATOR_INPUT_CHANNEL] - udb_pwTrim[ELEVATOR_INPUT_CHANNEL]) * elevatorbgain) >> 3;
-		pwManual[RUDDER_INPUT_CHANNEL] += ((pwManual[RUDDER_INPUT_CHANNEL] - udb_pwTrim[RUDDER_INPUT_CHANNEL]) * rudderbgain) >> 3;
-	}
-		temp = pwManual[AILERON_INPUT_CHANNEL] + REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, roll_control + waggle);
-		udb_pwOut[AILERON_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-		
-	udb_pwOut[AILERON_SECONDARY_OUTPUT_CHANNEL] = udb_pwTrim[AILERON_INPUT_CHANNEL] +
-	    REVERSE_IF_NEEDED(AILERON_SECONDARY_CHANNEL_REVERSED, udb_pwOut[AILERON_OUTPUT_CHANNEL] - udb_pwTrim[AILERON_INPUT_CHANNEL]);
+// Mix the control terms and the stick deflections from trim through the
+// matrix rows. The channels of a row are parameters, so they are range
+// checked here; an input out of range is treated as unused.
+static void servoMix_matrix(void)
+{
+	int32_t controls[MIX_CONTROLS];
+	boolean stabilized = state_flags._.pitch_feedback;
+	int16_t row;
 
-		temp = pwManual[ELEVATOR_INPUT_CHANNEL] + REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, pitch_control);
-		udb_pwOut[ELEVATOR_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
+	mix_controls(controls);
 
-		temp = pwManual[RUDDER_INPUT_CHANNEL] + REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, yaw_control - waggle);
-		udb_pwOut[RUDDER_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
+	for (row = 0; row < MIX_ROWS; row++)
+	{
+		struct servoMixRow* r = &servo_mix[row];
+		const int16_t* stick = stabilized ? r->stabilized : r->manual;
+		int16_t input = r->input;
+		int16_t cross = r->cross;
+		int32_t manual;
 
-		if (pwManual[THROTTLE_INPUT_CHANNEL] == 0)
-		{
-			udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = 0;
-		}
-		else
+		if ((uint16_t)(r->output - 1) >= NUM_OUTPUTS) continue;
+		if ((uint16_t)input > NUM_INPUTS) input = CHANNEL_UNUSED;
+		if ((uint16_t)cross > NUM_INPUTS) cross = CHANNEL_UNUSED;
+
+		if (r->flags & MIX_THROTTLE_CUT)
 		{
-			temp = pwManual[THROTTLE_INPUT_CHANNEL] + REVERSE_IF_NEEDED(THROTTLE_CHANNEL_REVERSED, throttle_control);
-			udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
+			if ((udb_flags._.radio_on ? udb_pwIn[input] : udb_pwTrim[input]) == 0)
+			{
+				udb_pwOut[r->output] = 0;
+				continue;
+			}
 		}
-#endif // AIRFRAME_STANDARD
+		manual = (int32_t)stick[MIX_STICK_INPUT] * mix_deflection(input)
+		       + (int32_t)stick[MIX_STICK_CROSS] * mix_deflection(cross);
+		udb_pwOut[r->output] = udb_servo_pulsesat(udb_pwTrim[input] + (mix_control(r, controls) >> 14) + (manual >> 12));
+	}
+}
 
+void servoMix(void)
+{
 #if (AIRFRAME_TYPE == AIRFRAME_GLIDER)
 	{
 	static int16_t mixerSteps = 0;
@@ -202,6 +424,20 @@ void servoMix(void)
 #endif
 	static int16_t flapsSelectedStep=0;
 	static int16_t autopilotThrottleSelected=0;	//used for elevator trim in motorclimb
+	int32_t temp;
+	int16_t pwManual[NUM_INPUTS+1];
+	int32_t controls[MIX_CONTROLS];
+
+	mix_controls(controls);
+
+	// If radio is off, use udb_pwTrim values instead of the udb_pwIn values
+	for (temp = 0; temp <= NUM_INPUTS; temp++)
+	{
+		if (udb_flags._.radio_on)
+			pwManual[temp] = udb_pwIn[temp];
+		else
+			pwManual[temp] = udb_pwTrim[temp];
+	}
 
 	// Apply boosts to elevator and rudder if in a controlled mode
 	// It does not matter whether the radio is on or not
@@ -285,7 +521,7 @@ void servoMix(void)
 #else
 	flapsSelectedStep = 0;
 #endif //FLAPS_INPUT_CHANNEL
-	aileronInput = pwManual[AILERON_INPUT_CHANNEL] + REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, roll_control + waggle);
+	aileronInput = pwManual[AILERON_INPUT_CHANNEL] + (int16_t)(mix_control(&servo_mix[MIX_ROW_AILERON], controls) >> 14);
 
 	//Calculate ailInLeftPartFlapsNotSpeed, ailInRightPartFlapsNotSpeed, ailInLeftPartFlapsSpeed and ailInRightPartFlapsSpeed
 	//only one can be >0 at a time
@@ -408,7 +644,7 @@ void servoMix(void)
 	}
 	else
 	{
-		temp = pwManual[THROTTLE_INPUT_CHANNEL] + REVERSE_IF_NEEDED(THROTTLE_CHANNEL_REVERSED, throttle_control);
+		temp = pwManual[THROTTLE_INPUT_CHANNEL] + (mix_control(&servo_mix[MIX_ROW_THROTTLE], controls) >> 14);
 		//one channel selects throttle or autopilotBrake function on left stick
 
 		if ( (BRAKE_THR_SEL_INPUT_CHANNEL != 0) && ( pwManual[BRAKE_THR_SEL_INPUT_CHANNEL] < (SERVOCENTER + 333)) )
@@ -428,7 +664,7 @@ void servoMix(void)
 	}
 #endif  //THROTTLE_INPUT_CHANNEL
 
-	temp = pwManual[RUDDER_INPUT_CHANNEL] + REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, yaw_control - waggle);
+	temp = pwManual[RUDDER_INPUT_CHANNEL] + (mix_control(&servo_mix[MIX_ROW_RUDDER], controls) >> 14);
 	mixerSteps = temp - SERVOCENTER;
 	mixerSteps += (aileronInput * rudderFromAileronFactor)>>5;
 	mixerSteps += REVERSE_IF_NEEDED(RUDDER_OFFSET_REVERSED,RUDDER_OUTPUT_OFFSET);
@@ -437,7 +673,7 @@ void servoMix(void)
 	mixerSteps += SERVOCENTER;
 	udb_pwOut[RUDDER_OUTPUT_CHANNEL] = udb_servo_pulsesat(mixerSteps);
 
-	temp = pwManual[ELEVATOR_INPUT_CHANNEL] + REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, pitch_control);
+	temp = pwManual[ELEVATOR_INPUT_CHANNEL] + (mix_control(&servo_mix[MIX_ROW_ELEVATOR], controls) >> 14);
 	mixerSteps = temp - SERVOCENTER;
 	mixerSteps += (brakeSelectedStep * elevatorBrakeFactor)>>5;
 	mixerSteps += (autopilotThrottleSelected * elevatorThrottleFactor)>>5;
@@ -463,160 +699,7 @@ void servoMix(void)
 	}
 #endif // AIRFRAME_GLIDER
 
-
-	// V-Tail airplane airframe
-	// Mix roll_control and waggle into ailerons
-	// Mix pitch_control and yaw_control into both elevator and rudder
-#if (AIRFRAME_TYPE == AIRFRAME_VTAIL)
-	{
-	int16_t rudderInput;
-	int16_t elevatorInput;
-	int16_t pitchInput;
-	int16_t yawInput;
-	int16_t pitchCommand;
-	int16_t yawCommand;
-		int32_t vtail_yaw_control;
-
-	// Unmix the vtail
-	rudderInput  = REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, (pwManual[RUDDER_INPUT_CHANNEL] - udb_pwTrim[RUDDER_INPUT_CHANNEL]));
-	elevatorInput = REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, (pwManual[ELEVATOR_INPUT_CHANNEL] - udb_pwTrim[ELEVATOR_INPUT_CHANNEL]));
-	pitchInput = ((rudderInput+elevatorInput)>>1);
-	yawInput = ((-rudderInput+elevatorInput)>>1);
-
-	if (state_flags._.pitch_feedback)
-	{
-		// Apply boost in FBW or navigate mode
-		pitchCommand = ((elevatorbgain + 8) * pitchInput) >> 3;
-		yawCommand   = ((rudderbgain + 8)   * yawInput)   >> 3;
-		// in fly by wire or navigate mode, manual input is accounted for in the turn control
-		pwManual[AILERON_INPUT_CHANNEL] = udb_pwTrim[AILERON_INPUT_CHANNEL];
-	}
-	else
-	{
-		pitchCommand = pitchInput;
-		yawCommand = yawInput;
-	}
-	
-	vtail_yaw_control = REVERSE_IF_NEEDED(ELEVON_VTAIL_SURFACES_REVERSED, yaw_control);
-
-	// In fly by wire mode, ailerons are controlled indirectly by helical turn control
-	temp = pwManual[AILERON_INPUT_CHANNEL] + REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, roll_control + waggle);
-	udb_pwOut[AILERON_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-
-	//	Reverse the polarity of the secondary aileron if necessary
-	udb_pwOut[AILERON_SECONDARY_OUTPUT_CHANNEL] = udb_pwTrim[AILERON_INPUT_CHANNEL] +
-	    REVERSE_IF_NEEDED(AILERON_SECONDARY_CHANNEL_REVERSED, udb_pwOut[AILERON_OUTPUT_CHANNEL] - udb_pwTrim[AILERON_INPUT_CHANNEL]);
-
-	temp = udb_pwTrim[ELEVATOR_INPUT_CHANNEL] +
-	    REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, pitchCommand + pitch_control + yawCommand + vtail_yaw_control);
-	udb_pwOut[ELEVATOR_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-
-	temp = udb_pwTrim[RUDDER_INPUT_CHANNEL] +
-	    REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, pitchCommand + pitch_control - yawCommand - vtail_yaw_control);
-		udb_pwOut[RUDDER_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-
-		if (pwManual[THROTTLE_INPUT_CHANNEL] == 0)
-		{
-			udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = 0;
-		}
-		else
-		{
-			temp = pwManual[THROTTLE_INPUT_CHANNEL] + REVERSE_IF_NEEDED(THROTTLE_CHANNEL_REVERSED, throttle_control);
-			udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-		}
-	}
-#endif // AIRFRAME_VTAIL
-
-	// Delta-Wing airplane airframe
-	// Mix roll_control, pitch_control, and waggle into aileron and elevator
-	// Mix rudder_control into  rudder
-#if (AIRFRAME_TYPE == AIRFRAME_DELTA)
-	{
-	int16_t aileronInput;
-	int16_t elevatorInput;
-	int16_t pitchInput;
-	int16_t rollInput;
-	int16_t pitchCommand;
-	int16_t rollCommand;
-	int32_t delta_roll_control;
-	// unmix the inputs, note this will produce zeros during radio off
-	aileronInput  = REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, (pwManual[AILERON_INPUT_CHANNEL] - udb_pwTrim[AILERON_INPUT_CHANNEL]));
-	elevatorInput = REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, (pwManual[ELEVATOR_INPUT_CHANNEL] - udb_pwTrim[ELEVATOR_INPUT_CHANNEL]));
-	pitchInput = (elevatorInput+aileronInput)>>1;
-	rollInput = (elevatorInput-aileronInput)>>1;
-
-	if (state_flags._.pitch_feedback)
-	{
-		pitchCommand = ((elevatorbgain + 8) * pitchInput ) >> 3;
-		pwManual[RUDDER_INPUT_CHANNEL] += ((pwManual[RUDDER_INPUT_CHANNEL] - udb_pwTrim[RUDDER_INPUT_CHANNEL]) * rudderbgain) >> 3;
-		rollCommand = 0;
-	}
-	else
-	{
-		pitchCommand = pitchInput;
-		rollCommand = rollInput;
-	}
-	delta_roll_control = REVERSE_IF_NEEDED(ELEVON_VTAIL_SURFACES_REVERSED, roll_control);
-
-	temp = udb_pwTrim[AILERON_INPUT_CHANNEL] +
-	    REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, -rollCommand -delta_roll_control + pitchCommand + pitch_control - waggle);
-		udb_pwOut[AILERON_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-
-	temp = udb_pwTrim[ELEVATOR_INPUT_CHANNEL] +
-	    REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, rollCommand + delta_roll_control + pitchCommand + pitch_control + waggle);
-		udb_pwOut[ELEVATOR_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-
-		temp = pwManual[RUDDER_INPUT_CHANNEL] +
-	    REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, yaw_control - waggle);
-		udb_pwOut[RUDDER_OUTPUT_CHANNEL] =  udb_servo_pulsesat(temp);
-		
-		if (pwManual[THROTTLE_INPUT_CHANNEL] == 0)
-		{
-			udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = 0;
-		}
-		else
-		{
-			temp = pwManual[THROTTLE_INPUT_CHANNEL] + REVERSE_IF_NEEDED(THROTTLE_CHANNEL_REVERSED, throttle_control);
-			udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-		}
-	}
-#endif // AIRFRAME_DELTA
-
-	// Helicopter airframe
-	// Mix half of roll_control and half of pitch_control into aileron channels
-	// Mix full pitch_control into elevator
-	// Ignore waggle for now
-#if (AIRFRAME_TYPE == AIRFRAME_HELI)
-		temp = pwManual[AILERON_INPUT_CHANNEL] +
-			REVERSE_IF_NEEDED(AILERON_CHANNEL_REVERSED, roll_control/2 + pitch_control/2);
-		udb_pwOut[AILERON_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-
-		temp = pwManual[ELEVATOR_INPUT_CHANNEL] +
-		    REVERSE_IF_NEEDED(ELEVATOR_CHANNEL_REVERSED, pitch_control);
-		udb_pwOut[ELEVATOR_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-
-		temp = pwManual[AILERON_SECONDARY_OUTPUT_CHANNEL] + 
-			REVERSE_IF_NEEDED(AILERON_SECONDARY_CHANNEL_REVERSED, -roll_control/2 + pitch_control/2);
-		udb_pwOut[AILERON_SECONDARY_OUTPUT_CHANNEL] = temp;
-
-		temp = pwManual[RUDDER_INPUT_CHANNEL] /*+ REVERSE_IF_NEEDED(RUDDER_CHANNEL_REVERSED, yaw_control)*/;
-		udb_pwOut[RUDDER_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-
-		if (pwManual[THROTTLE_INPUT_CHANNEL] == 0)
-		{
-			udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = 0;
-		}
-		else
-		{
-			temp = pwManual[THROTTLE_INPUT_CHANNEL] + REVERSE_IF_NEEDED(THROTTLE_CHANNEL_REVERSED, throttle_control);
-			udb_pwOut[THROTTLE_OUTPUT_CHANNEL] = udb_servo_pulsesat(temp);
-		}
-#endif // AIRFRAME_HELI
-
-		udb_pwOut[PASSTHROUGH_A_OUTPUT_CHANNEL] = udb_servo_pulsesat(pwManual[PASSTHROUGH_A_INPUT_CHANNEL]);
-		udb_pwOut[PASSTHROUGH_B_OUTPUT_CHANNEL] = udb_servo_pulsesat(pwManual[PASSTHROUGH_B_INPUT_CHANNEL]);
-		udb_pwOut[PASSTHROUGH_C_OUTPUT_CHANNEL] = udb_servo_pulsesat(pwManual[PASSTHROUGH_C_INPUT_CHANNEL]);
-		udb_pwOut[PASSTHROUGH_D_OUTPUT_CHANNEL] = udb_servo_pulsesat(pwManual[PASSTHROUGH_D_INPUT_CHANNEL]);
+	servoMix_matrix();
 }
 
 void cameraServoMix(void)
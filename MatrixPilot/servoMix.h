@@ -22,6 +22,60 @@
 #ifndef _SERVOMIX_H_
 #define _SERVOMIX_H_
 
+// Each mixed output is a row of coefficients over the control terms and the
+// radio stick deflections from trim of up to two input channels: the input
+// the output is centred on, and a cross input. The control coefficients are
+// Q14 (RMAX is 1.0). The stick coefficients are Q12, to allow for elevator
+// and rudder boost, with one set for manual mode and one for the stabilized
+// modes. All of them, and the output, input and cross channels of each row,
+// are parameters. The channel options only give their defaults.
+// The glider rows have no output, their control terms are taken up by the
+// hand written flap and brake mixing, which has no secondary aileron row.
+enum {
+	MIX_ROLL,
+	MIX_PITCH,
+	MIX_YAW,
+	MIX_THROTTLE,
+	MIX_WAGGLE,
+	MIX_CONTROLS
+};
+
+// Rows are mixed in this order, a later row wins if two share an output
+enum {
+	MIX_ROW_AILERON,
+	MIX_ROW_AILERON_SECONDARY,
+	MIX_ROW_ELEVATOR,
+	MIX_ROW_RUDDER,
+	MIX_ROW_THROTTLE,
+	MIX_ROW_PASSTHROUGH_A,
+	MIX_ROW_PASSTHROUGH_B,
+	MIX_ROW_PASSTHROUGH_C,
+	MIX_ROW_PASSTHROUGH_D,
+	MIX_ROWS
+};
+
+#define MIX_MANUAL_ONE              4096    // 1.0 as a Q12 stick coefficient
+
+#define MIX_THROTTLE_CUT            1       // output 0 while the input channel reads 0
+
+enum {
+	MIX_STICK_INPUT,
+	MIX_STICK_CROSS,
+	MIX_STICKS
+};
+
+struct servoMixRow {
+	int16_t output;                         // udb_pwOut channel, CHANNEL_UNUSED for none
+	int16_t input;                          // input channel the output is centred on
+	int16_t cross;                          // second input channel, CHANNEL_UNUSED for none
+	int16_t flags;
+	int16_t control[MIX_CONTROLS];
+	int16_t manual[MIX_STICKS];             // stick coefficients in manual mode
+	int16_t stabilized[MIX_STICKS];         // and in the stabilized modes
+};
+
+extern struct servoMixRow servo_mix[MIX_ROWS];
+
 
 void servoMix(void);
 void servoMix_init(void);
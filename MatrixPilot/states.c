@@ -24,6 +24,7 @@
 #include "flightplan.h"
 #include "config.h"
 #include "states.h"
+#include "navigate.h"
 #include "altitudeCntrl.h"
 #include "../libDCM/deadReckoning.h"
 #include "../libDCM/gpsParseCommon.h"
@@ -98,6 +99,9 @@ void udb_heartbeat_40hz_callback(void)
 
 	delayCheck++;
 
+	// retry any parameter save refused while data services were busy
+	navigate_save_pending_40hz();
+
 	// read flight mode switch (sets state_flags bits) at 40Hz
 	flight_mode_switch_check_set();
 
@@ -144,6 +148,9 @@ void udb_heartbeat_40hz_callback(void)
 // Called at 40Hz
 void udb_heartbeat_40hz_callback(void)
 {
+	// retry any parameter save refused while data services were busy
+	navigate_save_pending_40hz();
+
 	// Determine whether a flight mode switch is commanded.
 	flight_mode_switch_check_set();
 	if (counter++ >= 20)    // 2Hz
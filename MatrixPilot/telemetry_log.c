@@ -23,11 +23,13 @@
 #include "../libUDB/heartbeat.h"
 #include "telemetry.h"
 #include "telemetry_log.h"
-#if (WIN == 1 || NIX == 1 || PX4 == 1)
+#include "../libFlashFS/filesys.h"
+#if ((WIN == 1 || NIX == 1) && (SILSIM_MEDIA == SILSIM_MEDIA_HOST)) || (PX4 == 1)
 #include <stdio.h>
 #include "../Tools/MatrixPilot-SIL/SIL-filesystem.h"
 #else
 #include "MDD-File-System/FSIO.h"
+#include "../libFlashFS/log_store.h"
 #endif
 #include <string.h>
 #include <stdarg.h>
@@ -54,8 +56,13 @@ static char logbuf2[LOGBUF_BUFFER_SIZE+1];  // TODO: added 1 byte until buffer o
 static volatile int lb1_end_index = 0;
 static volatile int lb2_end_index = 0;
 static volatile int lb_in_use = 1;
+#ifdef USE_AT45D_LOG_STORE
+static uint16_t log_number;
+static volatile boolean log_close_request = false;
+#else
 static char logfile_name[13];
-static FILE* fsp = NULL;
+static FSFILE* fsp = NULL;
+#endif
 
 
 static int16_t log_append(char* logbuf, int index, const char* data, int len)
@@ -103,18 +110,71 @@ void log_swapbuf(void)
 	}
 }
 
+#ifdef USE_AT45D_LOG_STORE
+
+static boolean log_is_open(void)
+{
+	return log_store_is_open();
+}
+
+static void log_open(void)
+{
+	log_close_request = false;
+	log_number = log_store_open();
+	lb1_end_index = 0;  // empty the logfile ping-pong buffers
+	lb2_end_index = 0;
+	telemetry_restart();// signal telemetry to send startup data again
+	printf("log %u opened\r\n", log_number);
+}
+
+// this may be called at interrupt or background level, so it only asks
+// telemetry_log() to close the log, which writes the last page from the mainloop
+void log_close(void)
+{
+	if (log_store_is_open())
+	{
+		log_close_request = true;
+	}
+}
+
+static void log_close_pending(void)
+{
+	if (log_close_request)
+	{
+		log_close_request = false;
+		log_store_close();
+		printf("log %u closed\r\n", log_number);
+	}
+}
+
+static void log_write(const char* str, int len)
+{
+	if (log_store_is_open())
+	{
+		led_on(LED_BLUE);
+		log_store_write(str, len);
+	}
+}
+
+#else // USE_AT45D_LOG_STORE
+
+static boolean log_is_open(void)
+{
+	return (fsp != NULL);
+}
+
 static int fs_nextlog(char* filename)
 {
-	FILE* fp;
+	FSFILE* fp;
 	int i;
 
 	for (i = 0; i < 99; i++)
 	{
 		sprintf(filename, "log%02u.txt", i);
-		fp = fopen(filename, "r");
+		fp = FSfopen(filename, "r");
 		if (fp != NULL)
 		{
-			fclose(fp);
+			FSfclose(fp);
 		}
 		else
 		{
@@ -135,7 +195,7 @@ static void log_open(void)
 	{
 		strcpy(logfile_name, "fp_log.txt");
 	}
-	fsp = fopen(logfile_name, "a");
+	fsp = FSfopen(logfile_name, "a");
 	if (fsp != NULL)
 	{
 		lb1_end_index = 0;  // empty the logfile ping-pong buffers
@@ -153,16 +213,36 @@ static void log_open(void)
 // this may be called at interrupt or background level
 void log_close(void)
 {
-	FILE* fp = fsp;   // make a copy of our file pointer
+	FSFILE* fp = fsp; // make a copy of our file pointer
 
 	if (fsp)
 	{
 		fsp = NULL;     // close the door to any further writes
-		fclose(fp);   // and close up the file
+		FSfclose(fp); // and close up the file
+		filesys_flush();
 		printf("%s closed\r\n", logfile_name);
 	}
 }
 
+static void log_write(const char* str, int len)
+{
+	if (fsp)
+	{
+		led_on(LED_BLUE);
+		if ((int)FSfwrite(str, 1, len, fsp) != len)
+		{
+			DPRINT("ERROR: fwrite\r\n");
+			log_close();
+		}
+	}
+}
+
+static void log_close_pending(void)
+{
+}
+
+#endif // USE_AT45D_LOG_STORE
+
 static void log_check(void)
 {
 	static uint16_t debounce = 0;
@@ -172,7 +252,7 @@ static void log_check(void)
 		debounce--;
 		return;
 	}
-	if (fsp)
+	if (log_is_open())
 	{
 		if (LOGFILE_ENABLE_PIN == 1 && !inflight_state())
 		{
@@ -190,19 +270,6 @@ static void log_check(void)
 	}
 }
 
-static void log_write(const char* str, int len)
-{
-	if (fsp)
-	{
-		led_on(LED_BLUE);
-		if ((int)fwrite(str, 1, len, fsp) != len)
-		{
-			DPRINT("ERROR: fwrite\r\n");
-			log_close();
-		}
-	}
-}
-
 // called from mainloop at background priority to write buffered telemetry log data to log file
 void telemetry_log(void)
 {
@@ -222,5 +289,6 @@ void telemetry_log(void)
 			lb1_end_index = 0;
 		}
 	}
+	log_close_pending();
 	log_check();
 }
@@ -22,7 +22,12 @@
 #ifndef _FSCONFIG_H_
 #define _FSCONFIG_H_
 
+#if (WIN == 1 || NIX == 1)
+#include "Compiler.h"
+#include "../libUDB/libUDB.h"   // SILSIM_MEDIA selects the storage image
+#else
 #include "HardwareProfile.h"
+#endif
 
 #ifdef USE_AT45D_FLASH
 //#warning USE_AT45D_FLASH
@@ -34,6 +39,8 @@
 #elif defined(USE_SD_INTERFACE_WITH_SPI)
 //#warning USE_SD_INTERFACE_WITH_SPI
 #include "MDD-File-System/SD-SPI.h"
+#elif (WIN == 1 || NIX == 1)
+// SIL without a storage image, the files are kept by stdio
 #else
 #error Must define a file system media interface
 #endif // USE_AT45D_FLASH
@@ -61,7 +68,10 @@
 
 // Comment this line out if you don't intend to format your card
 // Writes must be enabled to use the format function
-//#define ALLOW_FORMATS
+// (an SD card is formatted by FSformat, the other media have their own)
+#ifdef USE_SD_INTERFACE_WITH_SPI
+#define ALLOW_FORMATS
+#endif
 
 // Uncomment this definition if you're using directories
 // Writes must be enabled to use directories
@@ -229,6 +239,8 @@
 //#define MDD_EEPROM_FLASH_DRIVE_CAPACITY 14
 #define MDD_EEPROM_FLASH_MAX_NUM_FILES_IN_ROOT 16
 
+#elif (WIN == 1 || NIX == 1)
+
 #else
 
 #error Must define a file system media interface
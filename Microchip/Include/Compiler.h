@@ -115,6 +115,10 @@
 	#define COMPILER_MPLAB_C32
 	#include <p32xxxx.h>
 	#include <plib.h>
+#elif (WIN == 1 || NIX == 1)                    // Host compiler, MatrixPilot SIL build
+	#define COMPILER_HOST
+	#define Nop()
+	#define ClrWdt()
 #else
 	#error Unknown processor or compiler.  See Compiler.h
 #endif
@@ -211,6 +215,12 @@
 			#define Nop()           asm("nop")
 		#endif
 	#endif
+
+	// Host compiler specific defines (SIL)
+	#if defined(COMPILER_HOST)
+		#define far
+		#define FAR
+	#endif
 #endif
 
 #endif
@@ -59,6 +59,13 @@
     #define __PACKED
 #endif
 
+/* long is 64-bit on 64-bit hosts (SIL), the 32-bit types use int there */
+#if defined(__LP64__)
+#define __GENERIC_LONG int
+#else
+#define __GENERIC_LONG long
+#endif
+
 /* get compiler defined type definitions (NULL, size_t, etc) */
 #include <stddef.h> 
 
@@ -73,7 +80,7 @@ typedef enum _BIT { CLEAR = 0, SET } BIT;
 typedef signed int          INT;
 typedef signed char         INT8;
 typedef signed short int    INT16;
-typedef signed long int     INT32;
+typedef signed __GENERIC_LONG INT32;
 
 /* MPLAB C Compiler for PIC18 does not support 64-bit integers */
 #if !defined(__18CXX)
@@ -88,7 +95,7 @@ typedef unsigned short int  UINT16;
 #if defined(__18CXX)
 typedef unsigned short long UINT24;
 #endif
-typedef unsigned long int   UINT32;     /* other name for 32-bit integer */
+typedef unsigned __GENERIC_LONG UINT32; /* other name for 32-bit integer */
 /* MPLAB C Compiler for PIC18 does not support 64-bit integers */
 #if !defined(__18CXX)
 __EXTENSION typedef unsigned long long  UINT64;
@@ -341,13 +348,13 @@ typedef unsigned char           UCHAR8;
 
 typedef unsigned char           BYTE;                           /* 8-bit unsigned  */
 typedef unsigned short int      WORD;                           /* 16-bit unsigned */
-typedef unsigned long           DWORD;                          /* 32-bit unsigned */
+typedef unsigned __GENERIC_LONG DWORD;                          /* 32-bit unsigned */
 /* MPLAB C Compiler for PIC18 does not support 64-bit integers */
 __EXTENSION
 typedef unsigned long long      QWORD;                          /* 64-bit unsigned */
 typedef signed char             CHAR;                           /* 8-bit signed    */
 typedef signed short int        SHORT;                          /* 16-bit signed   */
-typedef signed long             LONG;                           /* 32-bit signed   */
+typedef signed __GENERIC_LONG   LONG;                           /* 32-bit signed   */
 /* MPLAB C Compiler for PIC18 does not support 64-bit integers */
 __EXTENSION
 typedef signed long long        LONGLONG;                       /* 64-bit signed   */
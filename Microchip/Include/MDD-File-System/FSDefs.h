@@ -279,7 +279,7 @@ typedef struct
     BYTE        SecPerClus;     // The number of sectors per cluster in the data region
     BYTE        type;           // The file system type of the partition (FAT12, FAT16 or FAT32)
     BYTE        mount;          // Device mount flag (TRUE if disk was mounted successfully, FALSE otherwise)
-#if defined __PIC32MX__ || defined __C30__
+#if defined __PIC32MX__ || defined __C30__ || defined COMPILER_HOST
 } __attribute__ ((packed)) DISK;
 #else
 } DISK;
@@ -298,7 +298,7 @@ typedef struct
     typedef struct
     {
         unsigned char array[3];
-#if defined __PIC32MX__ || defined __C30__
+#if defined __PIC32MX__ || defined __C30__ || defined COMPILER_HOST
     } __attribute__ ((packed)) SWORD;
 #else
     } SWORD;
@@ -330,7 +330,7 @@ typedef struct {
     BYTE  BootSec_VolID[4];         // Volume ID
     BYTE  BootSec_VolLabel[11];     // Volume Label
     BYTE  BootSec_FSType[8];        // File system type in ASCII. Not used for determination   
-#if defined __PIC32MX__ || defined __C30__
+#if defined __PIC32MX__ || defined __C30__ || defined COMPILER_HOST
     } __attribute__ ((packed)) _BPB_FAT12;
 #else
     } _BPB_FAT12;
@@ -359,7 +359,7 @@ typedef struct {
     BYTE  BootSec_VolID[4];         // Volume ID
     BYTE  BootSec_VolLabel[11];     // Volume Label
     BYTE  BootSec_FSType[8];        // File system type in ASCII. Not used for determination     
-#if defined __PIC32MX__ || defined __C30__
+#if defined __PIC32MX__ || defined __C30__ || defined COMPILER_HOST
     } __attribute__ ((packed)) _BPB_FAT16;
 #else
     } _BPB_FAT16;
@@ -395,7 +395,7 @@ typedef struct {
     BYTE  BootSec_VolID[4];         // Volume ID
     BYTE  BootSec_VolLab[11];       // Volume Label
     BYTE  BootSec_FilSysType[8];    // File system type in ASCII.  Not used for determination  
-#if defined __PIC32MX__ || defined __C30__
+#if defined __PIC32MX__ || defined __C30__ || defined COMPILER_HOST
     } __attribute__ ((packed)) _BPB_FAT32;
 #else
     } _BPB_FAT32;
@@ -456,7 +456,7 @@ typedef struct
     SWORD     PTE_LstPartSect;        // The cylinder-head-sector address of the last sector of the partition
     DWORD     PTE_FrstSect;           // The logical block address of the first sector of the partition
     DWORD     PTE_NumSect;            // The number of sectors in a partition
-#if defined __PIC32MX__ || defined __C30__
+#if defined __PIC32MX__ || defined __C30__ || defined COMPILER_HOST
     } __attribute__ ((packed)) PTE_MBR;
 #else
     } PTE_MBR;
@@ -475,7 +475,7 @@ typedef struct
     PTE_MBR     Partition3;             // The fourth partition table entry
     BYTE        Signature0;             // MBR signature code - equal to 0x55
     BYTE        Signature1;             // MBR signature code - equal to 0xAA
-#if defined __PIC32MX__ || defined __C30__
+#if defined __PIC32MX__ || defined __C30__ || defined COMPILER_HOST
 }__attribute__((packed)) _PT_MBR;
 #else
 }_PT_MBR;
@@ -502,7 +502,7 @@ typedef struct
     BYTE    Reserved[512-sizeof(_BPB_FAT32)-2]; // Reserved space
     BYTE    Signature0;         // Boot sector signature code - equal to 0x55
     BYTE    Signature1;         // Boot sector signature code - equal to 0xAA
-#if defined __PIC32MX__ || defined __C30__
+#if defined __PIC32MX__ || defined __C30__ || defined COMPILER_HOST
     } __attribute__ ((packed)) _BootSec;
 #else
     } _BootSec;
@@ -201,7 +201,7 @@ FSFILE * cwdptr = &cwd;     // Pointer to the current working directory
     #pragma udata
 #endif
 
-#if defined (__C30__) || defined (__PIC32MX__)
+#if defined (__C30__) || defined (__PIC32MX__) || defined (COMPILER_HOST)
     BYTE __attribute__ ((aligned(4)))   gDataBuffer[MEDIA_SECTOR_SIZE];     // The global data sector buffer
     BYTE __attribute__ ((aligned(4)))   gFATBuffer[MEDIA_SECTOR_SIZE];      // The global FAT sector buffer
 #endif
@@ -325,7 +325,7 @@ DIRENTRY LoadDirAttrib(FILEOBJ fo, WORD *fHandle);
     void CacheTime (void);
 #endif
 
-#if defined (__C30__) || defined (__PIC32MX__)
+#if defined (__C30__) || defined (__PIC32MX__) || defined (COMPILER_HOST)
     BYTE ReadByte( BYTE* pBuffer, WORD index );
     WORD ReadWord( BYTE* pBuffer, WORD index );
     DWORD ReadDWord( BYTE* pBuffer, WORD index );
@@ -1651,7 +1651,7 @@ BYTE LoadMBR(DISK *dsk)
          // Technically, the OEM name is not for indication
          // The alternative is to read the CIS from attribute
          // memory.  See the PCMCIA metaformat for more details
-#if defined (__C30__) || defined (__PIC32MX__)
+#if defined (__C30__) || defined (__PIC32MX__) || defined (COMPILER_HOST)
             if ((ReadByte( dsk->buffer, BSI_FSTYPE ) == 'F') && \
             (ReadByte( dsk->buffer, BSI_FSTYPE + 1 ) == 'A') && \
             (ReadByte( dsk->buffer, BSI_FSTYPE + 2 ) == 'T') && \
@@ -1671,7 +1671,7 @@ BYTE LoadMBR(DISK *dsk)
              }
              else
              {
-#if defined (__C30__) || defined (__PIC32MX__)
+#if defined (__C30__) || defined (__PIC32MX__) || defined (COMPILER_HOST)
                 if ((ReadByte( dsk->buffer, BSI_FAT32_FSTYPE ) == 'F') && \
                     (ReadByte( dsk->buffer, BSI_FAT32_FSTYPE + 1 ) == 'A') && \
                     (ReadByte( dsk->buffer, BSI_FAT32_FSTYPE + 2 ) == 'T') && \
@@ -2282,7 +2282,7 @@ int FSformat (char mode, long int serialNumber, char * volumeID)
         // Technically, the OEM name is not for indication
         // The alternative is to read the CIS from attribute
         // memory.  See the PCMCIA metaformat for more details
-#if defined (__C30__) || defined (__PIC32MX__)
+#if defined (__C30__) || defined (__PIC32MX__) || defined (COMPILER_HOST)
         if ((ReadByte( disk->buffer, BSI_FSTYPE ) == 'F') && \
             (ReadByte( disk->buffer, BSI_FSTYPE + 1 ) == 'A') && \
             (ReadByte( disk->buffer, BSI_FSTYPE + 2 ) == 'T') && \
@@ -3621,7 +3621,7 @@ BYTE PopulateEntries(FILEOBJ fo, WORD *fHandle, BYTE mode)
         return CE_BADCACHEREAD;
 
     // copy the contents over
-    strncpy(dir->DIR_Name,fo->name,DIR_NAMECOMP);
+    strncpy((char *)dir,fo->name,DIR_NAMECOMP);     // the name and the extension that follows it
 
     // setup no attributes
     if (mode == DIRECTORY)
@@ -6275,7 +6275,7 @@ BYTE EraseCluster(DISK *disk, DWORD cluster)
 #endif
 
 
-#if defined (__C30__) || defined (__PIC32MX__)
+#if defined (__C30__) || defined (__PIC32MX__) || defined (COMPILER_HOST)
 
 /***************************************************
   Function:
@@ -14,6 +14,10 @@ extern "C" {
 
 void CDCTasks(void);
 
+// Transmit ring for the serial stream when it is sent over USB (USE_CDC_TELEMETRY)
+uint16_t usb_cdc_tx_space(void);
+void usb_cdc_tx_put(uint8_t txchar);
+
 #ifdef __cplusplus
 }
 #endif
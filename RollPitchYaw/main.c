@@ -96,6 +96,11 @@ void dcm_callback_gps_location_updated(void)
 	udb_led_toggle(LED_GREEN);
 }
 
+// Called when the online magnetometer calibration settles
+void dcm_callback_mag_calibrated(void)
+{
+}
+
 // Called at HEARTBEAT_HZ, before sending servo pulses
 void dcm_heartbeat_callback(void) // was called dcm_servo_callback_prepare_outputs()
 {
@@ -0,0 +1,361 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2015 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+// Host side simulator and profiler for Logo flight plans.
+//
+// Links MatrixPilot/flightplan-logo.c with a simple kinematic model of the
+// plane, in place of the navigation, dead reckoning and control code. The
+// plan is flown at 40Hz as fast as the host can run it. The interpreter
+// statistics are printed at the end, and the track can be written as
+// GeoJSON for viewing on a map.
+
+#include "../../MatrixPilot/defines.h"
+#include "../../MatrixPilot/navigate.h"
+#include "../../MatrixPilot/behaviour.h"
+#include "../../MatrixPilot/cameraCntrl.h"
+#include "../../MatrixPilot/config.h"
+#include "../../MatrixPilot/flightplan_logo.h"
+#include "../../libDCM/rmat.h"
+#include "../../libDCM/estWind.h"
+#include "../../libDCM/deadReckoning.h"
+#include "../../libDCM/gpsParseCommon.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#if (LOGO_PROFILE != 1)
+#error "LogoSim needs LOGO_PROFILE set to 1"
+#endif
+
+#define SIM_HZ              40
+#define METERS_PER_DEGREE   111111.0    // 90 units of 1e-7 degrees per meter, as libDCM
+#define MAX_GOALS           4096
+
+// The state the Logo interpreter reads, normally owned by libDCM and MatrixPilot
+union longww IMUlocationx, IMUlocationy, IMUlocationz;
+union longww IMUvelocityz;
+fractional rmat[9];
+int16_t estimatedWind[3];
+uint16_t ground_velocity_magnitudeXY;
+uint16_t air_speed_magnitudeXY;
+int16_t udb_pwIn[NUM_INPUTS + 1];
+int16_t tofinish_line;
+int16_t waypointIndex;
+union bfbts_word desired_behavior;
+struct altit_variables altit;
+
+// The plane
+static double planeX, planeY, planeZ;   // meters from the origin, x East, y North
+static double planeHeading;             // radians, clockwise from North
+static double planeSpeed = DESIRED_SPEED;
+static double turnRate = 25.0;          // degrees per second
+static double climbRate = 2.0;          // meters per second
+
+// The goal set by the Logo interpreter
+static double fromX, fromY, goalX, goalY, goalZ;
+
+// Origin of the relative coordinates
+static double originLat, originLon, originAlt;
+
+struct simPoint {
+	double x, y, z;
+	int16_t index;
+};
+static struct simPoint goals[MAX_GOALS];
+static int numGoals = 0;
+static FILE* track = NULL;
+static int trackPoints = 0;
+
+int16_t FindFirstBitFromLeft(int16_t val)
+{
+	int16_t i = 0;
+
+	if (val != 0)
+	{
+		for (i = 1; i <= 16; i++)
+		{
+			if (val & 0x8000) break;
+			val <<= 1;
+		}
+	}
+	return i;
+}
+
+void setBehavior(int16_t newBehavior)
+{
+	desired_behavior.W = newBehavior;
+}
+
+void set_camera_view(struct relative3D current_view)
+{
+	(void)current_view; // the camera is not simulated
+}
+
+static void set_goal(double fx, double fy, double tx, double ty, double tz)
+{
+	fromX = fx;
+	fromY = fy;
+	goalX = tx;
+	goalY = ty;
+	goalZ = tz;
+	if (numGoals < MAX_GOALS)
+	{
+		goals[numGoals].x = tx;
+		goals[numGoals].y = ty;
+		goals[numGoals].z = tz;
+		goals[numGoals].index = flightplan_logo_index_get();
+		numGoals++;
+	}
+}
+
+#ifdef USE_EXTENDED_NAV
+void navigate_set_goal(struct relative3D_32 fromPoint, struct relative3D_32 toPoint)
+#else
+void navigate_set_goal(struct relative3D fromPoint, struct relative3D toPoint)
+#endif
+{
+	set_goal(fromPoint.x, fromPoint.y, toPoint.x, toPoint.y, toPoint.z);
+}
+
+void navigate_set_goal_height(int16_t z)
+{
+	goalZ = z;
+}
+
+void navigate_compute_bearing_to_goal(void)
+{
+}
+
+int16_t navigate_get_goal(vect3_16t* goal)
+{
+	if (goal != NULL)
+	{
+		goal->x = (int16_t)goalX;
+		goal->y = (int16_t)goalY;
+		goal->z = (int16_t)goalZ;
+	}
+	return (int16_t)goalZ;
+}
+
+struct relative3D dcm_absolute_to_relative(struct waypoint3D absolute)
+{
+	struct relative3D rel;
+
+	rel.z = absolute.z;
+	rel.y = (int16_t)((absolute.y - originLat * 1e7) / 90);
+	rel.x = (int16_t)((absolute.x - originLon * 1e7) / 90 * cos(originLat * M_PI / 180.0));
+	return rel;
+}
+
+static void to_lat_lon(double x, double y, double* lat, double* lon)
+{
+	*lat = originLat + y / METERS_PER_DEGREE;
+	*lon = originLon + x / (METERS_PER_DEGREE * cos(originLat * M_PI / 180.0));
+}
+
+static void track_point(void)
+{
+	double lat, lon;
+
+	if (track == NULL) return;
+	to_lat_lon(planeX, planeY, &lat, &lon);
+	fprintf(track, "%s\n        [%.7f, %.7f, %.1f]", trackPoints ? "," : "", lon, lat, originAlt + planeZ);
+	trackPoints++;
+}
+
+// Turn towards the goal at a limited rate, and climb or descend towards
+// its height, then update the dead reckoning state from the new position
+static void fly(double dt)
+{
+	double dx = goalX - planeX;
+	double dy = goalY - planeY;
+	double legX = goalX - fromX;
+	double legY = goalY - fromY;
+	double legLength = sqrt(legX * legX + legY * legY);
+	double error = atan2(dx, dy) - planeHeading;
+	double maxTurn = turnRate * M_PI / 180.0 * dt;
+	double maxClimb = climbRate * dt;
+
+	while (error > M_PI) error -= 2 * M_PI;
+	while (error < -M_PI) error += 2 * M_PI;
+	if (error > maxTurn) error = maxTurn;
+	if (error < -maxTurn) error = -maxTurn;
+	planeHeading += error;
+
+	planeX += planeSpeed * sin(planeHeading) * dt;
+	planeY += planeSpeed * cos(planeHeading) * dt;
+	if (goalZ - planeZ > maxClimb) planeZ += maxClimb;
+	else if (planeZ - goalZ > maxClimb) planeZ -= maxClimb;
+	else planeZ = goalZ;
+
+	IMUlocationx.WW = (int32_t)(planeX * 65536.0);
+	IMUlocationy.WW = (int32_t)(planeY * 65536.0);
+	IMUlocationz.WW = (int32_t)(planeZ * 65536.0);
+	rmat[1] = (fractional)(-sin(planeHeading) * RMAX);
+	rmat[4] = (fractional)(cos(planeHeading) * RMAX);
+	ground_velocity_magnitudeXY = air_speed_magnitudeXY = (uint16_t)(planeSpeed * 100);
+
+	// distance to the finish line through the goal, across the leg
+	dx = goalX - planeX;
+	dy = goalY - planeY;
+	if (legLength > 1.0)
+	{
+		tofinish_line = (int16_t)((dx * legX + dy * legY) / legLength);
+	}
+	else
+	{
+		tofinish_line = (int16_t)sqrt(dx * dx + dy * dy);
+	}
+}
+
+static void write_geojson(void)
+{
+	double lat, lon;
+	int i;
+
+	fprintf(track, "\n      ]\n    }\n  }");
+	for (i = 0; i < numGoals; i++)
+	{
+		to_lat_lon(goals[i].x, goals[i].y, &lat, &lon);
+		fprintf(track, ",\n  { \"type\": \"Feature\", \"properties\": { \"name\": \"goal\", \"instruction\": %d },\n"
+		               "    \"geometry\": { \"type\": \"Point\", \"coordinates\": [%.7f, %.7f, %.1f] } }",
+		        goals[i].index, lon, lat, originAlt + goals[i].z);
+	}
+	fprintf(track, "\n]}\n");
+}
+
+static void usage(const char* name)
+{
+	fprintf(stderr,
+	    "usage: %s [options]\n"
+	    "  -t seconds         longest flight to simulate (default 3600)\n"
+	    "  -l loops           stop after the program has run off its end this many times (default 1)\n"
+	    "  -r                 fly the RTL instructions rather than the main program\n"
+	    "  -s speed           plane speed in meters/second (default DESIRED_SPEED)\n"
+	    "  -T rate            turn rate in degrees/second (default 25)\n"
+	    "  -c rate            climb rate in meters/second (default 2)\n"
+	    "  -o lat,lon,alt     origin of the flight plan (default 0,0,0)\n"
+	    "  -g file            write the track and goals as GeoJSON\n", name);
+	exit(1);
+}
+
+int main(int argc, char** argv)
+{
+	double maxSeconds = 3600;
+	uint32_t maxLoops = 1;
+	int16_t flightplanNum = 0;
+	const char* geojson = NULL;
+	uint32_t tick, ticks;
+	clock_t started;
+	int i;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (argv[i][0] != '-' || argv[i][1] == 0 || argv[i][2] != 0) usage(argv[0]);
+		if (argv[i][1] == 'r')
+		{
+			flightplanNum = 1;
+			continue;
+		}
+		if (i + 1 >= argc) usage(argv[0]);
+		switch (argv[i][1])
+		{
+			case 't': maxSeconds = atof(argv[++i]); break;
+			case 'l': maxLoops = atoi(argv[++i]); break;
+			case 's': planeSpeed = atof(argv[++i]); break;
+			case 'T': turnRate = atof(argv[++i]); break;
+			case 'c': climbRate = atof(argv[++i]); break;
+			case 'o':
+				if (sscanf(argv[++i], "%lf,%lf,%lf", &originLat, &originLon, &originAlt) < 2) usage(argv[0]);
+				break;
+			case 'g': geojson = argv[++i]; break;
+			default: usage(argv[0]);
+		}
+	}
+
+	altit.HeightMargin = HEIGHT_MARGIN;
+	for (i = 0; i <= NUM_INPUTS; i++)
+	{
+		udb_pwIn[i] = 3000;
+	}
+	rmat[4] = RMAX;
+	fly(0);
+
+	if (geojson != NULL)
+	{
+		track = fopen(geojson, "w");
+		if (track == NULL)
+		{
+			perror(geojson);
+			return 1;
+		}
+		fprintf(track, "{ \"type\": \"FeatureCollection\", \"features\": [\n"
+		               "  { \"type\": \"Feature\", \"properties\": { \"name\": \"track\" },\n"
+		               "    \"geometry\": { \"type\": \"LineString\", \"coordinates\": [");
+	}
+
+	started = clock();
+	ticks = (uint32_t)(maxSeconds * SIM_HZ);
+	flightplan_logo_begin(flightplanNum);
+	for (tick = 0; tick < ticks && logo_profile.restarts < maxLoops; tick++)
+	{
+		fly(1.0 / SIM_HZ);
+		flightplan_logo_update();
+		if (tick % SIM_HZ == 0) track_point();
+	}
+	track_point();
+
+	printf("simulated %.1f seconds of flight in %.1f ms\n", (double)tick / SIM_HZ,
+	       (double)(clock() - started) * 1000.0 / CLOCKS_PER_SEC);
+	printf("goals flown to        %d\n", numGoals);
+	printf("program restarts      %u\n", (unsigned)logo_profile.restarts);
+	printf("interpreter runs      %u\n", (unsigned)logo_profile.cycles);
+	printf("instructions          %u\n", (unsigned)logo_profile.instructions);
+	printf("runs at the limit     %u (MAX_INSTRUCTIONS_PER_CYCLE %d)\n",
+	       (unsigned)logo_profile.cyclesAtLimit, MAX_INSTRUCTIONS_PER_CYCLE);
+	printf("stack high water      %d of %d\n", logo_profile.maxStackDepth, LOGO_STACK_DEPTH - 1);
+	printf("instructions per run:\n");
+	for (i = 0; i <= MAX_INSTRUCTIONS_PER_CYCLE; i++)
+	{
+		if (logo_profile.perCycle[i] != 0)
+		{
+			printf("  %3d %8u\n", i, (unsigned)logo_profile.perCycle[i]);
+		}
+	}
+	if (logo_profile.maxStackDepth >= LOGO_STACK_DEPTH - 1)
+	{
+		printf("warning: the stack was full, deeper REPEAT, IF or DO blocks were dropped\n");
+	}
+	if (logo_profile.cyclesAtLimit != 0)
+	{
+		printf("warning: some runs stopped at MAX_INSTRUCTIONS_PER_CYCLE before reaching a FLY command\n");
+	}
+
+	if (track != NULL)
+	{
+		write_geojson();
+		fclose(track);
+	}
+	return 0;
+}
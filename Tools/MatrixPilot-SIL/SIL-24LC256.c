@@ -29,6 +29,10 @@
 
 #define MCP24LC256_COMMAND  0xA0
 
+// Number of times the end of a page write is polled for straight away, before
+// leaving it to the heartbeat. A page write takes up to 5ms.
+#define MCP24LC256_ACK_POLLS 100
+
 enum MCP24LC256_STATES
 {
 	MCP24LC256_STATE_STOPPED,
@@ -38,19 +42,18 @@ enum MCP24LC256_STATES
 	MCP24LC256_STATE_FAILED_TRX,
 };
 
-uint16_t MCP24LC256_write_address;
-uint16_t MCP24LC256_write_size;
-uint8_t commandData[4] = {0x00, 0x00}; 
-uint16_t MCP24LC256_state = MCP24LC256_STATE_STOPPED;
-uint8_t* MCP24LC256_pwrBuffer = NULL;
-uint16_t MCP24LC256_Timer = 0;
-NVMemory_callbackFunc pcallerCallback = NULL;
-uint16_t nv_memory_service_handle = INVALID_HANDLE;
+static uint16_t MCP24LC256_write_address;
+static uint16_t MCP24LC256_write_size;
+static uint8_t commandData[4] = {0x00, 0x00}; 
+static uint16_t MCP24LC256_state = MCP24LC256_STATE_STOPPED;
+static uint8_t* MCP24LC256_pwrBuffer = NULL;
+static uint16_t MCP24LC256_Timer = 0;
+static NVMemory_callbackFunc pcallerCallback = NULL;
+static uint16_t nv_memory_service_handle = INVALID_HANDLE;
 
-boolean MCP24LC256_write_chunk();
-//void (*callbackWriteDone)(void);
-void NVMemory_callback(void);
-void MCP24LC256_callback(boolean I2CtrxOK);
+static boolean MCP24LC256_write_chunk(void);
+static void NVMemory_callback(void) __attribute__ ((unused)); // quiet warning - is called via function pointer path
+static void MCP24LC256_callback(boolean I2CtrxOK);
 
 
 void nv_memory_service(void)
@@ -58,10 +61,10 @@ void nv_memory_service(void)
 	switch (MCP24LC256_state)
 	{
 		case MCP24LC256_STATE_WAITING_WRITE:
-			I2C1_CheckACK(MCP24LC256_COMMAND, &MCP24LC256_callback);
+			I2C1_CheckAck(MCP24LC256_COMMAND, &MCP24LC256_callback);
 			break;
 		case MCP24LC256_STATE_FAILED_TRX:
-			I2C1_CheckACK(MCP24LC256_COMMAND, &MCP24LC256_callback);
+			I2C1_CheckAck(MCP24LC256_COMMAND, &MCP24LC256_callback);
 			break;
 	}
 }
@@ -112,7 +115,7 @@ boolean udb_nv_memory_write(uint8_t* wrBuffer, uint16_t address, uint16_t wrSize
 	return MCP24LC256_write_chunk();
 }
 
-boolean MCP24LC256_write_chunk()
+static boolean MCP24LC256_write_chunk(void)
 {
 	uint16_t writeSize = MCP24LC256_write_size;
 	// Truncate write at page boundary
@@ -151,18 +154,25 @@ boolean MCP24LC256_write_chunk()
 	return true;
 }
 
-void NVMemory_callback(void)
+static void NVMemory_callback(void)
 {
 }
 
-void MCP24LC256_callback(boolean I2CtrxOK)
+static void MCP24LC256_callback(boolean I2CtrxOK)
 {
 	if (I2CtrxOK == false)
 	{
-		MCP24LC256_Timer = 0;
 		// If waiting for write ACK, continue to wait
-		if (MCP24LC256_state != MCP24LC256_STATE_WAITING_WRITE)
+		if (MCP24LC256_state == MCP24LC256_STATE_WAITING_WRITE)
 		{
+			if (++MCP24LC256_Timer < MCP24LC256_ACK_POLLS)
+			{
+				trigger_event(nv_memory_service_handle);
+			}
+		}
+		else
+		{
+			MCP24LC256_Timer = 0;
 			MCP24LC256_state = MCP24LC256_STATE_FAILED_TRX;
 			if (pcallerCallback != NULL) pcallerCallback(true);
 			pcallerCallback = NULL;
@@ -180,6 +190,7 @@ void MCP24LC256_callback(boolean I2CtrxOK)
 		case MCP24LC256_STATE_WRITING:
 			MCP24LC256_Timer = 0;
 			MCP24LC256_state = MCP24LC256_STATE_WAITING_WRITE;
+			trigger_event(nv_memory_service_handle);    // start polling for the end of the page write
 			break;
 		case MCP24LC256_STATE_WAITING_WRITE:
 			MCP24LC256_write_chunk();
@@ -193,5 +204,5 @@ void MCP24LC256_callback(boolean I2CtrxOK)
 	}
 }
 
-#endif // (USE_NV_MEMORY == 1)
+#endif // #if (USE_NV_MEMORY == 1)
 #endif // (WIN == 1 || NIX == 1)
@@ -0,0 +1,80 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2015 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+#if (WIN == 1 || NIX == 1)
+
+#include "../../libUDB/libUDB.h"
+
+#if (SILSIM_MEDIA == SILSIM_MEDIA_AT45D)
+
+#include "../../Microchip/FSconfig.h"
+#include "../../libFlashFS/AT45D.h"
+#include "SIL-media.h"
+#include <string.h>
+
+// The dataflash image has the layout of the chip, MDD_AT45D_FLASH_DRIVE_CAPACITY
+// pages of PAGE_SIZE bytes, and the driver keeps a sector in the first 512
+// bytes of each page, as AT45D.c does
+#define AT45D_IMAGE_PATH    "AT45D.bin"
+#define AT45D_IMAGE_SIZE    ((uint32_t)MDD_AT45D_FLASH_DRIVE_CAPACITY * PAGE_SIZE)
+
+static uint8_t* AT45D_image = NULL;
+
+void init_dataflash(void)
+{
+	if (AT45D_image == NULL)
+	{
+		AT45D_image = sil_media_map(AT45D_IMAGE_PATH, AT45D_IMAGE_SIZE, 0xFF);
+	}
+}
+
+void ReadSector(uint16_t sector, uint8_t* buffer)
+{
+	if (AT45D_image == NULL || sector >= MDD_AT45D_FLASH_DRIVE_CAPACITY)
+	{
+		memset(buffer, 0xFF, MEDIA_SECTOR_SIZE);
+		return;
+	}
+	memcpy(buffer, AT45D_image + (uint32_t)sector * PAGE_SIZE, MEDIA_SECTOR_SIZE);
+}
+
+void WriteSector(uint16_t sector, uint8_t* buffer)
+{
+	if (AT45D_image == NULL || sector >= MDD_AT45D_FLASH_DRIVE_CAPACITY) return;
+	memcpy(AT45D_image + (uint32_t)sector * PAGE_SIZE, buffer, MEDIA_SECTOR_SIZE);
+}
+
+#ifdef USE_AT45D_DMA
+
+// Writes to the image are complete as soon as WriteSector returns
+void AT45D_trigger_service(void)
+{
+}
+
+void AT45D_Flush(void)
+{
+	sil_media_sync();
+}
+
+#endif // USE_AT45D_DMA
+
+#endif // SILSIM_MEDIA_AT45D
+
+#endif // (WIN == 1 || NIX == 1)
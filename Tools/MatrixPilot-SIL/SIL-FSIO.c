@@ -0,0 +1,32 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2015 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+// The MDD file system of the board, built for the host when it runs on a
+// storage image (SILSIM_MEDIA in SIL-udb.h)
+
+#if (WIN == 1 || NIX == 1)
+
+#include "../../libUDB/libUDB.h"
+
+#if (SILSIM_MEDIA != SILSIM_MEDIA_HOST)
+#include "../../Microchip/MDD-File-System/FSIO.c"
+#endif
+
+#endif // (WIN == 1 || NIX == 1)
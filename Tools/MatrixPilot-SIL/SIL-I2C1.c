@@ -27,28 +27,98 @@
 
 #if (USE_I2C1_DRIVER == 1)
 
+#include "SIL-eeprom.h"
+
+// The 24LC256 on I2C1 is emulated over the EEPROM image, see SIL-eeprom.c.
+// Transfers complete in an event, as they do in the I2C interrupt on the
+// board, so the nv memory services run as they would there, at host speed.
+
+#define MCP24LC256_COMMAND  0xA0
+#define MCP24LC256_SIZE     0x8000
+#define MCP24LC256_PAGE     0x40
+
+static boolean I2C1_busy = false;
+static boolean I2C1_result;
+static I2C_callbackFunc I2C1_callback = NULL;
+static uint16_t I2C1_event_handle = INVALID_HANDLE;
+
+static void I2C1_complete(void)
+{
+	I2C1_busy = false;
+	if (I2C1_callback != NULL) I2C1_callback(I2C1_result);
+}
+
+static boolean I2C1_start(uint8_t addr, I2C_callbackFunc callback)
+{
+	if (I2C1_busy) return false;
+	I2C1_busy = true;
+	I2C1_callback = callback;
+	I2C1_result = ((addr & 0xFE) == MCP24LC256_COMMAND);    // nothing else answers on the bus
+	trigger_event(I2C1_event_handle);
+	return true;
+}
+
+static uint16_t I2C1_address(const uint8_t* cmd, uint8_t cmd_len)
+{
+	return (cmd_len >= 2) ? (((uint16_t)cmd[0] << 8) | cmd[1]) & (MCP24LC256_SIZE - 1) : 0;
+}
+
 void I2C1_Init(void)
 {
+	I2C1_event_handle = register_event(&I2C1_complete);
 }
 
 // Trigger the I2C1 service routine to run at low priority
-void I2C1_Trigger(void)
+void I2C1_trigger_service(void)
 {
 }
 
+boolean I2C1_Normal(void)
+{
+	return true;
+}
+
 boolean I2C1_Write(uint8_t addr, const uint8_t* cmd, uint8_t cmd_len, uint8_t* data, uint16_t data_len, I2C_callbackFunc callback)
 {
+	uint8_t* image = sil_eeprom_image();
+	uint16_t address = I2C1_address(cmd, cmd_len);
+	uint16_t i;
+
+	if (!I2C1_start(addr, callback)) return false;
+	if (I2C1_result)
+	{
+		// a page write wraps round within its page
+		for (i = 0; i < data_len; i++)
+		{
+			image[(address & ~(MCP24LC256_PAGE - 1)) | ((address + i) & (MCP24LC256_PAGE - 1))] = data[i];
+		}
+		EEPROMdirty = 1;
+	}
 	return true;
 }
 
 boolean I2C1_Read(uint8_t addr, const uint8_t* cmd, uint8_t cmd_len, uint8_t* data, uint16_t data_len, I2C_callbackFunc callback, uint16_t mode)
 {
+	uint8_t* image = sil_eeprom_image();
+	uint16_t address = I2C1_address(cmd, cmd_len);
+	uint16_t i;
+
+	if (!I2C1_start(addr, callback)) return false;
+	if (I2C1_result)
+	{
+		for (i = 0; i < data_len; i++)
+		{
+			data[i] = image[(address + i) & (MCP24LC256_SIZE - 1)];
+		}
+	}
 	return true;
 }
+
 // Only send command byte to check for ACK.
-boolean I2C1_CheckACK(uint8_t addr, I2C_callbackFunc pCallback)
+// The page write has always finished by the time this is asked
+boolean I2C1_CheckAck(uint8_t addr, I2C_callbackFunc pCallback)
 {
-	return true;
+	return I2C1_start(addr, pCallback);
 }
 
 #endif // USE_I2C1_DRIVER
@@ -0,0 +1,99 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2015 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+#if (WIN == 1 || NIX == 1)
+
+#include "../../libUDB/libUDB.h"
+
+#if (SILSIM_MEDIA == SILSIM_MEDIA_SD)
+
+#include "MDD-File-System/FSIO.h"
+#include "SIL-media.h"
+#include <string.h>
+
+// The SD card is an image of SD_IMAGE_SECTORS sectors, 32MB, which
+// filesys_format() partitions and formats as FAT16 when it is blank.
+// This replaces SD-SPI.c
+#define SD_IMAGE_PATH       "SD.img"
+#define SD_IMAGE_SECTORS    65536UL
+
+static uint8_t* SD_image = NULL;
+static MEDIA_INFORMATION mediaInformation;
+
+void MDD_SDSPI_InitIO(void)
+{
+	if (SD_image == NULL)
+	{
+		SD_image = sil_media_map(SD_IMAGE_PATH, SD_IMAGE_SECTORS * MEDIA_SECTOR_SIZE, 0x00);
+	}
+}
+
+BYTE MDD_SDSPI_MediaDetect(void)
+{
+	return (SD_image != NULL);
+}
+
+MEDIA_INFORMATION* MDD_SDSPI_MediaInitialize(void)
+{
+	mediaInformation.validityFlags.bits.sectorSize = TRUE;
+	mediaInformation.sectorSize = MEDIA_SECTOR_SIZE;
+	mediaInformation.errorCode = (SD_image != NULL) ? MEDIA_NO_ERROR : MEDIA_DEVICE_NOT_PRESENT;
+	return &mediaInformation;
+}
+
+DWORD MDD_SDSPI_ReadCapacity(void)
+{
+	return (SD_IMAGE_SECTORS - 1);  // the last sector, as SD-SPI.c
+}
+
+WORD MDD_SDSPI_ReadSectorSize(void)
+{
+	return MEDIA_SECTOR_SIZE;
+}
+
+BYTE MDD_SDSPI_SectorRead(DWORD sector_addr, BYTE* buffer)
+{
+	if (SD_image == NULL || sector_addr >= SD_IMAGE_SECTORS) return FALSE;
+	memcpy(buffer, SD_image + sector_addr * MEDIA_SECTOR_SIZE, MEDIA_SECTOR_SIZE);
+	return TRUE;
+}
+
+BYTE MDD_SDSPI_SectorWrite(DWORD sector_addr, BYTE* buffer, BYTE allowWriteToZero)
+{
+	if (SD_image == NULL || sector_addr >= SD_IMAGE_SECTORS) return FALSE;
+	if (sector_addr == 0 && !allowWriteToZero) return FALSE;
+	memcpy(SD_image + sector_addr * MEDIA_SECTOR_SIZE, buffer, MEDIA_SECTOR_SIZE);
+	return TRUE;
+}
+
+BYTE MDD_SDSPI_WriteProtectState(void)
+{
+	return FALSE;
+}
+
+BYTE MDD_SDSPI_ShutdownMedia(void)
+{
+	sil_media_sync();
+	return 0;
+}
+
+#endif // SILSIM_MEDIA_SD
+
+#endif // (WIN == 1 || NIX == 1)
@@ -9,6 +9,8 @@
 #if (WIN == 1 || NIX == 1)
 
 #include "../../libUDB/libUDB.h"
+#include "SIL-eeprom.h"
+#include "SIL-media.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -17,71 +19,48 @@
 #define EE_PAGE_COUNT  1024
 #define EE_DATA_SIZE   (EE_PAGE_SIZE * EE_PAGE_COUNT)
 
-uint8_t EEPROMbuffer[EE_DATA_SIZE];
-boolean EEPROMloaded = 0;
+// The 24LC256 is an image file mapped into memory, shared by these calls
+// and by the emulation of the chip on I2C1 for the nv memory services
+static uint8_t* EEPROMbuffer = NULL;
 boolean EEPROMdirty = 0;
 
-void loadEEPROMFileIfNeeded(void)
+uint8_t* sil_eeprom_image(void)
 {
-	long n;
-	FILE* fp;
-
-	if (EEPROMloaded) return;
-	
-	EEPROMloaded = 1;
-	fp = fopen(EEPROMFilePath, "r");
-	if (!fp) {
-		memset(EEPROMbuffer, 0, EE_DATA_SIZE);
-		return;
-	}
-	n = fread(EEPROMbuffer, EE_PAGE_SIZE, EE_PAGE_COUNT, fp);
-	fclose(fp);
-	if (n < EE_PAGE_COUNT) {
-		memset(EEPROMbuffer, 0, EE_DATA_SIZE);
+	if (EEPROMbuffer == NULL)
+	{
+		EEPROMbuffer = sil_media_map(EEPROMFilePath, EE_DATA_SIZE, 0xFF);
 	}
+	return EEPROMbuffer;
 }
 
 void writeEEPROMFileIfNeeded(void)
 {
-	FILE* fp;
-
 	if (!EEPROMdirty) return;
-	
-	fp = fopen(EEPROMFilePath, "w");
-	if (!fp) {
-		return;
-	}
-	fwrite(EEPROMbuffer, EE_PAGE_SIZE, EE_PAGE_COUNT, fp);
-	fclose(fp);
+
+	sil_media_sync();
 	EEPROMdirty = 0;
 }
 
 void eeprom_ByteWrite(uint16_t address, uint8_t data)
 {
-	loadEEPROMFileIfNeeded();
-	EEPROMbuffer[address] = data;
+	sil_eeprom_image()[address] = data;
 	EEPROMdirty = 1;
 }
 
 void eeprom_ByteRead(uint16_t address, uint8_t *data)
 {
-	loadEEPROMFileIfNeeded();
-	*data = EEPROMbuffer[address];
-	EEPROMdirty = 1;
+	*data = sil_eeprom_image()[address];
 }
 
 void eeprom_PageWrite(uint16_t address, uint8_t *data, uint8_t numbytes)
 {
-	loadEEPROMFileIfNeeded();
-	memcpy(EEPROMbuffer+address, data, numbytes);
+	memcpy(sil_eeprom_image()+address, data, numbytes);
 	EEPROMdirty = 1;
 }
 
 void eeprom_SequentialRead(uint16_t address, uint8_t *data, uint16_t numbytes)
 {
-	loadEEPROMFileIfNeeded();
-	memcpy(data, EEPROMbuffer+address, numbytes);
-	EEPROMdirty = 1;
+	memcpy(data, sil_eeprom_image()+address, numbytes);
 }
 
 #endif // (WIN == 1 || NIX == 1)
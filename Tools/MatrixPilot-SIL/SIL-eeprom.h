@@ -9,6 +9,10 @@
 #ifndef MatrixPilot_SIL_SIL_eeprom_h
 #define MatrixPilot_SIL_SIL_eeprom_h
 
+extern boolean EEPROMdirty;
+
+// The 24LC256 image, mapped on first use
+uint8_t* sil_eeprom_image(void);
 void writeEEPROMFileIfNeeded(void);
 
 #endif
@@ -13,15 +13,17 @@
 #include "../../libUDB/events.h"
 #include "SIL-events.h"
 
-#define MAX_EVENTS 16
+#define MAX_SIL_EVENTS 32  // room for the nv memory services as well
+// Events triggered by events are run straight away, up to this many rounds
+#define MAX_EVENT_PASSES 64
 typedef void (*event_callback_t)(void);
-event_callback_t events[MAX_EVENTS];
+event_callback_t events[MAX_SIL_EVENTS];
 int16_t numEvents = 0;
-int16_t eventFlags = 0;
+uint32_t eventFlags = 0;
 
 uint16_t register_event(void (*event_callback)(void))
 {
-	if (numEvents >= MAX_EVENTS) return INVALID_HANDLE;
+	if (numEvents >= MAX_SIL_EVENTS) return INVALID_HANDLE;
 	events[numEvents++] = event_callback;
 	return numEvents-1;
 }
@@ -34,21 +36,25 @@ uint16_t register_event_p(void (*event_callback)(void), eventPriority priority)
 
 void trigger_event(uint16_t hEvent)
 {
-	eventFlags |= (1 << hEvent);
+	if (hEvent >= MAX_SIL_EVENTS) return;
+	eventFlags |= (1UL << hEvent);
 }
 
 void process_queued_events(void)
 {
+	uint32_t flags;
+	int16_t passes = 0;
 	int16_t i;
 
-	if (eventFlags == 0) return;
-	
-	for (i = 0; i < MAX_EVENTS; i++) {
-		if (eventFlags & (1 << i)) {
-			events[i]();
+	while (eventFlags != 0 && passes++ < MAX_EVENT_PASSES) {
+		flags = eventFlags;
+		eventFlags = 0;
+		for (i = 0; i < MAX_SIL_EVENTS; i++) {
+			if (flags & (1UL << i)) {
+				events[i]();
+			}
 		}
 	}
-	eventFlags = 0;
 }
 
 #endif // (WIN == 1 || NIX == 1)
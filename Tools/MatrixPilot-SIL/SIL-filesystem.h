@@ -26,11 +26,11 @@
 //	int foo;
 //} FSFILE;
 
-#define FSFILE FILE
-
-int FSInit(void);
-FSFILE* FSfopen(const char* fileName, const char* mode);
-int FSfclose(FSFILE* fo);
-size_t FSfwrite(const void* data_to_write, size_t size, size_t n, FSFILE* stream);
+// Without a storage image (SILSIM_MEDIA_HOST) the files are kept in the
+// working directory, the FSIO calls go straight to stdio
+#define FSFILE   FILE
+#define FSfopen  fopen
+#define FSfclose fclose
+#define FSfwrite fwrite
 
 
@@ -0,0 +1,162 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2015 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+#if (WIN == 1 || NIX == 1)
+
+#include "../../libUDB/libUDB.h"
+#include "SIL-media.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef WIN
+#define SIL_WINDOWS_INCS
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // WIN
+
+#define MAX_MEDIA 4
+
+typedef struct tag_media {
+	uint8_t* image;
+	uint32_t size;
+#ifdef WIN
+	HANDLE file;
+	HANDLE mapping;
+#endif
+} media_t;
+
+static media_t media[MAX_MEDIA];
+static int16_t num_media = 0;
+
+#ifdef WIN
+
+static uint8_t* media_map_file(media_t* m, const char* path, uint32_t size, uint8_t fill)
+{
+	DWORD length;
+	DWORD written;
+	uint8_t buffer[512];
+
+	m->file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (m->file == INVALID_HANDLE_VALUE) return NULL;
+	length = GetFileSize(m->file, NULL);
+	if (length < size)
+	{
+		memset(buffer, fill, sizeof(buffer));
+		SetFilePointer(m->file, 0, NULL, FILE_END);
+		while (length < size)
+		{
+			DWORD n = (size - length < sizeof(buffer)) ? size - length : sizeof(buffer);
+			if (!WriteFile(m->file, buffer, n, &written, NULL) || written != n) break;
+			length += n;
+		}
+	}
+	m->mapping = CreateFileMappingA(m->file, NULL, PAGE_READWRITE, 0, size, NULL);
+	if (m->mapping == NULL)
+	{
+		CloseHandle(m->file);
+		return NULL;
+	}
+	return (uint8_t*)MapViewOfFile(m->mapping, FILE_MAP_WRITE, 0, 0, size);
+}
+
+static void media_sync_file(media_t* m)
+{
+	FlushViewOfFile(m->image, m->size);
+}
+
+#else
+
+static uint8_t* media_map_file(media_t* m, const char* path, uint32_t size, uint8_t fill)
+{
+	struct stat st;
+	uint8_t buffer[512];
+	uint8_t* image;
+	int fd;
+
+	fd = open(path, O_RDWR | O_CREAT, 0644);
+	if (fd < 0) return NULL;
+	if (fstat(fd, &st) == 0 && (uint32_t)st.st_size < size)
+	{
+		uint32_t length = (uint32_t)st.st_size;
+
+		memset(buffer, fill, sizeof(buffer));
+		lseek(fd, 0, SEEK_END);
+		while (length < size)
+		{
+			uint32_t n = (size - length < sizeof(buffer)) ? size - length : sizeof(buffer);
+			if (write(fd, buffer, n) != (ssize_t)n) break;
+			length += n;
+		}
+	}
+	image = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);  // the mapping keeps the file open
+	return (image == MAP_FAILED) ? NULL : image;
+}
+
+static void media_sync_file(media_t* m)
+{
+	msync(m->image, m->size, MS_ASYNC);
+}
+
+#endif // WIN
+
+uint8_t* sil_media_map(const char* path, uint32_t size, uint8_t fill)
+{
+	media_t* m;
+
+	if (num_media >= MAX_MEDIA) return NULL;
+	m = &media[num_media];
+	memset(m, 0, sizeof(media_t));
+	m->image = media_map_file(m, path, size, fill);
+	if (m->image == NULL)
+	{
+		// keep running, but without keeping the contents
+		printf("failed to map %s, using memory instead\r\n", path);
+		m->image = malloc(size);
+		if (m->image == NULL) return NULL;
+		memset(m->image, fill, size);
+	}
+	else
+	{
+		m->size = size;
+	}
+	num_media++;
+	return m->image;
+}
+
+void sil_media_sync(void)
+{
+	int16_t i;
+
+	for (i = 0; i < num_media; i++)
+	{
+		if (media[i].size != 0)
+		{
+			media_sync_file(&media[i]);
+		}
+	}
+}
+
+#endif // (WIN == 1 || NIX == 1)
@@ -0,0 +1,37 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2015 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef SIL_MEDIA_H
+#define SIL_MEDIA_H
+
+
+// The storage devices of the board are kept in image files in the working
+// directory, mapped into memory so they are read and written at host speed
+// and survive from one run to the next.
+
+// Map an image file of size bytes, creating it or growing it with bytes
+// of value fill, the erased state of the device
+uint8_t* sil_media_map(const char* path, uint32_t size, uint8_t fill);
+
+// Push the changes to all mapped images out to their files
+void sil_media_sync(void);
+
+
+#endif // SIL_MEDIA_H
@@ -85,6 +85,16 @@ inline int gettimeofday(struct timeval* p, void* tz /* IGNORED */)
 #include "SIL-ui.h"
 #include "SIL-events.h"
 #include "SIL-eeprom.h"
+#if (USE_I2C1_DRIVER == 1)
+#include "../../libUDB/I2C.h"
+#endif
+#if (USE_NV_MEMORY == 1)
+#include "../../libUDB/NV_memory.h"
+#include "../../MatrixPilot/data_storage.h"
+#include "../../MatrixPilot/data_services.h"
+#include "../../MatrixPilot/mission_store.h"
+#include "../../MatrixPilot/flightplan_logo.h"
+#endif
 
 uint16_t udb_heartbeat_counter;
 uint16_t udb_pulse_counter;
@@ -192,6 +202,20 @@ void udb_init(void)
 		                              SILSIM_SERIAL_RC_INPUT_DEVICE,
 		                              SILSIM_SERIAL_RC_INPUT_BAUD);
 	}
+#if (USE_I2C1_DRIVER == 1)
+	I2C1_Init();
+#endif
+#if (USE_NV_MEMORY == 1)
+	nv_memory_init();
+	data_storage_init();
+	data_services_init();
+#if (USE_MISSION_STORE)
+	mission_store_init();
+#endif
+#if (USE_LOGO_STORE)
+	flightplan_logo_store_init();
+#endif
+#endif
 }
 
 #define UDB_WRAP_TIME 1000
@@ -247,6 +271,24 @@ void udb_run(void)
 			udb_heartbeat_40hz_callback(); // Run at 40Hz
 			udb_heartbeat_callback(); // Run at HEARTBEAT_HZ
 
+			if (udb_pulse_counter % (HEARTBEAT_HZ/40) == 0)
+			{
+#if (USE_I2C1_DRIVER == 1)
+				I2C1_trigger_service();
+#endif
+#if (USE_NV_MEMORY == 1)
+				nv_memory_service_trigger();
+				storage_service_trigger();
+				data_services_trigger();
+#if (USE_MISSION_STORE)
+				mission_store_trigger();
+#endif
+#if (USE_LOGO_STORE)
+				flightplan_logo_store_trigger();
+#endif
+#endif
+			}
+
 			sil_ui_update();
 
 //			if (udb_heartbeat_counter % 80 == 0)
@@ -55,6 +55,28 @@ static inline int16_t  __builtin_divsd(const int32_t num,  const int16_t den)  {
 #define MAX_INPUTS      8
 #define MAX_OUTPUTS     8
 
+// Storage for the file system (config.ini and the telemetry logs).
+// SILSIM_MEDIA_HOST keeps them as plain files in the working directory, the
+// others run the MDD file system and the board drivers of libFlashFS on an
+// image of the storage device, kept in the working directory (SIL-media.c).
+#define SILSIM_MEDIA_HOST   0   // stdio files
+#define SILSIM_MEDIA_AT45D  1   // AT45D dataflash of the AUAV3, AT45D.bin
+#define SILSIM_MEDIA_SD     2   // SD card, SD.img
+
+#ifndef SILSIM_MEDIA
+#define SILSIM_MEDIA        SILSIM_MEDIA_HOST
+#endif
+
+#if (SILSIM_MEDIA == SILSIM_MEDIA_AT45D)
+#define USE_AT45D_FLASH
+#elif (SILSIM_MEDIA == SILSIM_MEDIA_SD)
+#define USE_SD_INTERFACE_WITH_SPI
+#endif
+
+#if (SILSIM_MEDIA != SILSIM_MEDIA_HOST) && defined(_MSC_VER)
+#error "The storage images need the MDD file system, which is built with gcc only"
+#endif
+
 extern UDBSocket gpsSocket;
 extern UDBSocket telemetrySocket;
 extern UDBSocket serialSocket;
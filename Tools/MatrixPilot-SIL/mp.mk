@@ -16,10 +16,13 @@ MP_OBJECTS = \
 ../../MatrixPilot/main.o \
 ../../MatrixPilot/MAVFlexiFunctions.o \
 ../../MatrixPilot/MAVLink.o \
+../../MatrixPilot/MAVLogo.o \
+../../MatrixPilot/MAVLogs.o \
 ../../MatrixPilot/MAVMission.o \
 ../../MatrixPilot/MAVParams.o \
 ../../MatrixPilot/MAVUDBExtra.o \
 ../../MatrixPilot/minIni.o \
+../../MatrixPilot/mission_store.o \
 ../../MatrixPilot/mode_switch.o \
 ../../MatrixPilot/mp_osd.o \
 ../../MatrixPilot/navigate.o \
@@ -4,6 +4,7 @@ SIL-ui-mp-term.o \
 SIL-serial.o \
 SIL-dsp.o \
 SIL-eeprom.o \
+SIL-media.o \
 SIL-events.o \
 SIL-24LC256.o \
 SIL-I2C1.o
@@ -33,6 +33,7 @@ void config_save(void) {}
 void udb_heartbeat_40hz_callback(void) {}
 void dcm_heartbeat_callback(void) {}
 void dcm_callback_gps_location_updated(void) {}
+void dcm_callback_mag_calibrated(void) {}
 void udb_serial_callback_received_byte(uint8_t rxchar) {}
 int16_t udb_serial_callback_get_byte_to_send(void) {}
 
@@ -1,6 +1,6 @@
 # this file is included from makefile
 
-modules := MatrixPilot MAVLink libDCM
-incpath := MAVLink/include
+modules := MatrixPilot MAVLink libDCM libFlashFS
+incpath := MAVLink/include Microchip Microchip/Include
 cfgpath := Config
 
@@ -46,9 +46,9 @@
 // dx/dt^2 * ACCEL2DELTAV = cm/sec
 #define ACCEL2DELTAV ((DR_TIMESTEP*GRAVITYM*MAX16)/GRAVITY)
 
-// seconds; the .01 must convert from cm/sec^2 to m/sec^2
-// cm/sec * VELOCITY2LOCATION = meters
-#define VELOCITY2LOCATION (DR_TIMESTEP*.01*MAX16*16.0)
+// seconds
+// cm/sec * VELOCITY2POSITION = centimeters, with 16 fractional bits
+#define VELOCITY2POSITION (DR_TIMESTEP*MAX16*16.0)
 // The factor of 16 is so that the gain is more precise.
 // There is a subsequent right shift by 4 to cancel the multiply by 16.
 
@@ -67,7 +67,12 @@ union longww IMUvelocityz = { 0 };
 
 int16_t forward_ground_speed = 0 ;
 
-// location, as estimated by the IMU
+// position, as estimated by the IMU: centimeters from the origin
+// This is the navigation state, the fractions of a centimeter are kept separately.
+vect3_32t IMUposition = { 0, 0, 0 };
+static uint16_t IMUposition_fraction[3] = { 0, 0, 0 };
+
+// location, as estimated by the IMU, derived from IMUposition
 // high word is meters, low word is fractional meters
 union longww IMUlocationx = { 0 };
 union longww IMUlocationy = { 0 };
@@ -78,19 +83,56 @@ union longww IMUintegralAccelerationx = { 0 };
 union longww IMUintegralAccelerationy = { 0 };
 union longww IMUintegralAccelerationz = { 0 };
 
+// change in vertical velocity from the accelerometers alone, since it was
+// last taken by estAltitude: high word is cm/sec
+int32_t IMUverticalDeltaV = 0;
+
 uint16_t air_speed_3DIMU = 0;
 int16_t total_energy = 0;
 
-// GPSlocation - IMUlocation: meters
+// GPSposition - IMUposition: meters, for telemetry
 fractional locationErrorEarth[] = { 0, 0, 0 };
+// GPSposition - IMUposition: centimeters, limited to +-327 meters
+static int16_t positionErrorEarth[] = { 0, 0, 0 };
 // GPSvelocity - IMUvelocity
 fractional velocityErrorEarth[] = { 0, 0, 0 };
 
+// Add a change of position, in centimeters with 16 fractional bits
+static inline void position_add(int32_t* position, uint16_t* fraction, int32_t delta)
+{
+	union longww accum;
+
+	accum.WW = delta + *fraction;
+	*position += accum._.W1;
+	*fraction = accum._.W0;
+}
+
+// Convert centimeters to meters with 16 fractional bits: 65536 / 100 = 655 + 23/64
+// The result only has the range of the 16 bit meters of IMUlocation.
+static inline int32_t position_to_location(int32_t position)
+{
+	return (position * 655) + ((position * 23) >> 6);
+}
+
+static int16_t position_error(int32_t error)
+{
+	if (error > 32767) return 32767;
+	if (error < -32767) return -32767;
+	return (int16_t)error;
+}
+
 void dead_reckon(void)
 {
 	int16_t air_speed_x, air_speed_y, air_speed_z;
 	union longww accum;
 	union longww energy;
+	int32_t error;
+	int16_t i;
+
+#if (USE_BAROMETER_ALTITUDE == 1)
+	// only estAltitude takes this up, and only when it fuses the barometer
+	IMUverticalDeltaV += __builtin_mulss(((int16_t)(ACCEL2DELTAV)), accelEarth[2]);
+#endif
 
 	if (dcm_flags._.dead_reckon_enable == 1)  // wait for startup of GPS
 	{
@@ -99,10 +141,10 @@ void dead_reckon(void)
 		IMUintegralAccelerationy.WW += __builtin_mulss(((int16_t)(ACCEL2DELTAV)), accelEarth[1]);
 		IMUintegralAccelerationz.WW += __builtin_mulss(((int16_t)(ACCEL2DELTAV)), accelEarth[2]);
 
-		// integrate IMU velocity to update the IMU location	
-		IMUlocationx.WW += (__builtin_mulss(((int16_t)(VELOCITY2LOCATION)), IMUintegralAccelerationx._.W1)>>4);
-		IMUlocationy.WW += (__builtin_mulss(((int16_t)(VELOCITY2LOCATION)), IMUintegralAccelerationy._.W1)>>4);
-		IMUlocationz.WW += (__builtin_mulss(((int16_t)(VELOCITY2LOCATION)), IMUintegralAccelerationz._.W1)>>4);
+		// integrate IMU velocity to update the IMU position
+		position_add(&IMUposition.x, &IMUposition_fraction[0], __builtin_mulss(((int16_t)(VELOCITY2POSITION)), IMUintegralAccelerationx._.W1)>>4);
+		position_add(&IMUposition.y, &IMUposition_fraction[1], __builtin_mulss(((int16_t)(VELOCITY2POSITION)), IMUintegralAccelerationy._.W1)>>4);
+		position_add(&IMUposition.z, &IMUposition_fraction[2], __builtin_mulss(((int16_t)(VELOCITY2POSITION)), IMUintegralAccelerationz._.W1)>>4);
 
 		if (dead_reckon_clock > 0)
 		// apply drift adjustments only while valid GPS data is in force.
@@ -114,16 +156,16 @@ void dead_reckon(void)
 			IMUintegralAccelerationy.WW += __builtin_mulss(DR_FILTER_GAIN, velocityErrorEarth[1]);
 			IMUintegralAccelerationz.WW += __builtin_mulss(DR_FILTER_GAIN, velocityErrorEarth[2]);
 
-			IMUlocationx.WW += __builtin_mulss(DR_FILTER_GAIN, locationErrorEarth[0]);
-			IMUlocationy.WW += __builtin_mulss(DR_FILTER_GAIN, locationErrorEarth[1]);
-			IMUlocationz.WW += __builtin_mulss(DR_FILTER_GAIN, locationErrorEarth[2]);
+			position_add(&IMUposition.x, &IMUposition_fraction[0], __builtin_mulss(DR_FILTER_GAIN, positionErrorEarth[0]));
+			position_add(&IMUposition.y, &IMUposition_fraction[1], __builtin_mulss(DR_FILTER_GAIN, positionErrorEarth[1]));
+			position_add(&IMUposition.z, &IMUposition_fraction[2], __builtin_mulss(DR_FILTER_GAIN, positionErrorEarth[2]));
 
 			IMUvelocityx.WW = IMUintegralAccelerationx.WW +
-			                  __builtin_mulus(ONE_OVER_TAU, 100*locationErrorEarth[0]);
+			                  __builtin_mulus(ONE_OVER_TAU, positionErrorEarth[0]);
 			IMUvelocityy.WW = IMUintegralAccelerationy.WW +
-			                  __builtin_mulus(ONE_OVER_TAU, 100*locationErrorEarth[1]);
+			                  __builtin_mulus(ONE_OVER_TAU, positionErrorEarth[1]);
 			IMUvelocityz.WW = IMUintegralAccelerationz.WW +
-			                  __builtin_mulus(ONE_OVER_TAU, 100*locationErrorEarth[2]);
+			                  __builtin_mulus(ONE_OVER_TAU, positionErrorEarth[2]);
 
 		}
 		else  // GPS has gotten disconnected
@@ -141,9 +183,15 @@ void dead_reckon(void)
 			dcm_flags._.reckon_req = 0;
 			dead_reckon_clock = DR_PERIOD;
 
-			locationErrorEarth[0] = GPSlocation.x - IMUlocationx._.W1;
-			locationErrorEarth[1] = GPSlocation.y - IMUlocationy._.W1;
-			locationErrorEarth[2] = GPSlocation.z - IMUlocationz._.W1;
+			error = GPSposition.x - IMUposition.x;
+			positionErrorEarth[0] = position_error(error);
+			locationErrorEarth[0] = error / 100;
+			error = GPSposition.y - IMUposition.y;
+			positionErrorEarth[1] = position_error(error);
+			locationErrorEarth[1] = error / 100;
+			error = GPSposition.z - IMUposition.z;
+			positionErrorEarth[2] = position_error(error);
+			locationErrorEarth[2] = error / 100;
 
 			velocityErrorEarth[0] = GPSvelocity.x - IMUintegralAccelerationx._.W1;
 			velocityErrorEarth[1] = GPSvelocity.y - IMUintegralAccelerationy._.W1;
@@ -160,10 +208,16 @@ void dead_reckon(void)
 		IMUvelocityy.WW = 0;
 		IMUvelocityz.WW = 0;
 
-		IMUlocationx.WW = 0;
-		IMUlocationy.WW = 0;
-		IMUlocationz.WW = 0;
+		IMUposition.x = IMUposition.y = IMUposition.z = 0;
+		for (i = 0; i < 3; i++)
+		{
+			IMUposition_fraction[i] = 0;
+		}
 	}
+	IMUlocationx.WW = position_to_location(IMUposition.x);
+	IMUlocationy.WW = position_to_location(IMUposition.y);
+	IMUlocationz.WW = position_to_location(IMUposition.z);
+
 	air_speed_x = IMUvelocityx._.W1 - estimatedWind[0];
 	air_speed_y = IMUvelocityy._.W1 - estimatedWind[1];
 	air_speed_z = IMUvelocityz._.W1 - estimatedWind[2];
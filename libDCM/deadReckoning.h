@@ -27,10 +27,15 @@ extern uint16_t air_speed_3DIMU;
 extern int16_t total_energy;
 extern fractional locationErrorEarth[3];
 
+extern vect3_32t IMUposition;   // centimeters from the origin
+
+// IMUposition in meters with a 16 bit fraction, for the 16 bit navigation users,
+// only valid within about 32 km of the origin
 extern union longww IMUlocationx, IMUlocationy, IMUlocationz;
 extern union longww IMUvelocityx, IMUvelocityy, IMUvelocityz;
 extern union longww IMUintegralAccelerationx;
 extern union longww IMUintegralAccelerationy;
+extern int32_t IMUverticalDeltaV;
 
 extern int16_t forward_ground_speed;
 
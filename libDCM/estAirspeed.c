@@ -20,18 +20,26 @@
 
 
 #include "libDCM.h"
+#include "mathlibNAV.h"
 //#include "../libUDB/barometer.h"
 //#include "estAirspeed.h"
-#include <math.h>
 #include <stdlib.h>
- 
-#define air_gas_constant 8.31432f
-#define air_density_sea_level 1.225f
-#define absolute_null_kelvin 273.15f
- 
-float get_air_density(float static_pressure, float temperature_celsius)
+
+// These use integer arithmetic only, in the units of the barometer driver:
+// pressures in Pascals and temperatures in 0.1 degrees C.
+// Speeds are in cm/sec and air density is in g/m^3.
+
+#define air_density_sea_level 1225  // g/m^3
+#define absolute_null_decikelvin 2732
+
+// 1000 / 287.05 J/(kg.K), the specific gas constant of dry air, scaled by 10000
+#define AIR_DENSITY_FACTOR 34837UL
+
+uint16_t get_air_density(int32_t static_pressure, int16_t temperature)
 {
-	return static_pressure/(air_gas_constant * (temperature_celsius + absolute_null_kelvin));
+	// pressures up to 123kPa do not overflow the product
+	return (uint16_t)(((uint32_t)static_pressure * AIR_DENSITY_FACTOR / 1000) /
+	                  (uint16_t)(temperature + absolute_null_decikelvin));
 }
  
 /**
@@ -43,12 +51,16 @@ float get_air_density(float static_pressure, float temperature_celsius)
  *
  * @param pressure_front pressure inside the pitot/prandl tube
  * @param pressure_ambient pressure at the side of the tube/airplane
- * @param temperature air temperature in degrees celcius
- * @return indicated airspeed in m/s
+ * @param temperature air temperature in 0.1 degrees celcius
+ * @return indicated airspeed in cm/s
  */
-float calc_indicated_airspeed(float pressure_front, float pressure_ambient, float temperature)
+uint16_t calc_indicated_airspeed(int32_t pressure_front, int32_t pressure_ambient, int16_t temperature)
 {
-	return sqrt((2.0f*(pressure_front - pressure_ambient))/air_density_sea_level);
+	int32_t dynamic_pressure = pressure_front - pressure_ambient;
+
+	if (dynamic_pressure <= 0) return 0;
+	// (100 cm/m)^2 * 2 * 1000 g/kg / density
+	return sqrt_long((uint32_t)dynamic_pressure * (20000000UL / air_density_sea_level));
 }
  
 /**
@@ -56,14 +68,18 @@ float calc_indicated_airspeed(float pressure_front, float pressure_ambient, floa
  *
  * Please note that the true airspeed is NOT the groundspeed, because of the effects of wind
  *
- * @param speed current indicated airspeed
+ * @param speed current indicated airspeed in cm/s
  * @param pressure_ambient pressure at the side of the tube/airplane
- * @param temperature air temperature in degrees celcius
- * @return true airspeed in m/s
+ * @param temperature air temperature in 0.1 degrees celcius
+ * @return true airspeed in cm/s
  */
-float calc_true_airspeed_from_indicated(float speed, float pressure_ambient, float temperature)
+uint16_t calc_true_airspeed_from_indicated(uint16_t speed, int32_t pressure_ambient, int16_t temperature)
 {
-	return speed * sqrt(air_density_sea_level/get_air_density(pressure_ambient, temperature));
+	uint16_t ratio;     // density ratio, 2.14 format
+
+	ratio = __builtin_divud((uint32_t)air_density_sea_level << 14, get_air_density(pressure_ambient, temperature));
+	// the square root of the ratio is in 9.7 format
+	return (uint16_t)(__builtin_muluu(speed, sqrt_int(ratio)) >> 7);
 }
  
 /**
@@ -73,10 +89,13 @@ float calc_true_airspeed_from_indicated(float speed, float pressure_ambient, flo
  *
  * @param pressure_front pressure inside the pitot/prandl tube
  * @param pressure_ambient pressure at the side of the tube/airplane
- * @param temperature air temperature in degrees celcius
- * @return true airspeed in m/s
+ * @param temperature air temperature in 0.1 degrees celcius
+ * @return true airspeed in cm/s
  */
-float calc_true_airspeed(float pressure_front, float pressure_ambient, float temperature)
+uint16_t calc_true_airspeed(int32_t pressure_front, int32_t pressure_ambient, int16_t temperature)
 {
-	return sqrt((2.0f*(pressure_front - pressure_ambient))/get_air_density(pressure_ambient, temperature));
+	int32_t dynamic_pressure = pressure_front - pressure_ambient;
+
+	if (dynamic_pressure <= 0) return 0;
+	return sqrt_long((uint32_t)dynamic_pressure * __builtin_divud(20000000UL, get_air_density(pressure_ambient, temperature)));
 }
@@ -21,38 +21,122 @@
 
 #include "libDCM.h"
 #include "gpsData.h"
+#include "deadReckoning.h"
 #include "../libUDB/barometer.h"
 #include "estAltitude.h"
-#include <math.h>
 #include <stdlib.h>
 
 //#define USE_DEBUG_IO
 
+// The barometer altitude is computed without any floating point.
+// The pressure is averaged over the last few barometer readings, and converted
+// to the altitude of the standard atmosphere by interpolating in a table.
+// An offset, set when the origin is recorded, puts the ground at the altitude
+// of the origin. The result is then fused at 40Hz with the vertical
+// acceleration integrated by dead_reckon(), to give the altitude and climb rate.
+
+// Standard atmosphere altitude in centimeters, 44330 * (1 - (p / 101325)^(1/5.255)),
+// every 512 Pascals from 49152 Pascals (about 5700 meters) to 110592 Pascals.
+// Linear interpolation between the entries is good to 10 centimeters.
+#define BARO_TABLE_MIN      49152
+#define BARO_TABLE_SHIFT    9
+#define BARO_TABLE_SIZE     121
+#define BARO_TABLE_MAX      (BARO_TABLE_MIN + ((int32_t)(BARO_TABLE_SIZE - 1) << BARO_TABLE_SHIFT))
+
+static const int32_t baro_altitude_table[BARO_TABLE_SIZE] = {
+	 570115,  562490,  554929,  547429,  539991,  532612,  525293,  518031,
+	 510827,  503678,  496584,  489544,  482557,  475622,  468739,  461906,
+	 455123,  448388,  441702,  435063,  428471,  421924,  415423,  408966,
+	 402553,  396183,  389855,  383570,  377325,  371122,  364958,  358834,
+	 352748,  346701,  340692,  334721,  328786,  322887,  317024,  311196,
+	 305404,  299645,  293921,  288230,  282572,  276947,  271354,  265793,
+	 260263,  254764,  249296,  243858,  238450,  233071,  227722,  222401,
+	 217109,  211845,  206609,  201400,  196219,  191064,  185935,  180833,
+	 175757,  170707,  165681,  160681,  155706,  150755,  145828,  140926,
+	 136047,  131191,  126359,  121549,  116763,  111999,  107257,  102537,
+	  97839,   93162,   88507,   83873,   79260,   74667,   70096,   65544,
+	  61012,   56501,   52009,   47536,   43083,   38649,   34234,   29838,
+	  25460,   21101,   16760,   12437,    8132,    3845,    -425,   -4677,
+	  -8912,  -13130,  -17330,  -21514,  -25682,  -29833,  -33967,  -38086,
+	 -42188,  -46274,  -50345,  -54400,  -58439,  -62463,  -66471,  -70465,
+	 -74443
+};
+
+// number of barometer readings averaged, as a power of 2
+#define BARO_OVERSAMPLE_SHIFT   2
+#define BARO_OVERSAMPLE         (1 << BARO_OVERSAMPLE_SHIFT)
+
+// Complementary filter: the barometer corrects the integrated accelerometer
+// with a time constant of BARO_TAU seconds, using gains of 2/tau and 1/tau^2
+#define BARO_TAU                2.0     // seconds
+#define BARO_DT                 ((int16_t)(65536.0 / 40))   // 40Hz timestep, 0.16 format
+#define BARO_K1_DT              ((int16_t)((2.0 / BARO_TAU) * 65536.0 / 40))
+#define BARO_K2_DT              ((int16_t)((1.0 / (BARO_TAU * BARO_TAU)) * 65536.0 / 40))
+
 // The origin is recorded as the altitude of the plane during power up.
 
 long barometer_pressure_gnd = 0;
 int barometer_temperature_gnd = 0;
 
-static long barometer_altitude;        // above sea level altitude - ASL (millimeters)
-long barometer_pressure;
-int16_t barometer_temperature;
-float sea_level_pressure;
+static long barometer_altitude;         // above sea level altitude - ASL (millimeters)
+long barometer_pressure;                // averaged pressure (Pascals)
+int16_t barometer_temperature;          // units of 0.1 deg C
+
+static int32_t barometer_altitude_offset = 0;   // origin altitude less standard altitude (centimeters)
+#if (USE_BAROMETER_ALTITUDE == 1)
+static int32_t barometer_raw_altitude;          // unfiltered barometer altitude (centimeters)
+
+// latest reading from the barometer callback, taken by estAltitude
+static volatile long barometer_pressure_new;
+static volatile boolean barometer_pressure_ready = false;
+
+static int32_t pressure_samples[BARO_OVERSAMPLE];
+static int32_t pressure_sum = 0;
+static int16_t pressure_index = 0;
+static boolean pressure_valid = false;
+#endif // USE_BAROMETER_ALTITUDE
+
+static int32_t fused_altitude;          // centimeters, 8 fractional bits
+static union longww fused_climb = { 0 };// high word is cm/sec
 
 inline int16_t get_barometer_temperature(void)   { return barometer_temperature; }
 inline long get_barometer_pressure(void)     { return barometer_pressure; }
 inline long get_barometer_altitude(void)     { return barometer_altitude; }
+inline int16_t get_barometer_climb_rate(void)    { return fused_climb._.W1; }
+
+// Standard atmosphere altitude, in centimeters, for a pressure in Pascals
+static int32_t barometer_table_altitude(int32_t pressure)
+{
+	int16_t index;
+	int16_t fraction;
+	int32_t low;
+
+	if (pressure < BARO_TABLE_MIN) pressure = BARO_TABLE_MIN;
+	if (pressure > BARO_TABLE_MAX - 1) pressure = BARO_TABLE_MAX - 1;
+
+	pressure -= BARO_TABLE_MIN;
+	index = (int16_t)(pressure >> BARO_TABLE_SHIFT);
+	fraction = (int16_t)pressure & ((1 << BARO_TABLE_SHIFT) - 1);
+	low = baro_altitude_table[index];
+
+	// the difference between entries is less than 8000 centimeters
+	return low + (__builtin_mulss((int16_t)(baro_altitude_table[index + 1] - low), fraction) >> BARO_TABLE_SHIFT);
+}
 
-int16_t barometerInterval = 0;
 /**
  * @brief Ascertain a reference ambient barometric pressure & temperature
  */
 void altimeter_calibrate(void)
 {
-	int ground_altitude = alt_origin.WW / 100;    // meters
+	int32_t offset;
+
 	barometer_temperature_gnd = barometer_temperature;
 	barometer_pressure_gnd = barometer_pressure;
 
-	sea_level_pressure = ((float)barometer_pressure / powf((1 - (ground_altitude/44330.0)), 5.255));
+	// alt_origin is in centimeters
+	offset = alt_origin.WW - barometer_table_altitude(barometer_pressure_gnd);
+	fused_altitude += (offset - barometer_altitude_offset) << 8;
+	barometer_altitude_offset = offset;
 
 	DPRINT("altimeter_calibrate: ground temp & pres set %i, %li\r\n", barometer_temperature_gnd, barometer_pressure_gnd);
 }
@@ -61,32 +145,82 @@ void altimeter_calibrate(void)
 void udb_barometer_callback(long pressure, int16_t temperature, char status)
 {
 	barometer_temperature = temperature; // units of 0.1 deg C
-	barometer_pressure = pressure; // units are Pascals so this could be reduced to an uint16_t
+	barometer_pressure_new = pressure;   // units are Pascals
+	barometer_pressure_ready = true;
 }
-#endif
+
+// Add the latest barometer reading to the running average
+static void barometer_oversample(void)
+{
+	int16_t i;
+	int32_t pressure = barometer_pressure_new;
+
+	barometer_pressure_ready = false;
+	if (!pressure_valid)
+	{
+		// start the average with copies of the first reading
+		for (i = 0; i < BARO_OVERSAMPLE; i++)
+		{
+			pressure_samples[i] = pressure;
+		}
+		pressure_sum = pressure << BARO_OVERSAMPLE_SHIFT;
+	}
+	else
+	{
+		pressure_sum += pressure - pressure_samples[pressure_index];
+		pressure_samples[pressure_index] = pressure;
+		pressure_index = (pressure_index + 1) & (BARO_OVERSAMPLE - 1);
+	}
+	barometer_pressure = pressure_sum >> BARO_OVERSAMPLE_SHIFT;
+	barometer_raw_altitude = barometer_table_altitude(barometer_pressure) + barometer_altitude_offset;
+
+	if (!pressure_valid)
+	{
+		pressure_valid = true;
+		fused_altitude = barometer_raw_altitude << 8;
+		fused_climb.WW = 0;
+	}
+}
+#endif // USE_BAROMETER_ALTITUDE
 
 /**
- * @brief Calculate an altitude estimate using barometer data
- * @param
- * @return
+ * @brief Update the altitude estimate from the barometer and the accelerometers
+ *
+ * Expected to be called at 40Hz, after dead_reckon() has run.
  */
 void estAltitude(void)
 {
 #if (USE_BAROMETER_ALTITUDE == 1)
-	float pressure_ambient = barometer_pressure;    // Pascals?
-	float barometer_alt;
+	int32_t error;
+	int16_t error16;
+
+	if (barometer_pressure_ready)
+	{
+		barometer_oversample();
+	}
+	if (!pressure_valid)
+	{
+		IMUverticalDeltaV = 0;
+		return;
+	}
+
+	error = barometer_raw_altitude - (fused_altitude >> 8);
+	if (error > 32767) error16 = 32767;
+	else if (error < -32767) error16 = -32767;
+	else error16 = (int16_t)error;
+
+	// climb rate: integrated vertical acceleration, corrected by the barometer
+	fused_climb.WW += IMUverticalDeltaV + __builtin_mulss(error16, BARO_K2_DT);
+	IMUverticalDeltaV = 0;
+
+	// altitude: integrated climb rate, corrected by the barometer
+	fused_altitude += (__builtin_mulss(fused_climb._.W1, BARO_DT) + __builtin_mulss(error16, BARO_K1_DT)) >> 8;
+
+	barometer_altitude = (fused_altitude >> 8) * 10; // millimeters
 
-	if (barometer_pressure_gnd != 0)
-	{		
-		barometer_alt = 44330.0f * ((1-pow((pressure_ambient/sea_level_pressure),(1/5.255f)))); // Meters
-		barometer_altitude = (long)(barometer_alt * 1000); // millimeters
 #ifdef USE_DEBUG_IO
-		// estimate sea level pressure assuming we're still on the ground
-		int ground_altitude = alt_origin.WW / 100; // meters
-		sea_level_pressure = ((float) barometer_pressure / powf((1 - (ground_altitude / 44330.0)), 5.255));
-		// print pressure altitude, pressure and current SLP estimate
-		printf("estAltitude %f, pressure %f, sea level pressure %f\r\n", (double) barometer_alt, (double) (.01 * pressure_ambient), (double) (.01 * sea_level_pressure));
+	// print pressure altitude, pressure and the filtered altitude and climb rate
+	printf("estAltitude %li, pressure %li, altitude %li, climb %i\r\n", barometer_raw_altitude, barometer_pressure, barometer_altitude, fused_climb._.W1);
 #endif
-	}
 #endif // USE_BAROMETER_ALTITUDE
 }
@@ -25,11 +25,12 @@
 
 void udb_barometer_callback(long pressure, int16_t temperature, char status);
 void altimeter_calibrate(void);
-void estAltitude(void);
+void estAltitude(void);             // expected to be called at 40Hz
 
-long get_barometer_altitude(void);
-long get_barometer_pressure(void);
-int16_t get_barometer_temperature(void);
+long get_barometer_altitude(void);  // millimeters
+long get_barometer_pressure(void);  // Pascals
+int16_t get_barometer_temperature(void);    // 0.1 deg C
+int16_t get_barometer_climb_rate(void);     // cm/sec
 
 
 #endif // ESTALTITUDE_H
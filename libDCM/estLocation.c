@@ -28,41 +28,21 @@
 #include "estWind.h"
 
 
-#ifdef USE_EXTENDED_NAV
+// Location of the plane relative to the origin, in centimeters.
+// Latitude and longitude are in units of 1e-7 degrees, which is 10/9 centimeters.
+// The range is about 2000 km from the origin.
 static void location_plane(int32_t* location)
 {
-	location[1] = ((lat_gps.WW - lat_origin.WW)/90); // in meters, range is about 20 miles
-	location[0] = long_scale((lon_gps.WW - lon_origin.WW)/90, cos_lat);
+	location[1] = ((lat_gps.WW - lat_origin.WW) * 10) / 9;
+	location[0] = long_scale(((lon_gps.WW - lon_origin.WW) * 10) / 9, cos_lat);
 #if (USE_BAROMETER_ALTITUDE == 1 ) 
 #warning "using pressure altitude instead of GPS altitude"
-	// division by 100 implies alt_origin is in centimeters; not documented elsewhere
-	// longword result = (longword/10 - longword)/100 : range
-	location[2] = ((get_barometer_altitude()/10) - alt_origin.WW)/100; // height in meters
+	// alt_origin is in centimeters, the barometer altitude is in millimeters
+	location[2] = (get_barometer_altitude()/10) - alt_origin.WW;
 #else
-	location[2] = (alt_sl_gps.WW - alt_origin.WW)/100; // height in meters
+	location[2] = alt_sl_gps.WW - alt_origin.WW;
 #endif // USE_BAROMETER_ALTITUDE
-
-}
-#else // !USE_EXTENDED_NAV
-static void location_plane(int16_t* location)
-{
-	union longbbbb accum_nav;
-
-	accum_nav.WW = ((lat_gps.WW - lat_origin.WW)/90); // in meters, range is about 20 miles
-	location[1] = accum_nav._.W0;
-	accum_nav.WW = long_scale((lon_gps.WW - lon_origin.WW)/90, cos_lat);
-	location[0] = accum_nav._.W0;
-#if (USE_BAROMETER_ALTITUDE == 1 ) 
-#warning "using pressure altitude instead of GPS altitude"
-	// division by 100 implies alt_origin is in centimeters; not documented elsewhere
-	// longword result = (longword/10 - longword)/100 : range
-	accum_nav.WW = ((get_barometer_altitude()/10) - alt_origin.WW)/100; // height in meters
-#else
-	accum_nav.WW = (alt_sl_gps.WW - alt_origin.WW)/100; // height in meters
-#endif // USE_BAROMETER_ALTITUDE
-	location[2] = accum_nav._.W0;
 }
-#endif // USE_EXTENDED_NAV
 
 void estLocation(void)
 {
@@ -70,7 +50,7 @@ void estLocation(void)
 	static int16_t sog_previous = 0;
 	static int16_t climb_rate_previous = 0;
 	static uint16_t velocity_previous = 0;
-	static int16_t location_previous[] = { 0, 0, 0 };
+	static int32_t location_previous[] = { 0, 0, 0 };
 
 	union longbbbb accum;
 	union longww accum_velocity;
@@ -78,11 +58,7 @@ void estLocation(void)
 	int8_t cog_delta;
 	int16_t sog_delta;
 	int16_t climb_rate_delta;
-#ifdef USE_EXTENDED_NAV
 	int32_t location[3];
-#else
-	int16_t location[3];
-#endif // USE_EXTENDED_NAV
 	int16_t location_deltaZ;
 	struct relative2D location_deltaXY;
 	struct relative2D velocity_thru_air;
@@ -146,9 +122,14 @@ void estLocation(void)
 
 	rotate_2D(&location_deltaXY, cog_delta); // this is a key step to account for rotation effects!!
 
-	GPSlocation.x = location[0] + location_deltaXY.x;
-	GPSlocation.y = location[1] + location_deltaXY.y;
-	GPSlocation.z = location[2] + location_deltaZ;
+	GPSposition.x = location[0] + location_deltaXY.x;
+	GPSposition.y = location[1] + location_deltaXY.y;
+	GPSposition.z = location[2] + location_deltaZ;
+
+	// the navigation code works in meters
+	GPSlocation.x = GPSposition.x / 100;
+	GPSlocation.y = GPSposition.y / 100;
+	GPSlocation.z = GPSposition.z / 100;
 
 	location_previous[0] = location[0];
 	location_previous[1] = location[1];
@@ -29,6 +29,7 @@ struct relative3D_32 GPSlocation = { 0, 0, 0 };
 #else
 struct relative3D GPSlocation = { 0, 0, 0 };
 #endif // USE_EXTENDED_NAV
+vect3_32t GPSposition = { 0, 0, 0 };
 struct relative3D GPSvelocity = { 0, 0, 0 };
 int16_t cos_lat = 0;
 int16_t gps_data_age;
@@ -19,11 +19,13 @@
 // along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
 
 
+// GPSposition in meters, 32 bit only for extended navigation
 #ifdef USE_EXTENDED_NAV
 extern struct relative3D_32 GPSlocation;
 #else
 extern struct relative3D GPSlocation;
 #endif // USE_EXTENDED_NAV
+extern vect3_32t GPSposition;               // centimeters from the origin
 
 extern struct relative3D GPSvelocity;
 extern int16_t cos_lat;
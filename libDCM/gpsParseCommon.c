@@ -23,7 +23,6 @@
 #include "gpsData.h"
 #include "gpsParseCommon.h"
 #include "estLocation.h"
-#include "estAltitude.h"
 #include "estYawDrift.h"
 #include "estWind.h"
 #include "mathlibNAV.h"
@@ -150,7 +149,6 @@ static void gps_parse_common_callback(void)
 
 		estLocation();
 		estWind(GetAofA());
-		estAltitude();
 		estYawDrift();
 
 		dcm_flags._.yaw_req = 1;       // request yaw drift correction
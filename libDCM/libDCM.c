@@ -83,55 +83,32 @@ static boolean gps_run_init_step(uint16_t count)
 }
 
 
-// We want to be returning reading from both the magnetometer and the barometer at 4Hz.
-// However each device may need to be called many times before a reading is returned.
-// The code below ensures that a given sensor is called repeatedly until it reaches
-// a state where the other device can be called safely over the same I2C2 bus, even if 
-// the first device has not yet returned a complete set of sensor data.
-// For example, at startup the barometer could need 9 calls before returning pressure.
-// But in normal operation it will need 5 calls.
-// By contrast in normal operations the magnetometer only needs one call, once it is calibrated.
+// The I2C2 driver queues the transactions of the barometer and the magnetometer,
+// so each sensor is serviced at its own rate without waiting for the other.
+// The barometer is serviced on every call, and so returns pressure at 8Hz.
+// The magnetometer is read at 4Hz, which mag_drift.c expects, but it is called
+// on every call while it needs servicing, for example during its calibration.
 
 void get_data_from_I2C_sensors(void) // Expected to be called at 40Hz
 {
-	static uint8_t barometer_needs_servicing = BAROMETER_SERVICE_CAN_PAUSE;
 	static uint8_t magnetometer_needs_servicing = MAGNETOMETER_SERVICE_CAN_PAUSE;
 	static uint8_t counter_40Hz = 0;
-	
-	// Split a 1 second interval (40 calls) into 8 interleaved segments using the following logic
-	if ((counter_40Hz == 0) || (counter_40Hz == 10) || (counter_40Hz == 20) || ( counter_40Hz == 30))
-	{
-#if (USE_BAROMETER_ALTITUDE == 1 && HILSIM != 1)
-		barometer_needs_servicing = rxBarometer(udb_barometer_callback);
-#endif // (USE_BAROMETER_ALTITUDE == 1 && HILSIM != 1)
-	}
-	else if // Allow a total of 6 consecutive calls to the barometer to return pressure
-		(((counter_40Hz >= 1) && (counter_40Hz <= 5))
-		|| ((counter_40Hz >= 11) && (counter_40Hz <= 15))
-		|| ((counter_40Hz >= 21) && (counter_40Hz <= 25))
-		|| ((counter_40Hz >= 31) && (counter_40Hz <= 35)))
-	{
-		if (barometer_needs_servicing)
-		{
+
 #if (USE_BAROMETER_ALTITUDE == 1 && HILSIM != 1)
-			barometer_needs_servicing = rxBarometer(udb_barometer_callback);
+	rxBarometer(udb_barometer_callback);
 #endif // (USE_BAROMETER_ALTITUDE == 1 && HILSIM != 1)
-		}
-	}
-	else if ((counter_40Hz == 6) || (counter_40Hz == 16) || (counter_40Hz == 26) || ( counter_40Hz == 36))
+
+	if ((counter_40Hz == 6) || (counter_40Hz == 16) || (counter_40Hz == 26) || ( counter_40Hz == 36))
 	{
 #if (MAG_YAW_DRIFT == 1)
 		magnetometer_needs_servicing = rxMagnetometer(mag_drift_callback);
 #endif // (MAG_YAW_DRIFT == 1)
 	}
-	else // Should be my_modulo at 7,8,9  17,18,19   27,28,29  37,38,39 : a total of 4 consecutively calls to mag.
+	else if (magnetometer_needs_servicing)
 	{
-		if (magnetometer_needs_servicing)
-		{
 #if (MAG_YAW_DRIFT == 1 && HILSIM != 1)
-			magnetometer_needs_servicing = rxMagnetometer(mag_drift_callback);
+		magnetometer_needs_servicing = rxMagnetometer(mag_drift_callback);
 #endif  // (MAG_YAW_DRIFT == 1 && HILSIM != 1)
-		}	   
 	}
 	counter_40Hz++;
 	if (counter_40Hz >= 40) counter_40Hz = 0;
@@ -154,6 +131,9 @@ void udb_heartbeat_callback(void)
 
 	if (udb_pulse_counter % (HEARTBEAT_HZ / 40) == 0)
 	{
+#if (USE_BAROMETER_ALTITUDE == 1)
+		estAltitude();  // fuse the barometer with the dead reckoning vertical acceleration
+#endif
 		if (!dcm_flags._.calib_finished)
 		{
 			dcm_run_calib_step(udb_pulse_counter / (HEARTBEAT_HZ / 40));
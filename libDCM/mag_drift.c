@@ -23,9 +23,13 @@
 #include "mathlibNAV.h"
 #include "../libUDB/heartbeat.h"
 #include "../libUDB/magnetometer.h"
+#include "../libUDB/events.h"
 #include "options_magnetometer.h"
 #include "mag_drift.h"
 #include "rmat.h"
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
 
 // These are the routines for maintaining a direction cosine matrix
 // that can be used to transform vectors between the earth and plane
@@ -50,8 +54,7 @@ fractional magFieldEarth[3];
 fractional rmatPrevious[9];
 fractional magFieldEarthNormalizedPrevious[3];
 fractional magAlignment[4] = { 0, 0, 0, RMAX };
-fractional magFieldBodyMagnitudePrevious;
-fractional magFieldBodyPrevious[3];
+uint16_t mag_calib_fits = 0;                    // number of accepted calibration fits
 
 #ifdef INITIALIZE_VERTICAL  // for VTOL vertical initialization
 static fractional rmatDelayCompensated[] =  { RMAX, 0, 0, 0, 0, RMAX, 0, -RMAX, 0 };
@@ -61,6 +64,251 @@ static fractional rmatDelayCompensated[] = { RMAX, 0, 0, 0, RMAX, 0, 0, 0, RMAX
 
 static fractional declinationVector[2];
 
+// The alignment matrix only moves by small quaternion adjustments, so it is
+// rebuilt once every MAG_ALIGN_REBUILD_COUNT samples rather than every sample.
+#define MAG_ALIGN_REBUILD_COUNT 4
+static fractional magAlignmentMatrix[9] = { RMAX, 0, 0, 0, RMAX, 0, 0, 0, RMAX };
+static int16_t mag_align_rebuild_counter = 0;
+
+// The calibration sums are in the body frame, but magGain is indexed by
+// the sensor axis, so the soft iron gains are mapped through the mounting.
+#ifdef MAG_X_AXIS
+static const int16_t mag_sensor_axis[3] = { MAG_X_AXIS, MAG_Y_AXIS, MAG_Z_AXIS };
+#else
+static const int16_t mag_sensor_axis[3] = { 0, 1, 2 };
+#endif
+
+// Online hard and soft iron calibration.
+// Each magnetometer sample, with the current offset added back in, lies on a
+// sphere (ideally) centered on the hard iron offset. Writing r = |u|^2, the
+// sphere satisfies r = 2*c.u + k, so the covariance of u with r is 2*C*c,
+// where C is the covariance matrix of u. Only the sums needed to form C and
+// cov(u, r) are accumulated per sample; the 3x3 system is solved once per
+// window of MAG_CAL_WINDOW samples, and only if the window saw enough
+// rotation on every axis. Soft iron is estimated from the per axis extents
+// once the rotation covers nearly the whole sphere.
+// The solution is in floating point, so it is left to a low priority event,
+// and the heartbeat takes up its result with the next magnetometer sample.
+#define MAG_CAL_WINDOW          16      // samples per fit, 4 seconds at 4 Hz
+#define MAG_CAL_SHIFT           2       // samples are accumulated divided by 4
+#define MAG_CAL_R_SHIFT         6       // r is divided by a further 64 in the u*r sums
+#define MAG_CAL_MIN_SPAN        ((int16_t)(MAG_GAIN / 4) >> MAG_CAL_SHIFT)
+#define MAG_CAL_SETTLED         8       // offset change (udb_magOffset units) regarded as settled
+#define MAG_CAL_SETTLED_FITS    3       // settled fits in a row before the result is saved
+#define MAG_CAL_GAIN_LIMIT      (RMAX / 4)  // soft iron may move a gain by at most 25% per fit
+
+struct mag_calib_sums {
+	int16_t n;
+	int16_t min[3];
+	int16_t max[3];
+	int32_t u[3];
+	int32_t uu[6];      // xx, xy, xz, yy, yz, zz
+	int32_t r;
+	int32_t ur[3];
+	int16_t gain[3];    // magGain when the window started
+};
+
+enum MAG_CALIB_STATES
+{
+	MAG_CALIB_IDLE,
+	MAG_CALIB_SOLVING,  // mag_calib_window is being solved by mag_calib_service()
+	MAG_CALIB_SOLVED,   // mag_calib_target and mag_calib_gain are ready to apply
+};
+
+static struct mag_calib_sums mag_calib;
+static struct mag_calib_sums mag_calib_window;
+static int16_t mag_calib_target[3];
+static int16_t mag_calib_gain[3];
+static volatile int16_t mag_calib_state = MAG_CALIB_IDLE;
+static uint16_t mag_calib_event_handle = INVALID_HANDLE;
+static int16_t mag_calib_settled = 0;
+static boolean mag_calib_saved = false;
+
+static void mag_calib_reset(void)
+{
+	int16_t i;
+
+	memset(&mag_calib, 0, sizeof(mag_calib));
+	for (i = 0; i < 3; i++)
+	{
+		mag_calib.min[i] = INT16_MAX;
+		mag_calib.max[i] = INT16_MIN;
+		mag_calib.gain[i] = magGain[i];
+	}
+}
+
+// Fit the offsets, and the gains when the coverage allows, to a full window.
+// Returns false if the window doesn't give a usable fit.
+static boolean mag_calib_solve(const struct mag_calib_sums* w, int16_t target[], int16_t gain[])
+{
+	float n = w->n;
+	float mu[3], c[3], d[3], cov[6];
+	float det, radius_sqr;
+	int16_t i;
+
+	for (i = 0; i < 3; i++)
+	{
+		mu[i] = w->u[i] / n;
+		d[i] = (w->ur[i] / n) * (1 << MAG_CAL_R_SHIFT) - mu[i] * (w->r / n);
+		gain[i] = w->gain[i];
+	}
+	cov[0] = w->uu[0] / n - mu[0] * mu[0];
+	cov[1] = w->uu[1] / n - mu[0] * mu[1];
+	cov[2] = w->uu[2] / n - mu[0] * mu[2];
+	cov[3] = w->uu[3] / n - mu[1] * mu[1];
+	cov[4] = w->uu[4] / n - mu[1] * mu[2];
+	cov[5] = w->uu[5] / n - mu[2] * mu[2];
+
+	// solve 2*C*c = d by Cramer's rule
+	det = cov[0] * (cov[3] * cov[5] - cov[4] * cov[4])
+	    - cov[1] * (cov[1] * cov[5] - cov[4] * cov[2])
+	    + cov[2] * (cov[1] * cov[4] - cov[3] * cov[2]);
+	if (det < 1.0f) return false;
+	det *= 2;
+	c[0] = (d[0] * (cov[3] * cov[5] - cov[4] * cov[4])
+	      - cov[1] * (d[1] * cov[5] - cov[4] * d[2])
+	      + cov[2] * (d[1] * cov[4] - cov[3] * d[2])) / det;
+	c[1] = (cov[0] * (d[1] * cov[5] - cov[4] * d[2])
+	      - d[0] * (cov[1] * cov[5] - cov[4] * cov[2])
+	      + cov[2] * (cov[1] * d[2] - d[1] * cov[2])) / det;
+	c[2] = (cov[0] * (cov[3] * d[2] - d[1] * cov[4])
+	      - cov[1] * (cov[1] * d[2] - d[1] * cov[2])
+	      + d[0] * (cov[1] * cov[4] - cov[3] * cov[2])) / det;
+
+	// udb_magOffset is kept at twice the body frame resolution
+	for (i = 0; i < 3; i++)
+	{
+		float offset = c[i] * (2 << MAG_CAL_SHIFT);
+		if (offset > 2 * MAGNETICMAXIMUM || offset < -2 * MAGNETICMAXIMUM) return false;
+		target[i] = (int16_t)offset;
+	}
+
+	// soft iron: with nearly full coverage, each axis should span the sphere diameter
+	radius_sqr = w->r / n - 2 * (c[0] * mu[0] + c[1] * mu[1] + c[2] * mu[2])
+	           + c[0] * c[0] + c[1] * c[1] + c[2] * c[2];
+	if (radius_sqr > 0)
+	{
+		float diameter = 2 * sqrtf(radius_sqr);
+		for (i = 0; i < 3; i++)
+		{
+			if (w->max[i] - w->min[i] < 0.8f * diameter) break;
+		}
+		if (i == 3)
+		{
+			for (i = 0; i < 3; i++)
+			{
+				int16_t a = mag_sensor_axis[i];
+				float scale = diameter / (w->max[i] - w->min[i]);
+				int16_t delta = (int16_t)(gain[a] * (scale - 1.0f) / 2);
+				if (delta > MAG_CAL_GAIN_LIMIT) delta = MAG_CAL_GAIN_LIMIT;
+				if (delta < -MAG_CAL_GAIN_LIMIT) delta = -MAG_CAL_GAIN_LIMIT;
+				gain[a] += delta;
+				// the offset is in scaled units, so it moves with the gain
+				target[i] = (int16_t)(target[i] * (1.0f + (float)delta / (gain[a] - delta)));
+			}
+		}
+	}
+	return true;
+}
+
+static void mag_calib_service(void)
+{
+	if (mag_calib_solve(&mag_calib_window, mag_calib_target, mag_calib_gain))
+	{
+		mag_calib_state = MAG_CALIB_SOLVED;
+	}
+	else
+	{
+		mag_calib_state = MAG_CALIB_IDLE;
+	}
+}
+
+// Called at heartbeat level to move the offsets halfway to the fit
+static void mag_calib_apply(void)
+{
+	int16_t change = 0;
+	int16_t i;
+
+	// drop the fit if the gains were changed while it was solved
+	if (mag_calib_window.gain[0] != magGain[0] || mag_calib_window.gain[1] != magGain[1] || mag_calib_window.gain[2] != magGain[2])
+	{
+		return;
+	}
+	for (i = 0; i < 3; i++)
+	{
+		int16_t step = (mag_calib_target[i] - udb_magOffset[i]) / 2;
+		magGain[i] = mag_calib_gain[i];
+		udb_magOffset[i] += step;
+		if (abs(step) > change) change = abs(step);
+	}
+	mag_calib_fits++;
+
+	if (change > 4 * MAG_CAL_SETTLED)
+	{
+		mag_calib_settled = 0;
+		mag_calib_saved = false;
+	}
+	else if (change <= MAG_CAL_SETTLED && !mag_calib_saved)
+	{
+		if (++mag_calib_settled >= MAG_CAL_SETTLED_FITS)
+		{
+			mag_calib_saved = true;
+			dcm_callback_mag_calibrated();
+		}
+	}
+}
+
+static void mag_calib_accumulate(void)
+{
+	int16_t u[3];
+	int32_t r;
+	int16_t i;
+
+	// discard the window if the gains were changed underneath it
+	if (mag_calib.gain[0] != magGain[0] || mag_calib.gain[1] != magGain[1] || mag_calib.gain[2] != magGain[2])
+	{
+		mag_calib_reset();
+	}
+
+	// remove the current offset correction, so that all samples share the same frame
+	for (i = 0; i < 3; i++)
+	{
+		u[i] = (udb_magFieldBody[i] + (udb_magOffset[i] >> 1)) >> MAG_CAL_SHIFT;
+		if (u[i] < mag_calib.min[i]) mag_calib.min[i] = u[i];
+		if (u[i] > mag_calib.max[i]) mag_calib.max[i] = u[i];
+		mag_calib.u[i] += u[i];
+	}
+	mag_calib.uu[0] += __builtin_mulss(u[0], u[0]);
+	mag_calib.uu[1] += __builtin_mulss(u[0], u[1]);
+	mag_calib.uu[2] += __builtin_mulss(u[0], u[2]);
+	mag_calib.uu[3] += __builtin_mulss(u[1], u[1]);
+	mag_calib.uu[4] += __builtin_mulss(u[1], u[2]);
+	mag_calib.uu[5] += __builtin_mulss(u[2], u[2]);
+	r = __builtin_mulss(u[0], u[0]) + __builtin_mulss(u[1], u[1]) + __builtin_mulss(u[2], u[2]);
+	mag_calib.r += r;
+	r >>= MAG_CAL_R_SHIFT;
+	for (i = 0; i < 3; i++)
+	{
+		mag_calib.ur[i] += __builtin_mulss(u[i], (int16_t)r);
+	}
+
+	if (++mag_calib.n >= MAG_CAL_WINDOW)
+	{
+		for (i = 0; i < 3; i++)
+		{
+			if (mag_calib.max[i] - mag_calib.min[i] < MAG_CAL_MIN_SPAN) break;
+		}
+		// a window that completes while the previous one is still being solved is lost
+		if (i == 3 && mag_calib_state == MAG_CALIB_IDLE)
+		{
+			mag_calib_window = mag_calib;
+			mag_calib_state = MAG_CALIB_SOLVING;
+			trigger_event(mag_calib_event_handle);
+		}
+		mag_calib_reset();
+	}
+}
+
 void mag_drift_init(void) // TODO: can this be called during align_rmat_to_mag below?
 {
 #if (MAG_YAW_DRIFT == 1)
@@ -70,6 +318,11 @@ void mag_drift_init(void) // TODO: can this be called during align_rmat_to_mag b
 	declinationVector[0] = cosine((int8_t) (DECLINATIONANGLE >> 8));
 	declinationVector[1] = sine((int8_t) (DECLINATIONANGLE >> 8));
 #endif
+	if (mag_calib_event_handle == INVALID_HANDLE)
+	{
+		mag_calib_event_handle = register_event_p(&mag_calib_service, EVENT_PRIORITY_LOW);
+	}
+	mag_calib_reset();
 }
 
 static void align_rmat(int16_t costheta, int16_t sintheta)
@@ -233,21 +486,29 @@ static int16_t mag_latency_counter = (HEARTBEAT_HZ / 4) - MAG_LATENCY_COUNT;
 
 //static void mag_drift(void)
 //void mag_drift(fractional rmatDelayCompensated[], fractional errorYawplane[])
+// Returns 1/2 of the dot product of column c1 of m1 with column c2 of m2,
+// which is one element of m1 transpose times m2.
+static fractional column_dot(const fractional m1[], int16_t c1, const fractional m2[], int16_t c2)
+{
+	int32_t accum;
+
+	accum = __builtin_mulss(m1[c1], m2[c2])
+	      + __builtin_mulss(m1[c1 + 3], m2[c2 + 3])
+	      + __builtin_mulss(m1[c1 + 6], m2[c2 + 6]);
+	return (fractional)(accum >> 15);
+}
+
 void mag_drift(fractional errorYawplane[])
 {
 	int16_t mag_error;
+	uint16_t horizontal_half_magnitude;
 	fractional magFieldEarthNormalized[3];
-	fractional magFieldEarthHorzNorm[2];
 	fractional magAlignmentError[3];
 	fractional rmat2Transpose[9];
 	fractional R2TR1RotationVector[3];
 	fractional R2TAlignmentErrorR1[3];
-	fractional rmatBufferA[9];
-	fractional rmatBufferB[9];
 	fractional magAlignmentAdjustment[3];
 	fractional vectorBuffer[3];
-	fractional magFieldBodyMagnitude;
-	fractional offsetEstimate[3];
 
 	// the following compensates for magnetometer drift by adjusting the timing
 	// of when rmat is read
@@ -261,19 +522,26 @@ void mag_drift(fractional errorYawplane[])
 
 	if (dcm_flags._.mag_drift_req)
 	{
-		// Compute magnetic offsets
-		magFieldBodyMagnitude =	vector3_mag(udb_magFieldBody[0], udb_magFieldBody[1], udb_magFieldBody[2]);
-		VectorSubtract(3, vectorBuffer, udb_magFieldBody, magFieldBodyPrevious);
-		vector3_normalize(vectorBuffer, vectorBuffer);
-		VectorScale(3, offsetEstimate, vectorBuffer, magFieldBodyMagnitude - magFieldBodyMagnitudePrevious);
-		VectorCopy(3, magFieldBodyPrevious, udb_magFieldBody);
-		magFieldBodyMagnitudePrevious = magFieldBodyMagnitude;
+		// Take up the last calibration fit and accumulate the magnetic offset statistics
+		if (dcm_flags._.first_mag_reading == 0)
+		{
+			if (mag_calib_state == MAG_CALIB_SOLVED)
+			{
+				mag_calib_apply();
+				mag_calib_state = MAG_CALIB_IDLE;
+			}
+			mag_calib_accumulate();
+		}
 
 		// Compute and apply the magnetometer alignment adjustment in the body frame
-		RotVector2RotMat(rmatBufferA, magAlignment);
-		vectorBuffer[0] = VectorDotProduct(3, &rmatBufferA[0], udb_magFieldBody) << 1;
-		vectorBuffer[1] = VectorDotProduct(3, &rmatBufferA[3], udb_magFieldBody) << 1;
-		vectorBuffer[2] = VectorDotProduct(3, &rmatBufferA[6], udb_magFieldBody) << 1;
+		if (--mag_align_rebuild_counter <= 0)
+		{
+			RotVector2RotMat(magAlignmentMatrix, magAlignment);
+			mag_align_rebuild_counter = MAG_ALIGN_REBUILD_COUNT;
+		}
+		vectorBuffer[0] = VectorDotProduct(3, &magAlignmentMatrix[0], udb_magFieldBody) << 1;
+		vectorBuffer[1] = VectorDotProduct(3, &magAlignmentMatrix[3], udb_magFieldBody) << 1;
+		vectorBuffer[2] = VectorDotProduct(3, &magAlignmentMatrix[6], udb_magFieldBody) << 1;
 		VectorCopy(3, udb_magFieldBody, vectorBuffer);
 
 		if (dcm_flags._.first_mag_reading == 1)
@@ -293,14 +561,20 @@ void mag_drift(fractional errorYawplane[])
 
 		// Normalize the magnetic vector to RMAT
 		vector3_normalize(magFieldEarthNormalized, magFieldEarth);
-		vector2_normalize(magFieldEarthHorzNorm, magFieldEarth);
 
 		// Use the magnetometer to detect yaw drift
 #if (DECLINATIONANGLE_VARIABLE == 1)
 		declinationVector[0] = cosine(dcm_declination_angle._.B1);
 		declinationVector[1] = sine(dcm_declination_angle._.B1);
 #endif
-		mag_error = VectorDotProduct(2, magFieldEarthHorzNorm, declinationVector);
+		// the horizontal field is not normalized, the dot product is
+		// divided by its magnitude instead (one divide rather than two)
+		mag_error = 0;
+		horizontal_half_magnitude = vector2_mag(magFieldEarth[0], magFieldEarth[1]) / 2;
+		if (horizontal_half_magnitude > 0)
+		{
+			mag_error = __builtin_divsd(__builtin_mulss(RMAX / 2, VectorDotProduct(2, magFieldEarth, declinationVector)), horizontal_half_magnitude);
+		}
 		VectorScale(3, errorYawplane, &rmat[6], mag_error); // Scalegain = 1/2
 
 		// Do the computations needed to compensate for magnetometer misalignment
@@ -308,42 +582,26 @@ void mag_drift(fractional errorYawplane[])
 		// Determine the apparent shift in the earth's magnetic field:
 		VectorCross(magAlignmentError, magFieldEarthNormalizedPrevious, magFieldEarthNormalized);
 
-		// Compute R2 transpose
-		MatrixTranspose(3, 3, rmat2Transpose, rmatDelayCompensated);
+		// Convert R2tranpose times R1 to a rotation vector. Only the off diagonal
+		// elements are needed, each is 1/2 of a column dot product.
+		R2TR1RotationVector[0] = column_dot(rmatDelayCompensated, 2, rmatPrevious, 1) - column_dot(rmatDelayCompensated, 1, rmatPrevious, 2);
+		R2TR1RotationVector[1] = column_dot(rmatDelayCompensated, 0, rmatPrevious, 2) - column_dot(rmatDelayCompensated, 2, rmatPrevious, 0);
+		R2TR1RotationVector[2] = column_dot(rmatDelayCompensated, 1, rmatPrevious, 0) - column_dot(rmatDelayCompensated, 0, rmatPrevious, 1);
 
-		// Compute 1/2 of R2tranpose times R1
-		MatrixMultiply(3, 3, 3, rmatBufferA, rmat2Transpose, rmatPrevious);
-
-		// Convert to a rotation vector, take advantage of 1/2 from the previous step
-		R2TR1RotationVector[0] = rmatBufferA[7] - rmatBufferA[5];
-		R2TR1RotationVector[1] = rmatBufferA[2] - rmatBufferA[6];
-		R2TR1RotationVector[2] = rmatBufferA[3] - rmatBufferA[1];
-
-		// Compute 1/4 of RT2*Matrix(error-vector)*R1
-		rmatBufferA[0] = rmatBufferA[4] = rmatBufferA[8] = 0;
-		rmatBufferA[7] =  magAlignmentError[0];
-		rmatBufferA[5] = -magAlignmentError[0];
-		rmatBufferA[2] =  magAlignmentError[1];
-		rmatBufferA[6] = -magAlignmentError[1];
-		rmatBufferA[3] =  magAlignmentError[2];
-		rmatBufferA[1] = -magAlignmentError[2];
-		MatrixMultiply(3, 3, 3, rmatBufferB, rmatBufferA, rmatDelayCompensated);
-		MatrixMultiply(3, 3, 3, rmatBufferA, rmat2Transpose, rmatBufferB);
-
-		// taking advantage of factor of 1/4 in the two matrix multiplies, compute
-		// 1/2 of the vector representation of the rotation
-		R2TAlignmentErrorR1[0] = (rmatBufferA[7] - rmatBufferA[5]);
-		R2TAlignmentErrorR1[1] = (rmatBufferA[2] - rmatBufferA[6]);
-		R2TAlignmentErrorR1[2] = (rmatBufferA[3] - rmatBufferA[1]);
+		// RT2*Matrix(error-vector)*R1 is Matrix(RT2*error-vector) to first order,
+		// since R1 and R2 differ only by the small rotation above, and the result
+		// is crossed with that rotation. So 1/2 of the vector representation of
+		// the rotation is just the error vector rotated by R2 transpose.
+		MatrixTranspose(3, 3, rmat2Transpose, rmatDelayCompensated);
+		R2TAlignmentErrorR1[0] = VectorDotProduct(3, &rmat2Transpose[0], magAlignmentError);
+		R2TAlignmentErrorR1[1] = VectorDotProduct(3, &rmat2Transpose[3], magAlignmentError);
+		R2TAlignmentErrorR1[2] = VectorDotProduct(3, &rmat2Transpose[6], magAlignmentError);
 
 		// compute the negative of estimate of the residual misalignment
 		VectorCross(magAlignmentAdjustment, R2TAlignmentErrorR1, R2TR1RotationVector);
 
 		if (dcm_flags._.first_mag_reading == 0)
 		{
-			udb_magOffset[0] = udb_magOffset[0] + ((offsetEstimate[0] + 2) >> 2);
-			udb_magOffset[1] = udb_magOffset[1] + ((offsetEstimate[1] + 2) >> 2);
-			udb_magOffset[2] = udb_magOffset[2] + ((offsetEstimate[2] + 2) >> 2);
 			quaternion_adjust(magAlignment, magAlignmentAdjustment);
 		}
 		else
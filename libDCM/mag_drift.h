@@ -29,13 +29,16 @@ extern fractional magFieldEarth[3];
 extern fractional rmatPrevious[9];
 extern fractional magFieldEarthNormalizedPrevious[3];
 extern fractional magAlignment[4];
-extern fractional magFieldBodyMagnitudePrevious;
-extern fractional magFieldBodyPrevious[3];
+extern uint16_t mag_calib_fits;
 
 
 void mag_drift_init(void);
 void mag_drift(fractional errorYawplane[]);
 void mag_drift_callback(void);
 
+// Implement this callback to save the magnetometer calibration.
+// It is called each time the online calibration settles on a new result.
+void dcm_callback_mag_calibrated(void);     // Callback
+
 
 #endif // MAG_DRIFT_H
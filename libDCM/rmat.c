@@ -29,6 +29,9 @@
 #include "options_magnetometer.h"
 #include "mag_drift.h"
 #include "rmat.h"
+#if (MPU_FIFO_RATE != 0)
+#include "../libUDB/mpu6000.h"
+#endif
 
 // These are the routines for maintaining a direction cosine matrix
 // that can be used to transform vectors between the earth and plane
@@ -179,6 +182,12 @@ static inline void read_gyros(void)
 	omegagyro[0] = XRATE_VALUE;
 	omegagyro[1] = YRATE_VALUE;
 	omegagyro[2] = ZRATE_VALUE;
+#if (MPU_FIFO_RATE != 0)
+	// second order coning correction from the MPU6000 FIFO samples
+	omegagyro[0] += XRATE_CONING;
+	omegagyro[1] += YRATE_CONING;
+	omegagyro[2] += ZRATE_CONING;
+#endif
 #endif
 
 	spin_rate = vector3_mag(omegagyro[0], omegagyro[1], omegagyro[2]);
@@ -200,6 +209,12 @@ static inline void read_accel(void)
 	gplane[0] = XACCEL_VALUE;
 	gplane[1] = YACCEL_VALUE;
 	gplane[2] = ZACCEL_VALUE;
+#if (MPU_FIFO_RATE != 0)
+	// second order sculling correction from the MPU6000 FIFO samples
+	gplane[0] += XACCEL_SCULLING;
+	gplane[1] += YACCEL_SCULLING;
+	gplane[2] += ZACCEL_SCULLING;
+#endif
 #endif
 	aero_force[0] = - gplane[0];
 	aero_force[1] = - gplane[1];
@@ -31,6 +31,11 @@
 
 void init_AT45D_DMA(void);
 
+#ifndef USE_AT45D_DMA
+static void AT45D_WaitReady(void);
+static void AT45D_ForgetPage(uint16_t PageAdr);
+#endif // !USE_AT45D_DMA
+
 
 #define DF_CS           _LATE7
 #define DF_SCK          _LATG6
@@ -178,6 +183,10 @@ uint8_t ReadDFStatus(void)
 
 void PageErase(uint16_t PageAdr)
 {
+#ifndef USE_AT45D_DMA
+	AT45D_WaitReady();                  // finish any page program or transfer still running
+	AT45D_ForgetPage(PageAdr);
+#endif // !USE_AT45D_DMA
 	DF_reset();                         // reset dataflash command decoder
 	DF_SPI_RW(PageEraseCmd);            // Page erase op-code
 	DF_SPI_RW((uint8_t)(PageAdr >> 7)); // upper part of page address
@@ -190,9 +199,48 @@ void PageErase(uint16_t PageAdr)
 ///////////////////////////////////////////////////////////////////////////////
 #ifndef USE_AT45D_DMA
 
+// Page programs and page to buffer transfers are started without waiting for
+// them to finish.  The wait happens before the next command that needs the
+// main memory, or the buffer that is in use, so that the SPI traffic for one
+// buffer overlaps the array operation on the other.
+// A sequential read transfers the next page into the other buffer while the
+// caller is busy with this one, and sequential writes alternate the buffers
+// so that one is filled while the other programs.
+
+#define NO_PAGE         0xFFFF
+
+static uint16_t buffer_page[2] = { NO_PAGE, NO_PAGE }; // page held in buffer 1 and buffer 2
+static uint8_t busy_buffer = 0;         // buffer used by the array operation in progress
+static uint8_t next_buffer = 1;         // buffer for the next page that isn't held
+static uint16_t last_read = NO_PAGE;
+
+static void AT45D_WaitReady(void)
+{
+	if (busy_buffer)
+	{
+		while (!(ReadDFStatus() & 0x80));   // monitor the status register, wait until busy-flag is high
+		busy_buffer = 0;
+	}
+}
+
+static uint8_t AT45D_FindPage(uint16_t PageAdr)
+{
+	if (buffer_page[0] == PageAdr) return 1;
+	if (buffer_page[1] == PageAdr) return 2;
+	return 0;
+}
+
+static void AT45D_ForgetPage(uint16_t PageAdr)
+{
+	uint8_t BufferNo = AT45D_FindPage(PageAdr);
+
+	if (BufferNo) buffer_page[BufferNo - 1] = NO_PAGE;
+}
+
 static void BufferToPage(uint8_t BufferNo, uint16_t PageAdr)
 {
 //	printf("BufferToPage(BufferNo %u, PageAdr %u)\r\n", BufferNo, PageAdr);
+	AT45D_WaitReady();
 	DF_reset();                         // reset dataflash command decoder
 	// Note that this test selects either Buffer 1 or the other buffer, whatever you call it.
 	// You can call it Buffer 0 or Buffer 2 and it will work as long as you are consistant.
@@ -205,12 +253,14 @@ static void BufferToPage(uint8_t BufferNo, uint16_t PageAdr)
 	DF_SPI_RW((uint8_t)(PageAdr << (PAGE_BITS - 8)));  //lower part of page address
 	DF_SPI_RW(0x00);                    // don't cares
 	DF_reset();                         // initiate flash page programming
-	while (!(ReadDFStatus() & 0x80));   // monitor the status register, wait until busy-flag is high
+	busy_buffer = BufferNo;
+	buffer_page[BufferNo - 1] = PageAdr;
 }
 
 static void PageToBuffer(uint16_t PageAdr, uint8_t BufferNo)
 {
 //	printf("PageToBuffer(PageAdr %u, BufferNo %u)\r\n", PageAdr, BufferNo);
+	AT45D_WaitReady();
 	DF_reset();                         // reset dataflash command decoder
 	// Note that this test selects either Buffer 1 or the other buffer, whatever you call it.
 	// You can call it Buffer 0 or Buffer 2 and it will work as long as you are consistant.
@@ -223,7 +273,26 @@ static void PageToBuffer(uint16_t PageAdr, uint8_t BufferNo)
 	DF_SPI_RW((uint8_t)(PageAdr << (PAGE_BITS - 8)));  // lower part of page address
 	DF_SPI_RW(0x00);                    // don't cares
 	DF_reset();                         // init transfer
-	while (!(ReadDFStatus() & 0x80));    // monitor the status register, wait until busy-flag is high
+	busy_buffer = BufferNo;
+	buffer_page[BufferNo - 1] = PageAdr;
+}
+
+// Compare a main memory page with a buffer, true if they are the same
+static uint8_t PageMatchesBuffer(uint16_t PageAdr, uint8_t BufferNo)
+{
+	AT45D_WaitReady();
+	DF_reset();                         // reset dataflash command decoder
+	if (BufferNo == 1)
+		DF_SPI_RW(FlashToBuf1Compare);  // compare with buffer 1 op-code
+	else
+		DF_SPI_RW(FlashToBuf2Compare);  // compare with buffer 2 op-code
+	DF_SPI_RW((uint8_t)(PageAdr >> (16 - PAGE_BITS))); // upper part of page address
+	DF_SPI_RW((uint8_t)(PageAdr << (PAGE_BITS - 8)));  // lower part of page address
+	DF_SPI_RW(0x00);                    // don't cares
+	DF_reset();                         // start the compare
+	busy_buffer = BufferNo;
+	AT45D_WaitReady();
+	return ((ReadDFStatus() & 0x40) == 0); // compare flag is clear if they match
 }
 
 static void BufferReadStr(uint8_t BufferNo, uint16_t IntPageAdr, uint16_t No_of_bytes, uint8_t *BufferPtr)
@@ -231,6 +300,7 @@ static void BufferReadStr(uint8_t BufferNo, uint16_t IntPageAdr, uint16_t No_of_
 	uint16_t i;
 
 //	printf("BufferReadStr(BufferNo %u, IntPageAdr %u)\r\n", BufferNo, IntPageAdr);
+	if (busy_buffer == BufferNo) AT45D_WaitReady();
 	DF_reset();                         // reset dataflash command decoder
 	// Note that this test selects either Buffer 1 or the other buffer, whatever you call it.
 	// You can call it Buffer 0 or Buffer 2 and it will work as long as you are consistant.
@@ -257,6 +327,7 @@ static void BufferWriteStr(uint8_t BufferNo, uint16_t IntPageAdr, uint16_t No_of
 	uint16_t i;
 
 //	printf("BufferWriteStr(BufferNo %u, IntPageAdr %u)\r\n", BufferNo, IntPageAdr);
+	if (busy_buffer == BufferNo) AT45D_WaitReady();
 	DF_reset();                         // reset dataflash command decoder
 	// Note that this test selects either Buffer 1 or the other buffer, whatever you call it.
 	// You can call it Buffer 0 or Buffer 2 and it will work as long as you are consistant.
@@ -279,14 +350,45 @@ static void BufferWriteStr(uint8_t BufferNo, uint16_t IntPageAdr, uint16_t No_of
 
 void ReadSector(uint16_t sector, uint8_t* buffer)
 {
-	PageToBuffer(sector, 2);            // transfer AT45D internal page 'sector' into AT45D internal buffer 2
-	BufferReadStr(2, 0, 512, buffer);   // read 512 bytes from beginning (offset 0) of AT45D internal buffer 2
+	uint8_t BufferNo = AT45D_FindPage(sector);
+
+	if (!BufferNo)
+	{
+		BufferNo = next_buffer;
+		PageToBuffer(sector, BufferNo); // transfer AT45D internal page 'sector' into an AT45D internal buffer
+	}
+	BufferReadStr(BufferNo, 0, 512, buffer); // read 512 bytes from beginning (offset 0) of that buffer
+	next_buffer = 3 - BufferNo;
+
+	// Read ahead into the other buffer when the reads are sequential
+	if (sector == last_read + 1 && sector + 1 < MDD_AT45D_FLASH_DRIVE_CAPACITY && !AT45D_FindPage(sector + 1))
+	{
+		PageToBuffer(sector + 1, next_buffer);
+	}
+	last_read = sector;
 }
 
 void WriteSector(uint16_t sector, uint8_t* buffer)
 {
-	BufferWriteStr(2, 0, 512, buffer);  // write 512 bytes to beginning (offset 0) of AT45D internal buffer 2
-	BufferToPage(2, sector);            // transfer AT45D internal buffer 2 into AT45D internal page 'sector'  
+	uint8_t BufferNo = AT45D_FindPage(sector);
+
+	// Use the buffer that holds this page, otherwise the one that isn't programming
+	if (!BufferNo)
+	{
+		BufferNo = next_buffer;
+	}
+	buffer_page[BufferNo - 1] = NO_PAGE;
+	BufferWriteStr(BufferNo, 0, 512, buffer); // write 512 bytes to beginning (offset 0) of the AT45D internal buffer
+	next_buffer = 3 - BufferNo;
+	last_read = NO_PAGE;
+
+	// Rewriting a sector with the data it already holds doesn't program it again
+	if (PageMatchesBuffer(sector, BufferNo))
+	{
+		buffer_page[BufferNo - 1] = sector;
+		return;
+	}
+	BufferToPage(BufferNo, sector);     // transfer the buffer into AT45D internal page 'sector', finishes in the background
 }
 
 #endif // !USE_AT45D_DMA
@@ -31,6 +31,14 @@ void AT45D_FormatFS(void);
 void ReadSector(uint16_t sector, uint8_t* buffer);
 void WriteSector(uint16_t sector, uint8_t* buffer);
 
+#ifdef USE_AT45D_DMA
+// With the DMA driver, ReadSector(), WriteSector() and AT45D_Flush() wait on
+// the low priority event. Call them from background level only; from an
+// event or interrupt at that priority or above they return without waiting.
+void AT45D_trigger_service(void);
+void AT45D_Flush(void);
+#endif
+
 // configuration for the Atmel AT45DB321D device
 #define PAGE_BITS 10
 #define PAGE_SIZE 528
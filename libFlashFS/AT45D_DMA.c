@@ -26,6 +26,7 @@
 #include "../libUDB/libUDB.h"
 #include "../libUDB/interrupt.h"
 #include "AT45D.h"
+#include "../libUDB/events.h"
 #include <stdio.h>
 
 
@@ -36,12 +37,61 @@ extern uint8_t ReadDFStatus(void);
 
 #ifdef USE_AT45D_DMA
 
+// Sectors are written through the two AT45D SRAM buffers in turn. Each write
+// is staged in its own DMA buffer, loaded into the matching SRAM buffer by DMA,
+// then programmed into its main memory page. Loading one buffer does not need
+// the device to be ready, so it overlaps the page program from the other one.
+// The work is done by a low priority event, triggered from the DMA interrupt
+// when a transfer completes and from the heartbeat while a page is programming.
+// WriteSector() returns as soon as the sector is staged, ReadSector() waits
+// only for its own page read, and serves sectors still being written from the
+// staging buffers.
+// Waiting for the event only works below its priority. WriteSector() with
+// both slots busy, ReadSector() of a sector that is not staged and
+// AT45D_Flush() therefore check the caller's priority. From an event or
+// interrupt at low event priority or above they return without waiting,
+// rather than spin forever: the write or read is dropped, or the flush
+// is left to finish in the background.
+
 #define SPI2_DMA_SIZE 512
 __eds__ unsigned char Spi2RxBuffA[SPI2_DMA_SIZE+8] __attribute__((eds,space(dma)));
-__eds__ unsigned char Spi2TxBuffA[SPI2_DMA_SIZE+8] __attribute__((eds,space(dma)));
+__eds__ unsigned char Spi2TxBuff[2][SPI2_DMA_SIZE+8] __attribute__((eds,space(dma)));
+
+#define DF_CS _LATE7
 
 volatile int16_t IsBusy __attribute__ ((near)) = 0;
 
+enum {
+	SLOT_FREE,
+	SLOT_FILLED,                        // staged, waiting to be loaded into its SRAM buffer
+	SLOT_LOADING,
+	SLOT_LOADED,                        // waiting for the device to be ready to program it
+	SLOT_PROGRAMMING
+};
+
+enum { BUS_IDLE, BUS_LOAD, BUS_READ };
+enum { READ_NONE, READ_QUEUED, READ_DONE };
+
+struct at45d_slot {
+	volatile uint8_t state;
+	uint8_t seq;                        // order the sectors were written in
+	uint16_t sector;
+};
+
+// slot 0 uses AT45D SRAM buffer 1, slot 1 uses buffer 2
+static struct at45d_slot slots[2];
+static uint8_t next_seq = 0;
+static int8_t bus_op = BUS_IDLE;
+static int8_t bus_slot;
+static int8_t programming = -1;         // slot whose page program is in progress
+
+static volatile uint8_t read_state = READ_NONE;
+static uint16_t read_sector;
+static uint8_t* read_buffer;
+
+static uint16_t at45d_event_handle = INVALID_HANDLE;
+
+static void AT45D_service(void);
 
 void init_AT45D_DMA(void)
 {
@@ -49,7 +99,8 @@ void init_AT45D_DMA(void)
 
 	for (i = 0; i < (SPI2_DMA_SIZE); i++)
 	{
-		Spi2TxBuffA[i] = (i + 16) % 8;
+		Spi2TxBuff[0][i] = 0x00;
+		Spi2TxBuff[1][i] = 0x00;
 	}
 	for (i = 0; i < (SPI2_DMA_SIZE); i++)
 	{
@@ -64,14 +115,7 @@ void init_AT45D_DMA(void)
 	DMA2CNT = SPI2_DMA_SIZE - 1;
 	DMA2REQ = 0x021;            // SPI2
 	DMA2PAD = (volatile unsigned int)&SPI2BUF;
-#if defined(__dsPIC33F__)
-	DMA2STA = &Spi2TxBuffA;
-#elif defined(__dsPIC33E__)
-	DMA2STAH = 0x0000;
-	DMA2STAL = __builtin_dmaoffset(&Spi2TxBuffA);
-#else
-#error here
-#endif
+	// the start address is set for each transfer, from the slot being loaded
 //	_DMA2IP = INT_PRI_DMA2;     // Set the DMA2 ISR priority
 //	IFS0bits.DMA2IF  = 0;       // Clear DMA interrupt
 //	IEC0bits.DMA2IE  = 1;       // Enable DMA interrupt
@@ -86,7 +130,7 @@ void init_AT45D_DMA(void)
 	DMA1REQ = 0x021;            // SPI2
 	DMA1PAD = (volatile unsigned int)&SPI2BUF;
 #if defined(__dsPIC33F__)
-	DMA1STA = &Spi2RxBuffA;
+	DMA1STA = __builtin_dmaoffset(&Spi2RxBuffA);
 #elif defined(__dsPIC33E__)
 	DMA1STAH = 0x0000;
 	DMA1STAL = __builtin_dmaoffset(&Spi2RxBuffA);
@@ -97,6 +141,8 @@ void init_AT45D_DMA(void)
 	IFS0bits.DMA1IF  = 0;       // Clear DMA interrupt
 	IEC0bits.DMA1IE  = 1;       // Enable DMA interrupt
 //	DMA1CONbits.CHEN = 1;       // Enable DMA Channel
+
+	at45d_event_handle = register_event_p(&AT45D_service, EVENT_PRIORITY_LOW);
 }
 
 /*
@@ -152,9 +198,9 @@ void __attribute__((__interrupt__, __no_auto_psv__)) _DMA1Interrupt(void)
 
 	_DMA1IF = 0;
 
-#define DF_CS _LATE7
 	DF_CS = 1;
 	IsBusy = 0;
+	trigger_event(at45d_event_handle);  // complete the transfer and start the next one
 
 	interrupt_restore_corcon;
 	unset_ipl_on_output_pin;
@@ -184,150 +230,285 @@ void DumpRxData(void)
  */
 ////////////////////////////////////////////////////////////////////////////////
 
-//#define SPI_VERBOSE
+#define USE_FAST_COPY
 
-static int AT45D_WriteSector(uint16_t sector)
+static void AT45D_CopyFromDMA(uint8_t* buffer, __eds__ unsigned char* dma)
 {
-//	printf("AT45D_WriteSector(%u)\r\n", sector);
-
-#ifdef SPI_VERBOSE
-	while (IsBusy) {
-		printf(".");
-	}
-	printf("\r\n");
+#ifdef USE_FAST_COPY
+	int* dst = (int*)buffer;
+	__eds__ int* src = (__eds__ int*)dma;
 
-	while (SPI2STATbits.SPIRBF) {
-		int result = SPI2BUF;           // dummy read of the SPIBUF register to clear the SPIRBF flag
-		printf("AT45D_WriteSector discarding %x\r\n", result);
+	int count = 512 / 2;
+	while (count--) {
+		*dst++ = *src++;
 	}
-	if (SPI2STATbits.SPIROV) {
-		printf("AT45D_WriteSector SPI2STAT = %x\r\n", SPI2STAT);
-		SPI2STATbits.SPIROV = 0;
+#else
+	int i;
+	for (i = 0; i < 512; i++) {
+		buffer[i] = dma[i];
 	}
-	while (!(ReadDFStatus() & 0x80)) {
-		printf("@");
+#endif
+}
+
+static void AT45D_CopyToDMA(__eds__ unsigned char* dma, uint8_t* buffer)
+{
+#ifdef USE_FAST_COPY
+	int* src = (int*)buffer;
+	__eds__ int* dst = (__eds__ int*)dma;
+
+	uint16_t count = 512 / 2;
+	while (count--) {
+		*dst++ = *src++;
 	}
 #else
-	while (IsBusy);
-	while (!(ReadDFStatus() & 0x80));   // monitor the status register, wait until busy-flag is high
+	uint16_t i;
+	for (i = 0; i < 512; i++) {
+		dma[i] = buffer[i];
+	}
 #endif
+}
+
+static void AT45D_ClearSPI(void)
+{
+	while (SPI2STATbits.SPIRBF) {
+		int result = SPI2BUF;           // dummy read of the SPIBUF register to clear the SPIRBF flag
+		(void)result;
+	}
+	SPI2STATbits.SPIROV = 0;
+}
+
+static boolean AT45D_DeviceReady(void)
+{
+	uint8_t status = ReadDFStatus();
+
+	DF_CS = 1;
+	return (status & 0x80) != 0;        // busy-flag is high when ready
+}
+
+// Load a staged sector into the slot's SRAM buffer
+static void AT45D_StartLoad(int8_t slot)
+{
+	slots[slot].state = SLOT_LOADING;
+	bus_op = BUS_LOAD;
+	bus_slot = slot;
 
 	IsBusy = 1;
 	DF_reset();                         // reset dataflash command decoder
-	DF_SPI_RW(FlashProgBuf1);           // buffer 1 to flash with erase op-code
-	DF_SPI_RW((uint8_t)(sector >> (16 - PAGE_BITS))); // upper part of page address
-	DF_SPI_RW((uint8_t)(sector << (PAGE_BITS - 8)));  // lower part of page address
-//	DF_SPI_RW(0x00);                    // don't cares
+	DF_SPI_RW(slot ? Buf2Write : Buf1Write); // buffer write op-code
+	DF_SPI_RW(0x00);                    // don't care
+	DF_SPI_RW(0x00);                    // upper part of internal buffer address
 
+#if defined(__dsPIC33F__)
+	DMA2STA = __builtin_dmaoffset(&Spi2TxBuff[slot][0]);
+#elif defined(__dsPIC33E__)
+	DMA2STAH = 0x0000;
+	DMA2STAL = __builtin_dmaoffset(&Spi2TxBuff[slot][0]);
+#endif
 	DMA1CONbits.NULLW = 0;
 	DMA1CONbits.CHEN = 1;               // enable DMA Channel
 	DMA2CONbits.CHEN = 1;               // enable DMA Channel
-	SPI2BUF = 0;                        // start the DMA transaction with the don't care byte
-//	DMA2REQbits.FORCE = 1;
-	return 1;
+	SPI2BUF = 0;                        // start the DMA transaction with the lower part of the buffer address
 }
 
-static int AT45D_ReadSector(uint16_t sector)
+// Program the slot's SRAM buffer into its page, the device is busy until done
+static void AT45D_StartProgram(int8_t slot)
 {
-//	printf("AT45D_ReadSector(%u)\r\n", sector);
-
-#ifdef SPI_VERBOSE
-	while (IsBusy) {
-		printf(".");
-	}
-	printf("\r\n");
+	uint16_t sector = slots[slot].sector;
 
-	while (SPI2STATbits.SPIRBF) {
-		int result = SPI2BUF;           // dummy read of the SPIBUF register to clear the SPIRBF flag
-		printf("AT45D_ReadSector discarding %x\r\n", result);
-	}
-	if (SPI2STATbits.SPIROV) {
-		printf("AT45D_ReadSector SPI2STAT = %x\r\n", SPI2STAT);
-		SPI2STATbits.SPIROV = 0;
-	}
-	while (!(ReadDFStatus() & 0x80)) {
-		printf("#");
-	}
-#else
-	while (IsBusy);
-	while (!(ReadDFStatus() & 0x80));   // monitor the status register, wait until busy-flag is high
-#endif
+	slots[slot].state = SLOT_PROGRAMMING;
+	programming = slot;
 
-	IsBusy = 1;
 	DF_reset();                         // reset dataflash command decoder
-	DF_SPI_RW(FlashPageRead);           // transfer to buffer 1 op-code
+	DF_SPI_RW(slot ? Buf2ToFlashWE : Buf1ToFlashWE); // buffer to flash with erase op-code
 	DF_SPI_RW((uint8_t)(sector >> (16 - PAGE_BITS))); // upper part of page address
 	DF_SPI_RW((uint8_t)(sector << (PAGE_BITS - 8)));  // lower part of page address
+	DF_SPI_RW(0x00);                    // don't cares
+	DF_CS = 1;                          // initiate flash page programming
+}
+
+static void AT45D_StartRead(void)
+{
+	bus_op = BUS_READ;
+
+	IsBusy = 1;
+	DF_reset();                         // reset dataflash command decoder
+	DF_SPI_RW(FlashPageRead);           // main memory page read op-code
+	DF_SPI_RW((uint8_t)(read_sector >> (16 - PAGE_BITS))); // upper part of page address
+	DF_SPI_RW((uint8_t)(read_sector << (PAGE_BITS - 8)));  // lower part of page address
 	DF_SPI_RW(0x00);                    // page starting address (lower 8 bits)
 	DF_SPI_RW(0x00);                    // don't cares
 	DF_SPI_RW(0x00);                    // don't cares
 	DF_SPI_RW(0x00);                    // don't cares
 	DF_SPI_RW(0x00);                    // don't cares
 
-//	DF_SPI_RW(0x00);                    // why is this required - odd...
 	DMA1CONbits.NULLW = 1;
 	DMA1CONbits.CHEN = 1;               // enable DMA Channel
 	SPI2BUF = 0;                        // start the DMA transaction
-//	DMA1REQbits.FORCE = 1;
-	return 1;
 }
 
-#define USE_FAST_COPY
+// Returns the oldest slot that is not free, or -1
+static int8_t AT45D_OldestSlot(void)
+{
+	if (slots[0].state == SLOT_FREE)
+	{
+		return (slots[1].state == SLOT_FREE) ? -1 : 1;
+	}
+	if (slots[1].state == SLOT_FREE)
+	{
+		return 0;
+	}
+	return ((int8_t)(slots[0].seq - slots[1].seq) < 0) ? 0 : 1;
+}
 
-static void AT45D_GetBuffer(uint8_t* buffer)
+static void AT45D_service(void)
 {
-	while (IsBusy);
+	int8_t slot;
 
-//void *memcpy(void *dst , const void *src , size_t n);
-//	memcpy (buffer, (__eds__ unsigned char*)&Spi2RxBuffA, 512);
-#ifdef USE_FAST_COPY
-	int* dst = (int*)buffer;
-	__eds__ int* src = (__eds__ int*)Spi2RxBuffA;
+	if (IsBusy)
+	{
+		return;                         // the DMA interrupt triggers the service again
+	}
 
-	int count = 512 / 2;
-	while (count--) {
-		*dst++ = *src++;
+	// complete the transfer that has just finished
+	if (bus_op == BUS_LOAD)
+	{
+		slots[bus_slot].state = SLOT_LOADED;
 	}
-#else
-	int i;
-	for (i = 0; i < 512; i++) {
-		buffer[i] = Spi2RxBuffA[i];
+	else if (bus_op == BUS_READ)
+	{
+		AT45D_CopyFromDMA(read_buffer, Spi2RxBuffA);
+		read_state = READ_DONE;
+	}
+	bus_op = BUS_IDLE;
+	AT45D_ClearSPI();
+
+	if (programming >= 0)
+	{
+		if (!AT45D_DeviceReady())
+		{
+			// load the other buffer while the page is programming
+			slot = 1 - programming;
+			if (slots[slot].state == SLOT_FILLED)
+			{
+				AT45D_StartLoad(slot);
+			}
+			return;                     // the heartbeat triggers the service again
+		}
+		slots[programming].state = SLOT_FREE;
+		programming = -1;
+	}
+
+	if (read_state == READ_QUEUED)
+	{
+		AT45D_StartRead();
+		return;
+	}
+
+	// sectors are programmed in the order they were written
+	slot = AT45D_OldestSlot();
+	if (slot < 0)
+	{
+		return;
+	}
+	if (slots[slot].state == SLOT_LOADED)
+	{
+		AT45D_StartProgram(slot);
+		slot = 1 - slot;
+	}
+	if (slots[slot].state == SLOT_FILLED)
+	{
+		AT45D_StartLoad(slot);
 	}
-#endif
 }
 
-static void AT45D_PutBuffer(uint8_t* buffer)
+// The service runs in the low priority event, so it can only be waited for
+// from code running below that priority
+static boolean AT45D_CanWait(void)
 {
-	while (IsBusy);
+	if (SRbits.IPL >= INT_PRI_EVENTL)
+	{
+		DPRINT("AT45D: cannot wait at IPL %u\r\n", SRbits.IPL);
+		return false;
+	}
+	return true;
+}
 
-#ifdef USE_FAST_COPY
-	int* src = (int*)buffer;
-	__eds__ int* dst = (__eds__ int*)Spi2TxBuffA;
+// Called from the heartbeat to poll the device while a page is programming
+void AT45D_trigger_service(void)
+{
+	if (programming >= 0)
+	{
+		trigger_event(at45d_event_handle);
+	}
+}
 
-	uint16_t count = 512 / 2;
-	while (count--) {
-		*dst++ = *src++;
+// Wait until all the staged sectors have been programmed
+void AT45D_Flush(void)
+{
+	if (!AT45D_CanWait())
+	{
+		return;                         // the event still programs them
 	}
-#else
-	uint16_t i;
-	for (i = 0; i < 512; i++) {
-		Spi2TxBuffA[i] = buffer[i];
+	while (slots[0].state != SLOT_FREE || slots[1].state != SLOT_FREE)
+	{
+		trigger_event(at45d_event_handle);
 	}
-#endif
 }
 
 void ReadSector(uint16_t sector, uint8_t* buffer)
 {
-//printf("rs %u\r\n", sector);
-	AT45D_ReadSector(sector);
-	AT45D_GetBuffer(buffer);
+	int8_t slot = -1;
+
+	// a sector still being written is read back from its staging buffer
+	if (slots[0].state != SLOT_FREE && slots[0].sector == sector)
+	{
+		slot = 0;
+	}
+	if (slots[1].state != SLOT_FREE && slots[1].sector == sector)
+	{
+		if (slot < 0 || (int8_t)(slots[0].seq - slots[1].seq) < 0)
+		{
+			slot = 1;
+		}
+	}
+	if (slot >= 0)
+	{
+		AT45D_CopyFromDMA(buffer, Spi2TxBuff[slot]);
+		return;
+	}
+
+	if (!AT45D_CanWait())
+	{
+		return;
+	}
+	read_sector = sector;
+	read_buffer = buffer;
+	read_state = READ_QUEUED;
+	trigger_event(at45d_event_handle);
+	while (read_state != READ_DONE);
+	read_state = READ_NONE;
 }
 
 void WriteSector(uint16_t sector, uint8_t* buffer)
 {
-//printf("ws %u\r\n", sector);
-	AT45D_PutBuffer(buffer);
-	AT45D_WriteSector(sector);
+	int8_t slot;
+
+	// wait for a free slot, only when both sectors are still being written
+	while (slots[0].state != SLOT_FREE && slots[1].state != SLOT_FREE)
+	{
+		if (!AT45D_CanWait())
+		{
+			return;
+		}
+		trigger_event(at45d_event_handle);
+	}
+	slot = (slots[0].state == SLOT_FREE) ? 0 : 1;
+
+	AT45D_CopyToDMA(Spi2TxBuff[slot], buffer);
+	slots[slot].sector = sector;
+	slots[slot].seq = next_seq++;
+	slots[slot].state = SLOT_FILLED;
+	trigger_event(at45d_event_handle);
 }
 
 #endif // USE_AT45D_DMA
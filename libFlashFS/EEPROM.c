@@ -148,16 +148,10 @@ void ReadPage(uint16_t page, uint8_t* buffer)
 //	printf("ReadPage(...) - 2\r\n");
 }
 
-static uint16_t last_sector = 0xFFFF;
-
 void ReadSector(uint16_t sector, uint8_t* buffer)
 {
 	int page = 0;
 
-	if (last_sector == sector) return;
-
-last_sector = sector;
-
 //	printf("ReadSector(%u, ...)\r\n", sector);
 //	while (MCP24LC256_state != MCP24LC256_STATE_STOPPED) {}
 	if (block())
@@ -197,8 +191,6 @@ void WriteSector(uint16_t sector, uint8_t* buffer)
 	// therefore writing a 512 byte sector will be done as eight consecutive page writes
 	int page = 0;
 
-last_sector = 0xFFFF;
-
 //	printf("WriteSector(%u, ...)\r\n", sector);
 	if (block()) return;
 //	printf("WriteSector(...) - 2\r\n");
@@ -292,6 +284,7 @@ void eeprom_test_write(char* arg)
 		}
 	}
 	WriteSector(sector, gDataBuffer);
+	MDD_EEPROM_Discard();
 }
 
 #endif // USE_EEPROM_FLASH
@@ -156,6 +156,7 @@ void EEPROM_FormatFS(void)
 	for (i = (MDD_EEPROM_FLASH_NUM_FAT_SECTORS+1+1); i < ((MDD_EEPROM_FLASH_NUM_FAT_SECTORS+1) + MDD_EEPROM_FLASH_NUM_ROOT_DIRECTORY_SECTORS); i++) {
 		WriteSector(i, buf);
 	}
+	MDD_EEPROM_Discard();
 	printf("EEPROM_FormatFS() complete\r\n");
 }
 
@@ -30,7 +30,16 @@
 #define FALSE   0
 #define TRUE    !FALSE
 
+// Uncomment to keep the telemetry logs in a log-structured store in the upper
+// half of the dataflash, the FAT volume then only uses the lower half and
+// the dataflash needs to be formatted again
+//#define USE_AT45D_LOG_STORE
+
+#ifdef USE_AT45D_LOG_STORE
+#define MDD_AT45D_FLASH_TOTAL_DISK_SIZE 4096
+#else
 #define MDD_AT45D_FLASH_TOTAL_DISK_SIZE 8192
+#endif
 
 #define INITIALIZATION_VALUE            0x55
 
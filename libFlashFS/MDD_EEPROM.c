@@ -30,11 +30,88 @@
 #include "EEPROM.h"
 #include "../libUDB/I2C.h"
 #include "../libUDB/eeprom_udb4.h"
+#include <string.h>
 
 extern void Delayms(BYTE milliseconds);
 
 static MEDIA_INFORMATION mediaInformation;
 
+// Sector cache
+//
+// Every sector costs eight 64 byte page transfers over I2C, and FSIO reads
+// the directory and FAT sectors again for each file it opens, so the most
+// recently used sectors are kept here. Written sectors only reach the EEPROM
+// when they are evicted or on MDD_EEPROM_Flush().
+
+#define CACHE_EMPTY         0xFFFF
+
+typedef struct tag_sector_cache {
+	uint16_t sector;                // CACHE_EMPTY when unused
+	uint16_t used;                  // cache_clock at the last access
+	boolean dirty;
+	BYTE data[MEDIA_SECTOR_SIZE];
+} sector_cache_t;
+
+static sector_cache_t sector_cache[MDD_EEPROM_CACHE_SECTORS];
+static uint16_t cache_clock = 0;
+static boolean cache_ready = false;
+
+static void cache_touch(sector_cache_t* entry)
+{
+	int16_t i;
+
+	if (++cache_clock == 0)
+	{
+		// keep the order of use when the clock wraps
+		for (i = 0; i < MDD_EEPROM_CACHE_SECTORS; i++)
+		{
+			sector_cache[i].used = 0;
+		}
+		cache_clock = 1;
+	}
+	entry->used = cache_clock;
+}
+
+static sector_cache_t* cache_find(uint16_t sector)
+{
+	int16_t i;
+
+	if (!cache_ready)
+	{
+		MDD_EEPROM_Discard();
+	}
+	for (i = 0; i < MDD_EEPROM_CACHE_SECTORS; i++)
+	{
+		if (sector_cache[i].sector == sector)
+		{
+			return &sector_cache[i];
+		}
+	}
+	return NULL;
+}
+
+// Free the least recently used entry for sector, writing it back if it has changed
+static sector_cache_t* cache_evict(uint16_t sector)
+{
+	sector_cache_t* entry = &sector_cache[0];
+	int16_t i;
+
+	for (i = 1; i < MDD_EEPROM_CACHE_SECTORS && entry->sector != CACHE_EMPTY; i++)
+	{
+		if (sector_cache[i].sector == CACHE_EMPTY || sector_cache[i].used < entry->used)
+		{
+			entry = &sector_cache[i];
+		}
+	}
+	if (entry->dirty)
+	{
+		WriteSector(entry->sector, entry->data);
+		entry->dirty = false;
+	}
+	entry->sector = sector;
+	return entry;
+}
+
 
 /******************************************************************************
  * Function:        BYTE MediaDetect(void)
@@ -133,11 +210,20 @@ BYTE MDD_EEPROM_SectorRead(DWORD sector_addr, BYTE* buffer)
 {
 //	printf("MDD_EEPROM_SectorRead %u\r\n", (unsigned int)sector_addr);
 
+	sector_cache_t* entry;
+
 	if (sector_addr >= MDD_EEPROM_FLASH_TOTAL_DISK_SIZE)
 	{
 		return FALSE;
 	}
-	ReadSector((uint16_t)sector_addr, buffer);
+	entry = cache_find((uint16_t)sector_addr);
+	if (entry == NULL)
+	{
+		entry = cache_evict((uint16_t)sector_addr);
+		ReadSector(entry->sector, entry->data);
+	}
+	cache_touch(entry);
+	memcpy(buffer, entry->data, MEDIA_SECTOR_SIZE);
 	return TRUE;
 }
 
@@ -163,11 +249,20 @@ BYTE MDD_EEPROM_SectorWrite(DWORD sector_addr, BYTE* buffer, BYTE allowWriteToZe
 {
 //	printf("MDD_EEPROM_SectorWrite %u\r\n", (unsigned int)sector_addr);
 
+	sector_cache_t* entry;
+
 	if (sector_addr >= MDD_EEPROM_FLASH_TOTAL_DISK_SIZE)
 	{
 		return FALSE;
 	}
-	WriteSector((uint16_t)sector_addr, buffer);
+	entry = cache_find((uint16_t)sector_addr);
+	if (entry == NULL)
+	{
+		entry = cache_evict((uint16_t)sector_addr);
+	}
+	cache_touch(entry);
+	memcpy(entry->data, buffer, MEDIA_SECTOR_SIZE);
+	entry->dirty = true;
 	return TRUE;
 }
 
@@ -183,4 +278,43 @@ BYTE MDD_EEPROM_WriteProtectState(void)
 	return FALSE;
 }
 
+/******************************************************************************
+ * Function:    void Flush(void)
+ *
+ * Overview:    Writes the cached sectors that have changed out to the
+ *              EEPROM. Called once a file has been closed, before the
+ *              power may go.
+ *****************************************************************************/
+void MDD_EEPROM_Flush(void)
+{
+	int16_t i;
+
+	for (i = 0; i < MDD_EEPROM_CACHE_SECTORS; i++)
+	{
+		if (sector_cache[i].dirty)
+		{
+			WriteSector(sector_cache[i].sector, sector_cache[i].data);
+			sector_cache[i].dirty = false;
+		}
+	}
+}
+
+/******************************************************************************
+ * Function:    void Discard(void)
+ *
+ * Overview:    Empties the sector cache without writing it back, for when
+ *              the EEPROM has been written directly, as by EEPROM_FormatFS().
+ *****************************************************************************/
+void MDD_EEPROM_Discard(void)
+{
+	int16_t i;
+
+	for (i = 0; i < MDD_EEPROM_CACHE_SECTORS; i++)
+	{
+		sector_cache[i].sector = CACHE_EMPTY;
+		sector_cache[i].dirty = false;
+	}
+	cache_ready = true;
+}
+
 #endif // USE_EEPROM_FLASH
@@ -32,6 +32,11 @@
 
 #define MDD_EEPROM_FLASH_TOTAL_DISK_SIZE 64
 
+// Number of 512 byte sectors kept in the write-back sector cache
+#ifndef MDD_EEPROM_CACHE_SECTORS
+#define MDD_EEPROM_CACHE_SECTORS        4
+#endif
+
 #define INITIALIZATION_VALUE            0x55
 
 BYTE MDD_EEPROM_InitIO(void);
@@ -42,6 +47,10 @@ BYTE MDD_EEPROM_SectorWrite(DWORD sector_addr, BYTE* buffer, BYTE allowWriteToZe
 WORD MDD_EEPROM_ReadSectorSize(void);
 DWORD MDD_EEPROM_ReadCapacity(void);
 BYTE MDD_EEPROM_WriteProtectState(void);
+// Write the cached sectors that have changed out to the EEPROM
+void MDD_EEPROM_Flush(void);
+// Forget the cached sectors, after the EEPROM was written around the cache
+void MDD_EEPROM_Discard(void);
 
 
 #endif // _MDD_EEPROM_H_
@@ -21,10 +21,11 @@
 
 #include "../libUDB/libUDB.h" // for DPRINT
 #include "filesys.h"
-#ifndef WIN32
+#if !(WIN == 1 || NIX == 1) || (SILSIM_MEDIA != SILSIM_MEDIA_HOST)
 #include "MDD-File-System/FSIO.h"
 #include "AT45D.h"
 #include "EEPROM.h"
+#include "log_store.h"
 
 
 void filesys_chkdsk(void)
@@ -95,7 +96,15 @@ void filesys_format(void)
 	AT45D_FormatFS();
 #elif defined USE_EEPROM_FLASH
 	EEPROM_FormatFS();
-#elif (WIN == 1) || (NIX == 1)
+#elif defined USE_SD_INTERFACE_WITH_SPI
+	// one partition over the whole card, starting on the second track, as
+	// the card may be blank
+	MDD_InitIO();
+	if (FSCreateMBR(0x3F, MDD_ReadCapacity() + 1) != 0 ||
+	    FSformat(1, 0x12345678, "MATRIXPILOT") != 0)
+	{
+		printf("filesys_format failed (%d)\r\n", FSerror());
+	}
 #else
 #warning No Mass Storage Device Format Function Defined
 #endif // USE_AT45D_FLASH
@@ -125,11 +134,46 @@ int filesys_init(void)
 		}
 	}
 	printf("File system initalised\r\n");
+#ifdef USE_AT45D_LOG_STORE
+	log_store_init();
+#endif
 #endif // USE_FILESYS
 	return 1;
 }
 
-#else // WIN32
+// Copy the flight logs from the log store into FAT files
+void filesys_export(void)
+{
+#ifdef USE_AT45D_LOG_STORE
+	printf("%u logs exported\r\n", log_store_export());
+#else
+	printf("no log store\r\n");
+#endif
+}
+
+// Write out whatever the storage device driver still holds back, once a
+// file has been closed. The dataflash driver can only wait for its pages
+// from background level; from an event or interrupt the flush returns at
+// once and the pages are still programmed in the background.
+void filesys_flush(void)
+{
+#ifdef USE_EEPROM_FLASH
+	MDD_EEPROM_Flush();
+#endif
+#if defined(USE_AT45D_FLASH) && defined(USE_AT45D_DMA)
+	AT45D_Flush();
+#endif
+}
+
+// Called at 40Hz from the heartbeat to keep the storage device driver moving
+void filesys_service_trigger(void)
+{
+#if defined(USE_AT45D_FLASH) && defined(USE_AT45D_DMA)
+	AT45D_trigger_service();
+#endif
+}
+
+#else // SIL with the files kept by stdio
 
 void filesys_chkdsk(void)
 {
@@ -156,8 +200,20 @@ void filesys_format(void)
 
 int filesys_init(void)
 {
-	printf("filesys_init() - nothing to do on WIN32\r\n");
+	printf("filesys_init() - files are kept in the working directory\r\n");
 	return 1;
 }
 
-#endif // WIN32
+void filesys_service_trigger(void)
+{
+}
+
+void filesys_export(void)
+{
+}
+
+void filesys_flush(void)
+{
+}
+
+#endif // SILSIM_MEDIA
@@ -28,6 +28,9 @@ void filesys_chkdsk(void);
 void filesys_format(void);
 void filesys_dir(char* arg);
 void filesys_cat(char* arg);
+void filesys_service_trigger(void);
+void filesys_export(void);
+void filesys_flush(void);
 
 
 #endif // FILESYS_H
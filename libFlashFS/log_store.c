@@ -0,0 +1,408 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2015 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+//******************************************************************/
+// LOG STORE
+// Flight logs are appended to a ring of dataflash pages instead of to FAT
+// files, so that logging never rewrites FAT or directory sectors.
+// Every page carries a header with a sequence number, the log it belongs
+// to and a checksum. The ring is written in order, so each page is worn
+// evenly, and the newest page is found after a power cycle by a binary
+// search on the sequence numbers. A page torn by a power failure fails its
+// checksum and is treated like an empty one.
+// The dataflash erases each page as it programs it, so space is reclaimed
+// simply by the head overwriting the oldest pages.
+// Logs are copied to FAT files on request, for download over USB MSD, or
+// read back page by page for download over MAVLink. Log numbers only grow
+// along the ring, so a log is found by a binary search on them. They are
+// compared as serial numbers, so the search still works once they wrap.
+//
+
+#include "FSconfig.h"
+
+#ifdef USE_AT45D_FLASH
+
+#include "../libUDB/libUDB.h"
+#include "MDD-File-System/FSIO.h"
+#include "AT45D.h"
+#include "MDD_AT45D.h"
+
+#ifdef USE_AT45D_LOG_STORE
+
+#include "log_store.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+// Include MAVlink library for checksums
+#include "../MAVLink/include/mavlink_types.h"
+#include "../MAVLink/include/checksum.h"
+
+#define LOG_STORE_FIRST_SECTOR  MDD_AT45D_FLASH_TOTAL_DISK_SIZE
+#define LOG_STORE_SECTORS       (MDD_AT45D_FLASH_DRIVE_CAPACITY - LOG_STORE_FIRST_SECTOR)
+
+#define LOG_PAGE_MAGIC          0x474C
+#define LOG_NO_PAGE             0xFFFF
+#define LOG_PAGE_FIRST          0x0001  // first page of a log
+
+struct log_page_header
+{
+	uint16_t magic;
+	uint16_t checksum;          // over the rest of the page
+	uint32_t seq;               // one more than the page written before it
+	uint16_t log;
+	uint16_t flags;
+	uint16_t len;               // bytes of log data in this page
+	uint16_t reserved;
+};
+
+#define LOG_PAGE_DATA_SIZE      (MEDIA_SECTOR_SIZE - sizeof(struct log_page_header))
+
+struct log_page
+{
+	struct log_page_header header;
+	char data[LOG_PAGE_DATA_SIZE];
+};
+
+static struct log_page log_page;    // page being filled, or being read when no log is open
+static uint16_t log_head = 0;       // ring index of the next page to write
+static uint32_t log_seq = 1;        // sequence number of the next page to write
+static uint16_t log_next = 0;       // number of the next log to open
+static boolean log_open = false;
+static boolean log_wrapped = false; // the head has gone round the ring, the oldest page is at the head
+
+static struct log_page log_read_page;   // page read back for download
+static uint16_t log_read_index = LOG_NO_PAGE;
+
+
+static uint16_t log_page_checksum(struct log_page* page)
+{
+	return crc_calculate((uint8_t*)&page->header.seq, MEDIA_SECTOR_SIZE - offsetof(struct log_page_header, seq));
+}
+
+static boolean log_page_valid(struct log_page* page)
+{
+	return (page->header.magic == LOG_PAGE_MAGIC &&
+	        page->header.len <= LOG_PAGE_DATA_SIZE &&
+	        page->header.checksum == log_page_checksum(page));
+}
+
+// Read a page of the ring into log_page, returns false if it does not hold a valid page
+static boolean log_page_read(uint16_t index)
+{
+	ReadSector(LOG_STORE_FIRST_SECTOR + index, (uint8_t*)&log_page);
+	return log_page_valid(&log_page);
+}
+
+int16_t log_store_init(void)
+{
+	uint16_t lo;
+	uint16_t hi;
+	uint16_t mid;
+	uint32_t first_seq;
+
+	log_open = false;
+	log_wrapped = false;
+	log_read_index = LOG_NO_PAGE;
+	log_head = 0;
+	log_seq = 1;
+	log_next = 0;
+
+	// Pages written since the ring last wrapped all have a sequence number at
+	// least that of page 0, the pages after them are older, torn or empty.
+	if (log_page_read(0))
+	{
+		first_seq = log_page.header.seq;
+		lo = 0;
+		hi = LOG_STORE_SECTORS;
+		while (hi - lo > 1)
+		{
+			mid = lo + (hi - lo) / 2;
+			if (log_page_read(mid) && log_page.header.seq >= first_seq)
+			{
+				lo = mid;
+			}
+			else
+			{
+				hi = mid;
+			}
+		}
+	}
+	else if (log_page_read(LOG_STORE_SECTORS - 1))
+	{
+		lo = LOG_STORE_SECTORS - 1;     // the page written when the ring wrapped was torn
+	}
+	else
+	{
+		printf("log store empty\r\n");
+		return 0;
+	}
+	log_page_read(lo);
+	log_head = (lo + 1) % LOG_STORE_SECTORS;
+	log_seq = log_page.header.seq + 1;
+	log_next = log_page.header.log + 1;
+	log_wrapped = (lo == LOG_STORE_SECTORS - 1) || log_page_read(log_head);
+	printf("log store at page %u, next log %u\r\n", log_head, log_next);
+	return 1;
+}
+
+static void log_page_write(void)
+{
+	log_page.header.magic = LOG_PAGE_MAGIC;
+	log_page.header.seq = log_seq++;
+	log_page.header.reserved = 0;
+	memset(&log_page.data[log_page.header.len], 0, LOG_PAGE_DATA_SIZE - log_page.header.len);
+	log_page.header.checksum = log_page_checksum(&log_page);
+	WriteSector(LOG_STORE_FIRST_SECTOR + log_head, (uint8_t*)&log_page);
+	if (log_read_index == log_head)
+	{
+		log_read_index = LOG_NO_PAGE;
+	}
+	log_head = (log_head + 1) % LOG_STORE_SECTORS;
+	if (log_head == 0)
+	{
+		log_wrapped = true;
+	}
+
+	log_page.header.flags = 0;
+	log_page.header.len = 0;
+}
+
+uint16_t log_store_open(void)
+{
+	log_store_close();
+	log_page.header.log = log_next++;
+	log_page.header.flags = LOG_PAGE_FIRST;
+	log_page.header.len = 0;
+	log_open = true;
+	return log_page.header.log;
+}
+
+void log_store_write(const char* data, int16_t len)
+{
+	int16_t n;
+
+	if (!log_open) return;
+
+	while (len > 0)
+	{
+		n = LOG_PAGE_DATA_SIZE - log_page.header.len;
+		if (n > len)
+		{
+			n = len;
+		}
+		memcpy(&log_page.data[log_page.header.len], data, n);
+		log_page.header.len += n;
+		data += n;
+		len -= n;
+		if (log_page.header.len == LOG_PAGE_DATA_SIZE)
+		{
+			log_page_write();
+		}
+	}
+}
+
+// Writes the last partial page, so call it from the mainloop only: the
+// dataflash driver either programs the page synchronously, or with DMA may
+// have to wait for one of its staging buffers to become free.
+void log_store_close(void)
+{
+	if (!log_open) return;
+
+	log_open = false;
+	if (log_page.header.len)
+	{
+		log_page_write();
+	}
+}
+
+boolean log_store_is_open(void)
+{
+	return log_open;
+}
+
+int16_t log_store_export(void)
+{
+	char filename[13];
+	FSFILE* fp = NULL;
+	boolean skip = false;
+	int16_t exported = 0;
+	uint16_t log = 0;
+	uint16_t i;
+
+	if (log_open)
+	{
+		printf("log store busy\r\n");
+		return 0;
+	}
+	// oldest page first, logs partly overwritten by the head are exported from their first remaining page
+	for (i = 0; i < LOG_STORE_SECTORS; i++)
+	{
+		if (!log_page_read((log_head + i) % LOG_STORE_SECTORS))
+		{
+			continue;
+		}
+		if ((fp == NULL && !skip) || log_page.header.log != log)
+		{
+			if (fp != NULL)
+			{
+				FSfclose(fp);
+				fp = NULL;
+				exported++;
+			}
+			log = log_page.header.log;
+			sprintf(filename, "ls%05u.txt", log);
+			fp = FSfopen(filename, FS_READ);
+			skip = (fp != NULL);        // exported before
+			if (skip)
+			{
+				FSfclose(fp);
+				fp = NULL;
+				continue;
+			}
+			fp = FSfopen(filename, FS_WRITE);
+			if (fp == NULL)
+			{
+				printf("%s failed\r\n", filename);
+				break;
+			}
+			printf("exporting %s\r\n", filename);
+		}
+		if (fp != NULL && FSfwrite(log_page.data, 1, log_page.header.len, fp) != log_page.header.len)
+		{
+			printf("%s write failed\r\n", filename);
+			FSfclose(fp);
+			FSremove(filename);
+			fp = NULL;
+			skip = true;
+		}
+	}
+	if (fp != NULL)
+	{
+		FSfclose(fp);
+		exported++;
+	}
+	return exported;
+}
+
+// Read a page of the ring into log_read_page, keeping the last one read
+static boolean log_read(uint16_t index)
+{
+	if (log_read_index != index)
+	{
+		ReadSector(LOG_STORE_FIRST_SECTOR + index, (uint8_t*)&log_read_page);
+		log_read_index = index;
+	}
+	return log_page_valid(&log_read_page);
+}
+
+// Ring index of the page at position pos, counting from the oldest page
+static uint16_t log_position(uint16_t pos)
+{
+	if (log_wrapped)
+	{
+		return (log_head + pos) % LOG_STORE_SECTORS;
+	}
+	return pos;
+}
+
+static uint16_t log_pages(void)
+{
+	return log_wrapped ? LOG_STORE_SECTORS : log_head;
+}
+
+// Position of the first page of a log, or of the log after it if there is none.
+// A page torn by a power failure can only be the newest, it is taken as a later log.
+static uint16_t log_search(uint16_t log)
+{
+	uint16_t lo = 0;
+	uint16_t hi = log_pages();
+	uint16_t mid;
+
+	while (lo < hi)
+	{
+		mid = lo + (hi - lo) / 2;
+		if (!log_read(log_position(mid)) || (int16_t)(log_read_page.header.log - log) >= 0)
+		{
+			hi = mid;
+		}
+		else
+		{
+			lo = mid + 1;
+		}
+	}
+	return lo;
+}
+
+boolean log_store_range(uint16_t* first, uint16_t* last)
+{
+	uint16_t pages = log_pages();
+	uint16_t pos;
+
+	for (pos = 0; pos < pages && !log_read(log_position(pos)); pos++);
+	if (pos == pages)
+	{
+		return false;
+	}
+	*first = log_read_page.header.log;
+	for (pos = pages; pos > 0 && !log_read(log_position(pos - 1)); pos--);
+	*last = log_read_page.header.log;
+	return true;
+}
+
+uint32_t log_store_find(uint16_t log, uint16_t* start)
+{
+	uint16_t first = log_search(log);
+	uint16_t end = log_search(log + 1);
+
+	if (first >= end || !log_read(log_position(first)) || log_read_page.header.log != log)
+	{
+		return 0;
+	}
+	*start = log_position(first);
+	// every page of a log is full except its last one
+	if (!log_read(log_position(end - 1)))
+	{
+		return 0;
+	}
+	return (uint32_t)(end - 1 - first) * LOG_PAGE_DATA_SIZE + log_read_page.header.len;
+}
+
+int16_t log_store_read(uint16_t log, uint16_t start, uint32_t ofs, char* data, int16_t len)
+{
+	uint16_t index = (uint16_t)((start + ofs / LOG_PAGE_DATA_SIZE) % LOG_STORE_SECTORS);
+	uint16_t offset = (uint16_t)(ofs % LOG_PAGE_DATA_SIZE);
+
+	if (!log_read(index) || log_read_page.header.log != log || offset >= log_read_page.header.len)
+	{
+		return 0;
+	}
+	if (len > (int16_t)(log_read_page.header.len - offset))
+	{
+		len = log_read_page.header.len - offset;
+	}
+	memcpy(data, &log_read_page.data[offset], len);
+	return len;
+}
+
+#endif // USE_AT45D_LOG_STORE
+
+#endif // USE_AT45D_FLASH
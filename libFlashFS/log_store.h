@@ -0,0 +1,53 @@
+// This file is part of MatrixPilot.
+//
+//    http://code.google.com/p/gentlenav/
+//
+// Copyright 2009-2015 MatrixPilot Team
+// See the AUTHORS.TXT file for a list of authors of MatrixPilot.
+//
+// MatrixPilot is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// MatrixPilot is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with MatrixPilot.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#ifndef LOG_STORE_H
+#define LOG_STORE_H
+
+
+// Flight logs are appended page by page to a ring of dataflash pages above
+// the FAT volume, see USE_AT45D_LOG_STORE in MDD_AT45D.h
+
+// Find the newest page after a power cycle, returns 0 if the store is empty
+int16_t log_store_init(void);
+
+// Start a new log, returns its log number
+uint16_t log_store_open(void);
+void log_store_write(const char* data, int16_t len);
+// Write out the last partly filled page
+void log_store_close(void);
+boolean log_store_is_open(void);
+
+// Copy the logs not yet exported into lsNNNNN.txt files on the FAT volume,
+// returns the number of files written
+int16_t log_store_export(void);
+
+// Reading back, also while a log is being written.
+// Get the numbers of the oldest and newest logs, returns false if the store is empty
+boolean log_store_range(uint16_t* first, uint16_t* last);
+// Find a log, returns its size in bytes and the page it starts at, 0 if it isn't in the store
+uint32_t log_store_find(uint16_t log, uint16_t* start);
+// Copy log data from offset ofs, up to the end of its page,
+// returns the number of bytes copied, 0 at the end of the log or once it is overwritten
+int16_t log_store_read(uint16_t log, uint16_t start, uint32_t ofs, char* data, int16_t len);
+
+
+#endif // LOG_STORE_H
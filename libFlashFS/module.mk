@@ -9,5 +9,12 @@ else
 endif
 
 #$(eval $(call make-library,$(subdirectory)/$(subdirectory).a,$(local_src)))
+$(eval $(call make-target,$(subdirectory)/$(subdirectory).a,$(local_src)))
+else
+# SIL runs the file system on a storage image (SILSIM_MEDIA), without the
+# dataflash and USB device drivers
+local_src := $(wildcard $(SOURCE_DIR)/$(subdirectory)/*.c)
+local_src := $(filter-out %/AT45D.c %/AT45D_DMA.c %/usb.c %/usb_cdc.c %/usb_descriptors.c %/usb_msd.c,$(local_src))
+
 $(eval $(call make-target,$(subdirectory)/$(subdirectory).a,$(local_src)))
 endif
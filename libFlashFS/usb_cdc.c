@@ -35,6 +35,65 @@ USB_HANDLE USBOutHandle = 0;  // Needs to be initialized to 0 at startup.
 USB_HANDLE USBInHandle = 0;   // Needs to be initialized to 0 at startup.
 BOOL blinkStatusValid = TRUE;
 
+#if (USE_CDC_TELEMETRY == 1)
+
+// The serial stream is queued here by the UART2 transmit interrupt and sent
+// by CDCTasks() in batches of whole endpoint packets.
+// cdc_tx_head is only modified by the transmit interrupt, cdc_tx_tail only by CDCTasks().
+#define CDC_TX_RING_SIZE    2048        // must be a power of 2
+#define CDC_TX_RING_MASK    (CDC_TX_RING_SIZE - 1)
+#define CDC_TX_BATCH_SIZE   (3 * CDC_DATA_IN_EP_SIZE)
+
+static uint8_t cdc_tx_ring[CDC_TX_RING_SIZE];
+static volatile uint16_t cdc_tx_head = 0;
+static volatile uint16_t cdc_tx_tail = 0;
+static char cdc_tx_batch[CDC_TX_BATCH_SIZE];
+static uint16_t cdc_tx_last_count = 0;
+
+uint16_t usb_cdc_tx_space(void)
+{
+	return (CDC_TX_RING_SIZE - 1) - ((cdc_tx_head - cdc_tx_tail) & CDC_TX_RING_MASK);
+}
+
+void usb_cdc_tx_put(uint8_t txchar)
+{
+	uint16_t h = cdc_tx_head;
+
+	cdc_tx_ring[h] = txchar;
+	cdc_tx_head = (h + 1) & CDC_TX_RING_MASK;
+}
+
+static void usb_cdc_tx_service(void)
+{
+	uint16_t count = (cdc_tx_head - cdc_tx_tail) & CDC_TX_RING_MASK;
+	uint16_t t = cdc_tx_tail;
+	BYTE i = 0;
+
+	if (!mUSBUSARTIsTxTrfReady())
+	{
+		return;
+	}
+	// Wait for a full packet unless the stream has paused since the last pass
+	if (count == 0 || (count < CDC_DATA_IN_EP_SIZE && count != cdc_tx_last_count))
+	{
+		cdc_tx_last_count = count;
+		return;
+	}
+	while (i < CDC_TX_BATCH_SIZE && i < count)
+	{
+		cdc_tx_batch[i++] = cdc_tx_ring[t];
+		t = (t + 1) & CDC_TX_RING_MASK;
+	}
+	cdc_tx_tail = t;
+	cdc_tx_last_count = count - i;
+	putUSBUSART(cdc_tx_batch, i);
+
+	// There is room in the ring again for the rest of the stream
+	udb_serial_usb_resume();
+}
+
+#endif // USE_CDC_TELEMETRY
+
 
 void CDCTasks(void)
 {
@@ -77,6 +136,19 @@ void CDCTasks(void)
 		}
 	}
 
+#elif (USE_CDC_TELEMETRY == 1)
+	numBytesRead = getsUSBUSART(USB_In_Buffer, sizeof(USB_In_Buffer));
+	if (numBytesRead != 0)
+	{
+		BYTE i;
+
+		for (i = 0; i < numBytesRead; i++)
+		{
+			udb_serial_usb_received_byte(USB_In_Buffer[i]);
+		}
+	}
+	usb_cdc_tx_service();
+
 #else
 	if (mUSBUSARTIsTxTrfReady())
 	{
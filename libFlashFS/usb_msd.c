@@ -76,6 +76,16 @@ LUN_FUNCTIONS LUN[MAX_LUN + 1] =
 	}
 };
 #elif defined USE_EEPROM_FLASH
+// The host can be unplugged at any time, so its writes go through the
+// sector cache straight to the EEPROM
+static BYTE MSD_EEPROM_SectorWrite(DWORD sector_addr, BYTE* buffer, BYTE allowWriteToZero)
+{
+	BYTE result = MDD_EEPROM_SectorWrite(sector_addr, buffer, allowWriteToZero);
+
+	MDD_EEPROM_Flush();
+	return result;
+}
+
 LUN_FUNCTIONS LUN[MAX_LUN + 1] = 
 {
 	{
@@ -85,7 +95,7 @@ LUN_FUNCTIONS LUN[MAX_LUN + 1] =
 		&MDD_EEPROM_MediaDetect,
 		&MDD_EEPROM_SectorRead,
 		&MDD_EEPROM_WriteProtectState,
-		&MDD_EEPROM_SectorWrite
+		&MSD_EEPROM_SectorWrite
 	}
 };
 #else
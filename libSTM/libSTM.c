@@ -243,6 +243,7 @@ void osd_spi_erase_chars(uint8_t n) {}
 void osd_spi_write_number(int32_t val, int8_t num_digits, int8_t decimal_places, int8_t num_flags, int8_t header, int8_t footer) {}
 
 void filesys_init(void) {}
+void filesys_flush(void) {}
 
 //static jmp_buf default_jmp_buf;
 
@@ -28,6 +28,10 @@
 
 #define MCP24LC256_COMMAND  0xA0
 
+// Number of times the end of a page write is polled for straight away, before
+// leaving it to the heartbeat. A page write takes up to 5ms.
+#define MCP24LC256_ACK_POLLS 100
+
 enum MCP24LC256_STATES
 {
 	MCP24LC256_STATE_STOPPED,
@@ -157,10 +161,17 @@ static void MCP24LC256_callback(boolean I2CtrxOK)
 {
 	if (I2CtrxOK == false)
 	{
-		MCP24LC256_Timer = 0;
 		// If waiting for write ACK, continue to wait
-		if (MCP24LC256_state != MCP24LC256_STATE_WAITING_WRITE)
+		if (MCP24LC256_state == MCP24LC256_STATE_WAITING_WRITE)
 		{
+			if (++MCP24LC256_Timer < MCP24LC256_ACK_POLLS)
+			{
+				trigger_event(nv_memory_service_handle);
+			}
+		}
+		else
+		{
+			MCP24LC256_Timer = 0;
 			MCP24LC256_state = MCP24LC256_STATE_FAILED_TRX;
 			if (pcallerCallback != NULL) pcallerCallback(true);
 			pcallerCallback = NULL;
@@ -178,6 +189,7 @@ static void MCP24LC256_callback(boolean I2CtrxOK)
 		case MCP24LC256_STATE_WRITING:
 			MCP24LC256_Timer = 0;
 			MCP24LC256_state = MCP24LC256_STATE_WAITING_WRITE;
+			trigger_event(nv_memory_service_handle);    // start polling for the end of the page write
 			break;
 		case MCP24LC256_STATE_WAITING_WRITE:
 			MCP24LC256_write_chunk();
@@ -76,13 +76,17 @@ void I2C1_Init(void);
 
 
 // Copies of the above for the second I2C port
+// On the second port, reads and writes are queued rather than refused while
+// the bus is busy, and only return false if the queue is full. Each queued
+// transaction ends with a call to its callback, false if it failed or timed out.
 boolean I2C2_Write(uint8_t addr, const uint8_t* cmd, uint8_t cmd_len, uint8_t* data, uint16_t data_len, I2C_callbackFunc callback);
 boolean I2C2_Read(uint8_t addr, const uint8_t* cmd, uint8_t cmd_len, uint8_t* data, uint16_t data_len, I2C_callbackFunc callback, uint16_t mode);
 boolean I2C2_CheckAck(uint8_t addr, I2C_callbackFunc callback);
 boolean I2C2_Normal(void);
-void I2C2_trigger_service(void);
+void I2C2_trigger_service(void);   // expected at 40Hz, times out stalled transactions
 void I2C2_Reset(void);
 //void I2C2_Init(void);
+extern uint16_t I2C2_timeouts;
 
 
 #endif // I2C_H
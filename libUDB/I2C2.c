@@ -60,6 +60,8 @@ static void isr_startWrite(void);
 static void isr_readStart(void);
 static void isr_doneWrite(void);
 static void isr_writeCommandData(void);
+static void isr_stopFailed(void);
+static void I2C2_StartNext(void);
 
 static int I2C2ERROR = 0;
 static boolean I2C2_Busy = true;    // Port busy flag.  Set true until initialized
@@ -79,6 +81,20 @@ struct I2C_xfer {
 };
 static struct I2C_xfer x;
 
+// Transactions are queued by I2C2_Read and I2C2_Write, and started in turn
+// as the previous one completes, so the devices on the bus no longer have to
+// take turns in their drivers. The queue has a single producer, the sensor
+// drivers called from the heartbeat. It is drained by the interrupt service
+// routine, or by serviceI2C2 when the bus is idle.
+#define I2C2_QUEUE_SIZE 8       // must be a power of 2
+#define I2C2_TIMEOUT    3       // 40Hz service ticks before a transaction is abandoned
+
+static struct I2C_xfer queue[I2C2_QUEUE_SIZE];
+static volatile uint16_t queue_head = 0;    // next transaction to start
+static volatile uint16_t queue_tail = 0;    // next free slot
+static volatile uint16_t I2C2_ticks = 0;    // service ticks since the transaction started
+uint16_t I2C2_timeouts = 0;                 // stalled transactions, for diagnostics
+
 
 // Determine if the bus is normal
 boolean I2C2_Normal(void)
@@ -101,17 +117,34 @@ boolean I2C2_Normal(void)
 // Reset the bus
 void I2C2_Reset(void)
 {
+	int16_t i;
+
 	x.state = &isr_idle;    // disable the response to any more interrupts
 	I2C2ERROR = I2C2STAT;   // record the error for diagnostics
 
 	_I2C2EN = 0;            // turn off the I2C
 	_MI2C2IF = 0;           // clear the I2C master interrupt
 	_MI2C2IE = 0;           // disable the interrupt
-	I2C2_SDA = 0;           // pull SDA and SCL low
-	I2C2_SCL = 0;
-	Nop();
-	I2C2_SDA = 1;           // pull SDA and SCL high
+
+	// A slave that was reset part way through a read may still be holding
+	// SDA low. Clock it through the rest of its byte, then send a stop.
+	I2C2_SDA_TRIS = 1;
 	I2C2_SCL = 1;
+	I2C2_SCL_TRIS = 0;
+	for (i = 0; i < 9 && I2C2_SDA == 0; i++)
+	{
+		I2C2_SCL = 0;
+		delay_us(5);
+		I2C2_SCL = 1;
+		delay_us(5);
+	}
+	I2C2_SDA = 0;           // stop condition: SDA rises while SCL is high
+	I2C2_SDA_TRIS = 0;
+	delay_us(5);
+	I2C2_SDA = 1;
+	delay_us(5);
+	I2C2_SDA_TRIS = 1;      // release the pins to the I2C module
+	I2C2_SCL_TRIS = 1;
 
 	I2C2_Init();            // enable the bus again
 }
@@ -125,7 +158,10 @@ static void I2C2_Init(void)
 	_MI2C2IF = 0;           // clear the I2C2 master interrupt
 	_MI2C2IE = 1;           // enable the interrupt
 
-	I2C2_service_handle = register_event(&serviceI2C2);
+	if (I2C2_service_handle == INVALID_HANDLE)
+	{
+		I2C2_service_handle = register_event(&serviceI2C2);
+	}
 
 	I2C2_Busy = false;
 
@@ -141,20 +177,93 @@ static void I2C2_Init(void)
 }
 
 // Trigger the I2C2 service routine to run at low priority
+// Expected to be called at 40Hz, to time out stalled transactions
 void I2C2_trigger_service(void)
 {
+	if (I2C2_Busy)
+	{
+		I2C2_ticks++;
+	}
 	trigger_event(I2C2_service_handle);
 }
 
 static void serviceI2C2(void)   // service the I2C
 {
+	I2C_callbackFunc callback;
+
 	if (_I2C2EN == 0)           // I2C is off
 	{
 		x.state = &isr_idle;    // disable response to any interrupts
 		I2C2_Init();            // turn the I2C back on
-		// Put something here to reset state machine.
-		// Make sure attached services exit nicely.
 	}
+	else if (I2C2_Busy)
+	{
+		if (I2C2_ticks > I2C2_TIMEOUT)
+		{
+			_MI2C2IE = 0;       // the transaction may still complete
+			if (I2C2_Busy)      // while we are deciding
+			{
+				// recover the bus, then fail the stalled transaction
+				I2C2_timeouts++;
+				callback = x.callback;
+				I2C2_Reset();
+				if (callback != NULL)
+					callback(false);
+			}
+			_MI2C2IE = 1;
+		}
+	}
+	if (!I2C2_Busy)
+	{
+		I2C2_StartNext();
+	}
+}
+
+// Start the next queued transaction, if there is one.
+// Only called when the bus is idle, either from the interrupt service
+// routine or from serviceI2C2, which the I2C2 interrupt pre-empts.
+static void I2C2_StartNext(void)
+{
+	if (queue_head == queue_tail)
+	{
+		x.state = &isr_idle;
+		I2C2_Busy = false;
+		return;
+	}
+	x = queue[queue_head];
+	queue_head = (queue_head + 1) & (I2C2_QUEUE_SIZE - 1);
+	I2C2_Busy = true;
+	I2C2_ticks = 0;
+	x.state = &isr_startWrite;
+	_MI2C2IF = 1;
+}
+
+// Add a transaction to the queue, returns false if the queue is full.
+static boolean I2C2_Enqueue(uint8_t addr, const uint8_t* cmd, uint8_t cmd_len, uint8_t* data, uint16_t tx_data_len, uint16_t rx_data_len, I2C_callbackFunc callback, uint16_t mode)
+{
+	struct I2C_xfer* q;
+	uint16_t next;
+
+	if (_I2C2EN == 0)       // I2C is off
+	{
+		I2C2_Init();
+	}
+	next = (queue_tail + 1) & (I2C2_QUEUE_SIZE - 1);
+	if (next == queue_head) return false;
+
+	q = &queue[queue_tail];
+	q->addr         = addr;
+	q->cmd          = cmd;
+	q->cmd_len      = cmd_len;
+	q->data         = data;
+	q->tx_data_len  = tx_data_len;
+	q->rx_data_len  = rx_data_len;
+	q->callback     = callback;
+	q->mode         = mode;
+	queue_tail = next;      // publish the transaction
+
+	trigger_event(I2C2_service_handle);
+	return true;
 }
 
 void __attribute__((__interrupt__,__no_auto_psv__)) _MI2C2Interrupt(void)
@@ -170,69 +279,20 @@ void __attribute__((__interrupt__,__no_auto_psv__)) _MI2C2Interrupt(void)
 	unset_ipl_on_output_pin;
 }
 
-// Check if I2C port is available for use.
-static inline boolean I2C2_CheckAvailable(void)
-{
-	if (_I2C2EN == 0) return false;
-	if (!I2C2_NORMAL) return false;
-	if (I2C2_Busy == true) return false;
-	I2C2_Busy = true;
-	return true;
-}
-
 boolean I2C2_Write(uint8_t addr, const uint8_t* cmd, uint8_t cmd_len, uint8_t* data, uint16_t data_len, I2C_callbackFunc callback)
 {
-	if (!I2C2_CheckAvailable()) return false;
-
-	x.addr          = addr;
-	x.cmd           = cmd;
-	x.cmd_len       = cmd_len;
-	x.data          = data;
-	x.tx_data_len   = data_len;
-	x.rx_data_len   = 0;
-	x.callback      = callback;
-
-	x.mode          = I2C_MODE_WRITE;
-	x.state         = &isr_startWrite;
-	_MI2C2IF        = 1;
-	return true;
+	return I2C2_Enqueue(addr, cmd, cmd_len, data, data_len, 0, callback, I2C_MODE_WRITE);
 }
 
 boolean I2C2_Read(uint8_t addr, const uint8_t* cmd, uint8_t cmd_len, uint8_t* data, uint16_t data_len, I2C_callbackFunc callback, uint16_t mode)
 {
-	if (!I2C2_CheckAvailable()) return false;
-
-	x.addr          = addr;
-	x.cmd           = cmd;
-	x.cmd_len       = cmd_len;
-	x.data          = data;
-	x.tx_data_len   = 0;
-	x.rx_data_len   = data_len;
-	x.callback      = callback;
-	x.mode          = mode;
-
-	x.state         = &isr_startWrite;
-	_MI2C2IF        = 1;
-	return true;
+	return I2C2_Enqueue(addr, cmd, cmd_len, data, 0, data_len, callback, mode);
 }
 
 // Only send command byte to check for ACK.
-boolean I2C2_checkACK(uint16_t addr, I2C_callbackFunc callback)
+boolean I2C2_CheckAck(uint8_t addr, I2C_callbackFunc callback)
 {
-	if (!I2C2_CheckAvailable()) return false;
-
-	x.addr          = addr;
-	x.callback      = callback;
-
-	x.cmd_len       = 0;
-	x.data          = NULL;
-	x.tx_data_len   = 0;
-	x.rx_data_len   = 0;
-
-	x.mode          = I2C_MODE_WRITE;
-	x.state         = &isr_startWrite;
-	_MI2C2IF        = 1;
-	return true;
+	return I2C2_Enqueue(addr, NULL, 0, NULL, 0, 0, callback, I2C_MODE_WRITE);
 }
 
 static void isr_startWrite(void)
@@ -307,9 +367,9 @@ static void isr_writeStop(void)
 
 static void isr_doneWrite(void)
 {
-	I2C2_Busy = false;
 	if (x.callback != NULL)
 		x.callback(true);
+	I2C2_StartNext();
 }
 
 // Start a read after a write by setting the start bit again
@@ -388,19 +448,25 @@ static void isr_idle(void)
 
 static void isr_doneRead(void)
 {
-	I2C2_Busy = false;
 	if (x.callback != NULL)
 		x.callback(true);
+	I2C2_StartNext();
 }
 
-// On failure, stop the bus, go into idle and callback with failure
+// On failure, stop the bus, then callback with failure
 static void isr_failed(void)
 {
-	x.state = &isr_idle;
+	x.state = &isr_stopFailed;
 	I2C2CONbits.PEN = 1;
-	I2C2_Busy = false;
+}
+
+// The stop has completed, the next transaction can start
+static void isr_stopFailed(void)
+{
+	x.state = &isr_idle;
 	if (x.callback != NULL)
 		x.callback(false);
+	I2C2_StartNext();
 }
 
 #endif // USE_I2C_SECOND_PORT_DRIVER
@@ -23,6 +23,9 @@
 #include "oscillator.h"
 #include "interrupt.h"
 #include "heartbeat.h"
+#if (MPU_FIFO_RATE != 0)
+#include "mpu6000.h"
+#endif
 
 //#define CPU_LOAD_PERCENT  1678  // = ((65536 * 100) / ((32000000 / 2) / (16 * 256)))
 //#define CPU_LOAD_PERCENT  839   // = ((65536 * 100) / ((64000000 / 2) / (16 * 256)))
@@ -49,7 +52,7 @@ static inline void init_heartbeat(void)
 //#endif
 //#endif
 
-#if (BOARD_TYPE != UDB4_BOARD && HEARTBEAT_HZ == 200)
+#if (BOARD_TYPE != UDB4_BOARD && HEARTBEAT_HZ == 200 && MPU_FIFO_RATE == 0)
 
 	// MPU6000 interrupt is used as the HEARTBEAT_HZ heartbeat of libUDB.
 	// Timer1 is not used for heartbeat, but its interrupt flag is set in the
@@ -65,6 +68,8 @@ static inline void init_heartbeat(void)
 #else // BOARD_TYPE && HEARTBEAT_HZ
 
 	// use Timer1 as the HEARTBEAT source
+	// with MPU_FIFO_RATE, each Timer1 interrupt drains the MPU6000 FIFO and
+	// the heartbeat is called once the samples have been processed
 
 #if (HEARTBEAT_HZ < 150)
 #define TMR1_PRESCALE 64
@@ -89,7 +94,7 @@ static inline void init_heartbeat(void)
 	_T1IE = 1;              // enable the interrupt
 	T1CONbits.TON = 1;      // turn on timer 1
 
-#endif // (BOARD_TYPE != UDB4_BOARD && HEARTBEAT_HZ == 200)
+#endif // (BOARD_TYPE != UDB4_BOARD && HEARTBEAT_HZ == 200 && MPU_FIFO_RATE == 0)
 }
 
 static inline void init_cpu_timer(void)
@@ -162,7 +167,11 @@ void __attribute__((__interrupt__,__no_auto_psv__)) _T1Interrupt(void)
 	set_ipl_on_output_pin;
 	interrupt_save_set_corcon;
 	_T1IF = 0;              // clear the interrupt
+#if (MPU_FIFO_RATE != 0)
+	MPU6000_fifo_read();    // calls heartbeat() when the FIFO has been read
+#else
 	heartbeat();
+#endif
 	interrupt_restore_corcon;
 	unset_ipl_on_output_pin;
 }
@@ -74,17 +74,16 @@ static int16_t barCalibPause = 0;
 void ReadBarTemp_callback(boolean I2CtrxOK);
 void ReadBarPres_callback(boolean I2CtrxOK);
 void ReadBarCalib_callback(boolean I2CtrxOK);
+static void WriteBar_callback(boolean I2CtrxOK);
 
+// The I2C2 driver queues transactions, so the barometer can be serviced
+// while magnetometer transactions are still in progress on the same bus.
 #if (USE_BMP085_ON_I2C == 1)
-	#define I2C_Normal      I2C1_Normal
 	#define I2C_Read        I2C1_Read
 	#define I2C_Write       I2C1_Write
-	#define I2C_Reset       I2C1_Reset
 #elif (USE_BMP085_ON_I2C == 2)
-	#define I2C_Normal      I2C2_Normal
 	#define I2C_Read        I2C2_Read
 	#define I2C_Write       I2C2_Write
-	#define I2C_Reset       I2C2_Reset
 #endif
 
 
@@ -94,13 +93,6 @@ uint8_t rxBarometer(barometer_callback_funcptr callback)  // service the baromet
 {
 	barometer_callback = callback;
 
-	if (I2C_Normal() == false)  // if I2C is not ok
-	{
-		barMessage = 0;         // start over again
-		I2C_Reset();            // reset the I2C
-		return(BAROMETER_NEEDS_SERVICING);
-	}
-
 	if (barCalibPause == 0)
 	{
 		barMessage++;
@@ -118,14 +110,14 @@ uint8_t rxBarometer(barometer_callback_funcptr callback)  // service the baromet
 			I2C_Read(BMP085_ADDRESS, bmp085read_barCalib, 1, bc.buf, 22, &ReadBarCalib_callback, I2C_MODE_WRITE_ADDR_READ);
 			return(BAROMETER_SERVICE_CAN_PAUSE);
 		case 4:
-			I2C_Write(BMP085_ADDRESS, bmp085write_index, 1, bmp085read_barTemp, 1, NULL);
+			I2C_Write(BMP085_ADDRESS, bmp085write_index, 1, bmp085read_barTemp, 1, &WriteBar_callback);
 			return(BAROMETER_NEEDS_SERVICING);
 		case 5:
 			I2C_Read(BMP085_ADDRESS, bmp085read_barData, 1, barData, 2, &ReadBarTemp_callback, I2C_MODE_WRITE_ADDR_READ);
 			return(BAROMETER_NEEDS_SERVICING);
 		case 6:
 			barCalibPause = 1;  // With OSS of 3, BMP180 needs 25.5 milliseconds to get the 3 oversamples 
-			I2C_Write(BMP085_ADDRESS, bmp085write_index, 1, bmp085read_barPres, 1, NULL);
+			I2C_Write(BMP085_ADDRESS, bmp085write_index, 1, bmp085read_barPres, 1, &WriteBar_callback);
 			return(BAROMETER_NEEDS_SERVICING);
 		case 7:
 			I2C_Read(BMP085_ADDRESS, bmp085read_barData, 1, barData, 3, &ReadBarPres_callback, I2C_MODE_WRITE_ADDR_READ);
@@ -154,6 +146,15 @@ int TestByteOrder()
 }
  */
 
+// A failed transaction, or one the I2C driver timed out, starts over again
+static void WriteBar_callback(boolean I2CtrxOK)
+{
+	if (I2CtrxOK == false)
+	{
+		barMessage = 0;
+	}
+}
+
 static void byteswaparray(uint8_t* ary, int16_t len)
 {
 	int16_t i;
@@ -186,6 +187,10 @@ void ReadBarCalib_callback(boolean I2CtrxOK)
 		bc.md = 2868;
 #endif
 	}
+	else
+	{
+		barMessage = 0;         // start over again
+	}
 }
 
 // Calculate temperature given ut.
@@ -250,7 +255,7 @@ void ReadBarTemp_callback(boolean I2CtrxOK)
 	}
 	else
 	{
-		// the operation failed - we should probably do something about it...
+		barMessage = 0;         // start over again
 	}
 }
 
@@ -272,7 +277,7 @@ void ReadBarPres_callback(boolean I2CtrxOK)
 	}
 	else
 	{
-		// the operation failed - we should probably do something about it...
+		barMessage = 0;         // start over again
 	}
 }
 
@@ -145,6 +145,16 @@
 #define UDB_YACCEL udb_yaccel
 #define UDB_ZACCEL udb_zaccel
 
+// Cross products, like the MPU6000 FIFO coning and sculling vectors, pick up
+// the determinant of the mapping from the udb channels to the body frame.
+#define RATE_FRAME_PARITY ((XRATE_SIGN_ORIENTED 1) * (YRATE_SIGN_ORIENTED 1) * (ZRATE_SIGN_ORIENTED 1))
+#define XRATE_CONING     (RATE_FRAME_PARITY * (XRATE_SIGN_ORIENTED mpu_coning[0]))
+#define YRATE_CONING     (RATE_FRAME_PARITY * (YRATE_SIGN_ORIENTED mpu_coning[1]))
+#define ZRATE_CONING     (RATE_FRAME_PARITY * (ZRATE_SIGN_ORIENTED mpu_coning[2]))
+#define XACCEL_SCULLING  (RATE_FRAME_PARITY * (XACCEL_SIGN_ORIENTED mpu_sculling[0]))
+#define YACCEL_SCULLING  (RATE_FRAME_PARITY * (YACCEL_SIGN_ORIENTED mpu_sculling[1]))
+#define ZACCEL_SCULLING  (RATE_FRAME_PARITY * (ZACCEL_SIGN_ORIENTED mpu_sculling[2]))
+
 // This determines the sign of correction used to remove gravity from the offset.
 // It is opposite in sign to the sign of the alignment of the accelerometer axis.
 // Used by horizontal initialization
@@ -176,6 +186,15 @@
 #define UDB_YACCEL udb_yaccel
 #define UDB_XACCEL udb_zaccel
 
+// x and z are swapped, which flips the sign of cross products
+#define RATE_FRAME_PARITY (-(XRATE_SIGN_ORIENTED 1) * (YRATE_SIGN_ORIENTED 1) * (ZRATE_SIGN_ORIENTED 1))
+#define ZRATE_CONING     (RATE_FRAME_PARITY * (XRATE_SIGN_ORIENTED mpu_coning[0]))
+#define YRATE_CONING     (RATE_FRAME_PARITY * (YRATE_SIGN_ORIENTED mpu_coning[1]))
+#define XRATE_CONING     (RATE_FRAME_PARITY * (ZRATE_SIGN_ORIENTED mpu_coning[2]))
+#define ZACCEL_SCULLING  (RATE_FRAME_PARITY * (XACCEL_SIGN_ORIENTED mpu_sculling[0]))
+#define YACCEL_SCULLING  (RATE_FRAME_PARITY * (YACCEL_SIGN_ORIENTED mpu_sculling[1]))
+#define XACCEL_SCULLING  (RATE_FRAME_PARITY * (ZACCEL_SIGN_ORIENTED mpu_sculling[2]))
+
 // This determines the sign of correction used to remove gravity from the offset.
 // It is opposite in sign to the sign of the alignment of the accelerometer axis.
 // Used by horizontal initialization
@@ -207,6 +226,15 @@
 #define UDB_XACCEL udb_yaccel
 #define UDB_ZACCEL udb_zaccel
 
+// x and y are swapped, which flips the sign of cross products
+#define RATE_FRAME_PARITY (-(XRATE_SIGN_ORIENTED 1) * (YRATE_SIGN_ORIENTED 1) * (ZRATE_SIGN_ORIENTED 1))
+#define YRATE_CONING     (RATE_FRAME_PARITY * (XRATE_SIGN_ORIENTED mpu_coning[0]))
+#define XRATE_CONING     (RATE_FRAME_PARITY * (YRATE_SIGN_ORIENTED mpu_coning[1]))
+#define ZRATE_CONING     (RATE_FRAME_PARITY * (ZRATE_SIGN_ORIENTED mpu_coning[2]))
+#define YACCEL_SCULLING  (RATE_FRAME_PARITY * (XACCEL_SIGN_ORIENTED mpu_sculling[0]))
+#define XACCEL_SCULLING  (RATE_FRAME_PARITY * (YACCEL_SIGN_ORIENTED mpu_sculling[1]))
+#define ZACCEL_SCULLING  (RATE_FRAME_PARITY * (ZACCEL_SIGN_ORIENTED mpu_sculling[2]))
+
 // This determines the sign of correction used to remove gravity from the offset.
 // It is opposite in sign to the sign of the alignment of the accelerometer axis.
 // Used by horizontal initialization
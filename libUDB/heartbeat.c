@@ -30,13 +30,16 @@
 #if (BOARD_TYPE == UDB4_BOARD)
 #include "../libDCM/libDCM.h"
 #endif
-#if (USE_I2C1_DRIVER == 1)
+#if (USE_I2C1_DRIVER == 1 || MAG_YAW_DRIFT == 1 || USE_BAROMETER_ALTITUDE == 1)
 #include "I2C.h"
 #endif
 #if (USE_NV_MEMORY == 1)
 #include "NV_memory.h"
 #include "../MatrixPilot/data_services.h"
 #include "../MatrixPilot/data_storage.h"
+#include "../MatrixPilot/mission_store.h"
+#include "../MatrixPilot/flightplan_logo.h"
+#include "../libFlashFS/filesys.h"
 #endif
 
 int one_hertz_flag = 0;
@@ -166,10 +169,24 @@ static void heartbeat_pulse(void)
 		I2C1_trigger_service();
 #endif
 
+#if ((MAG_YAW_DRIFT == 1 || USE_BAROMETER_ALTITUDE == 1) && HILSIM != 1)
+		I2C2_trigger_service();
+#endif
+
 #if (USE_NV_MEMORY == 1)
 		nv_memory_service_trigger();
 		storage_service_trigger();
 		data_services_trigger();
+#if (USE_MISSION_STORE)
+		mission_store_trigger();
+#endif
+#if (USE_LOGO_STORE)
+		flightplan_logo_store_trigger();
+#endif
+#endif
+
+#if (USE_FILESYS == 1)
+		filesys_service_trigger();
 #endif
 
 #if (USE_FLEXIFUNCTION_MIXING == 1)
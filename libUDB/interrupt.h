@@ -45,6 +45,7 @@
 #define INT_PRI_DMA0    5   // analog2digital_xxx.c
 #define INT_PRI_DMA1    5   // AT45D_DMA.c
 #define INT_PRI_DMA2    5   // AT45D_DMA.c
+#define INT_PRI_DMA3    6   // mpu_spi.c : MPU6000 FIFO burst read, same priority as the MPU SPI
 
 #define INT_PRI_U1TX    4   // serialIO.c : mid range priority, no urgent reason
 #define INT_PRI_U1RX    4   // serialIO.c : mid range priority, no urgent reason
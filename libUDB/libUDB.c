@@ -43,6 +43,8 @@
 #include "NV_memory.h"
 #include "../MatrixPilot/data_storage.h"
 #include "../MatrixPilot/data_services.h"
+#include "../MatrixPilot/mission_store.h"
+#include "../MatrixPilot/flightplan_logo.h"
 #endif
 
 // Include flexifunction mixers if required
@@ -89,6 +91,12 @@ void udb_init(void)
 	nv_memory_init();
 	data_storage_init();
 	data_services_init();
+#if (USE_MISSION_STORE)
+	mission_store_init();
+#endif
+#if (USE_LOGO_STORE)
+	flightplan_logo_store_init();
+#endif
 #endif
 #if (USE_FLEXIFUNCTION_MIXING == 1)
 	flexiFunctionServiceInit();
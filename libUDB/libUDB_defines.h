@@ -112,6 +112,19 @@
 #define WIND_ESTIMATION         1
 #endif
 
+// MPU6000 FIFO oversampling
+// MPU_FIFO_RATE 0 reads one MPU6000 sample per heartbeat, on the data ready interrupt.
+// MPU_FIFO_RATE 1000 to 8000 drains the MPU6000 FIFO once per heartbeat instead.
+#ifndef MPU_FIFO_RATE           // define only if not already defined in options.h
+#define MPU_FIFO_RATE           0
+#endif
+
+// The UDB4 has analog gyros, and the PX4 port has its own MPU6000 driver
+#if (BOARD_TYPE == UDB4_BOARD || BOARD_TYPE == PX4_BOARD)
+#undef  MPU_FIFO_RATE
+#define MPU_FIFO_RATE           0
+#endif
+
 // Enforce that if DEADRECKONING is on, WIND_ESTIMATION must be on as well.
 // Using dead reckoning in high winds without wind estimation will cause large
 // errors in the dead reckoning.
@@ -44,16 +44,14 @@ static magnetometer_callback_funcptr magnetometer_callback = NULL;
 #define USE_HMC5883L_ON_I2C1  0
 #define USE_HMC5883L_ON_I2C2  1
 
+// The I2C2 driver queues transactions, so the magnetometer can be serviced
+// while barometer transactions are still in progress on the same bus.
 #if (USE_HMC5883L_ON_I2C1 == 1)
-	#define I2C_Normal      I2C1_Normal
 	#define I2C_Read        I2C1_Read
 	#define I2C_Write       I2C1_Write
-	#define I2C_Reset       I2C1_Reset
 #elif (USE_HMC5883L_ON_I2C2 == 1)
-	#define I2C_Normal      I2C2_Normal
 	#define I2C_Read        I2C2_Read
 	#define I2C_Write       I2C2_Write
-	#define I2C_Reset       I2C2_Reset
 #else
 #error Undefined magnetometer I2C bus
 #endif
@@ -79,6 +77,9 @@ int16_t I2messages = 0;
 
 // forward declarations
 static void I2C_callback(boolean I2CtrxOK);
+#if (HILSIM != 1)
+static void I2C_write_callback(boolean I2CtrxOK);
+#endif
 
 
 uint8_t rxMagnetometer(magnetometer_callback_funcptr callback)     // service the magnetometer
@@ -98,13 +99,6 @@ uint8_t rxMagnetometer(magnetometer_callback_funcptr callback)     // service th
 	}
 #endif
 
-	if (I2C_Normal() == false)  // if I2C is not ok
-	{
-		magMessage = 0;         // start over again
-		I2C_Reset();            // reset the I2C
-		return(MAGNETOMETER_NEEDS_SERVICING);
-	}
-
 	mrindex = 0;
 
 	if (magCalibPause == 0)
@@ -120,20 +114,20 @@ uint8_t rxMagnetometer(magnetometer_callback_funcptr callback)     // service th
 			I2C_Read(HMC5883_COMMAND, hmc5883read_index, 1, magreg, 6, &I2C_callback, I2C_MODE_WRITE_ADDR_READ); 
 			return(MAGNETOMETER_SERVICE_CAN_PAUSE);
 		case 2:     // put magnetometer into the power up defaults on a reset
-			I2C_Write(HMC5883_COMMAND, hmc5883write_index, 1, resetMagnetometer, 3, NULL);
+			I2C_Write(HMC5883_COMMAND, hmc5883write_index, 1, resetMagnetometer, 3, &I2C_write_callback);
 			return(MAGNETOMETER_NEEDS_SERVICING);
 		case 3:     // clear out any data that is still there
 			I2C_Read(HMC5883_COMMAND, hmc5883read_index, 1, magreg, 6, &I2C_callback, I2C_MODE_WRITE_ADDR_READ);
 			return(MAGNETOMETER_SERVICE_CAN_PAUSE);
 		case 4:     // enable the calibration process
 			magCalibPause = 2;
-			I2C_Write(HMC5883_COMMAND, hmc5883write_index, 1, enableMagCalibration, 3, NULL);
+			I2C_Write(HMC5883_COMMAND, hmc5883write_index, 1, enableMagCalibration, 3, &I2C_write_callback);
 			return(MAGNETOMETER_NEEDS_SERVICING);
 		case 5:     // read the calibration data
 			I2C_Read(HMC5883_COMMAND, hmc5883read_index, 1, magreg, 6, &I2C_callback, I2C_MODE_WRITE_ADDR_READ);
 			return(MAGNETOMETER_SERVICE_CAN_PAUSE);
 		case 6:     // enable normal continuous readings
-			I2C_Write(HMC5883_COMMAND, hmc5883write_index, 1, enableMagRead, 3, NULL);
+			I2C_Write(HMC5883_COMMAND, hmc5883write_index, 1, enableMagRead, 3, &I2C_write_callback);
 			return(MAGNETOMETER_NEEDS_SERVICING);
 		case 7:     // read the magnetometer data
 			I2C_Read(HMC5883_COMMAND, hmc5883read_index, 1, magreg, 6, &I2C_callback, I2C_MODE_WRITE_ADDR_READ);
@@ -208,7 +202,21 @@ static void I2C_callback(boolean I2CtrxOK)
 			}
 		}
 	}
+	else
+	{
+		magMessage = 0;                 // failed or timed out, reset the magnetometer
+	}
+}
+
+#if (HILSIM != 1)
+static void I2C_write_callback(boolean I2CtrxOK)
+{
+	if (I2CtrxOK == false)
+	{
+		magMessage = 0;                 // failed or timed out, reset the magnetometer
+	}
 }
+#endif
 
 void HILSIM_MagData(magnetometer_callback_funcptr callback)
 {
@@ -43,6 +43,45 @@ boolean mpuDAV = false;
 struct ADchannel mpu_temp;
 int16_t vref_adj;
 
+#if (MPU_FIFO_RATE != 0)
+
+#if (MPU_FIFO_RATE == 1000)
+#define MPU_FIFO_DLPF_CFG   BITS_DLPF_CFG_188HZ         // gyro output rate 1KHz
+#define MPU_FIFO_SMPLRT_DIV 0
+#elif (MPU_FIFO_RATE == 2000 || MPU_FIFO_RATE == 4000 || MPU_FIFO_RATE == 8000)
+#define MPU_FIFO_DLPF_CFG   BITS_DLPF_CFG_256HZ_NOLPF2  // gyro output rate 8KHz
+#define MPU_FIFO_SMPLRT_DIV ((8000 / MPU_FIFO_RATE) - 1)
+#else
+#error "MPU_FIFO_RATE must be 0, 1000, 2000, 4000 or 8000"
+#endif
+
+// The coning and sculling vectors are computed in the udb channel frame and
+// rotated into the body frame by rmat.c, which relies on the accelerometer
+// axes being the negated gyro axes
+#if ((XRATE_SIGN 1) != -(XACCEL_SIGN 1) || (YRATE_SIGN 1) != -(YACCEL_SIGN 1) || (ZRATE_SIGN 1) != -(ZACCEL_SIGN 1))
+#error "MPU_FIFO_RATE requires opposite gyro and accelerometer signs"
+#endif
+
+// Sample sums are kept at 1/64 (THETA_SHIFT) and cross products at 1/64
+// (CROSS_SHIFT) of full scale, so nothing overflows with 64 frames at full
+// rate on all axes. Converting the summed cross products back to a rate over
+// the heartbeat: dt / (2 * frames * RADPERSEC) * 2^(THETA_SHIFT+CROSS_SHIFT)
+// where RADPERSEC = 5632 / SCALEGYRO, and dt = 1 / MPU_FIFO_RATE
+#define THETA_SHIFT         6
+#define CROSS_SHIFT         6
+#define CONING_DIVISOR      ((int32_t)((MPU_FIFO_RATE * 5632.0 / SCALEGYRO) / 2048.0))
+
+static uint16_t fifo_data[MPU_FIFO_FRAMES_MAX * MPU_FIFO_FRAME_WORDS];
+static uint16_t fifo_count;
+static int16_t fifo_frames;
+static boolean fifo_busy = false;
+static uint16_t fifo_overruns = 0;
+
+int16_t mpu_coning[3];
+int16_t mpu_sculling[3];
+
+#endif // MPU_FIFO_RATE
+
 // MPU6000 Initialization and configuration
 
 static callback_fptr_t callback = NULL;
@@ -128,9 +167,20 @@ void MPU6000_init16(callback_fptr_t fptr)
 //	writeMPUSPIreg16(MPUREG_ACCEL_CONFIG, BITS_FS_8G); // Accel scale g = 4096
 #endif
 
+#if (MPU_FIFO_RATE != 0)
+	// oversample into the FIFO, Timer1 paces the heartbeat and the FIFO reads
+	writeMPUSPIreg16(MPUREG_SMPLRT_DIV, MPU_FIFO_SMPLRT_DIV);
+	writeMPUSPIreg16(MPUREG_CONFIG, MPU_FIFO_DLPF_CFG);
+	writeMPUSPIreg16(MPUREG_INT_ENABLE, 0);
+	writeMPUSPIreg16(MPUREG_FIFO_EN, BIT_ACCEL_FIFO_EN | BIT_TEMP_FIFO_EN |
+	                 BIT_XG_FIFO_EN | BIT_YG_FIFO_EN | BIT_ZG_FIFO_EN);
+	writeMPUSPIreg16(MPUREG_USER_CTRL, BIT_I2C_IF_DIS | BIT_FIFO_RESET);
+	writeMPUSPIreg16(MPUREG_USER_CTRL, BIT_I2C_IF_DIS | BIT_USER_FIFO_EN);
+#else
 	// INT CFG => Interrupt on Data Ready, totem-pole (push-pull) output
 	writeMPUSPIreg16(MPUREG_INT_PIN_CFG, BIT_INT_LEVEL | BIT_INT_RD_CLEAR); // INT: Clear on any read
 	writeMPUSPIreg16(MPUREG_INT_ENABLE, BIT_DATA_RDY_EN); // INT: Raw data ready
+#endif // MPU_FIFO_RATE
 
 // Bump the SPI clock up towards 20 MHz for ongoing sensor and interrupt register reads
 // 20 MHz is the maximum specified for the MPU-6000
@@ -159,7 +209,9 @@ void MPU6000_init16(callback_fptr_t fptr)
 
 	_TRISMPUINT = 1; // this is probably already taken care of in mcu.c for most boards
 
-#if (MPU_SPI == 1)
+#if (MPU_FIFO_RATE != 0)
+	initMPUSPI_dma();
+#elif (MPU_SPI == 1)
 	_INT1EP = 1; // Setup INT1 pin to interrupt on falling edge
 	_INT1IP = INT_PRI_INT1;
 	_INT1IF = 0; // Reset INT1 interrupt flag
@@ -210,6 +262,134 @@ static void MPU6000_read(void)
 	readMPUSPI_burst16n(mpu_data, 7, MPUREG_ACCEL_XOUT_H, &process_MPU_data);
 }
 
+#if (MPU_FIFO_RATE != 0)
+
+static void fifo_complete(void)
+{
+	fifo_busy = false;
+	mpuDAV = true;
+	if (callback) callback();   // heartbeat()
+}
+
+// r += u x w, each product scaled down by CROSS_SHIFT
+static inline void cross_accum(int32_t r[], const int16_t u[], const int16_t w[])
+{
+	r[0] += (__builtin_mulss(u[1], w[2]) - __builtin_mulss(u[2], w[1])) >> CROSS_SHIFT;
+	r[1] += (__builtin_mulss(u[2], w[0]) - __builtin_mulss(u[0], w[2])) >> CROSS_SHIFT;
+	r[2] += (__builtin_mulss(u[0], w[1]) - __builtin_mulss(u[1], w[0])) >> CROSS_SHIFT;
+}
+
+// Average the frames drained from the FIFO into the ADchannels, and integrate
+// the coning (theta x omega) and sculling (theta x accel + velocity x omega)
+// terms over the heartbeat, using the sums of the preceding samples.
+static void process_MPU_fifo(void)
+{
+	int32_t gsum[3] = { 0, 0, 0 };
+	int32_t asum[3] = { 0, 0, 0 };
+	int32_t tsum = 0;
+	int32_t coning[3] = { 0, 0, 0 };
+	int32_t sculling[3] = { 0, 0, 0 };
+	int16_t gyro[3], accel[3], theta[3], velocity[3];
+	int16_t* frame = (int16_t*)fifo_data;
+	int16_t i;
+
+	for (i = 0; i < fifo_frames; i++)
+	{
+		theta[0] = gsum[0] >> THETA_SHIFT;
+		theta[1] = gsum[1] >> THETA_SHIFT;
+		theta[2] = gsum[2] >> THETA_SHIFT;
+		velocity[0] = asum[0] >> THETA_SHIFT;
+		velocity[1] = asum[1] >> THETA_SHIFT;
+		velocity[2] = asum[2] >> THETA_SHIFT;
+
+		gyro[0]  = (frame[xrate_MPU_channel]>>1)  - (udb_xrate.offset>>1);
+		gyro[1]  = (frame[yrate_MPU_channel]>>1)  - (udb_yrate.offset>>1);
+		gyro[2]  = (frame[zrate_MPU_channel]>>1)  - (udb_zrate.offset>>1);
+		accel[0] = (frame[xaccel_MPU_channel]>>1) - (udb_xaccel.offset>>1);
+		accel[1] = (frame[yaccel_MPU_channel]>>1) - (udb_yaccel.offset>>1);
+		accel[2] = (frame[zaccel_MPU_channel]>>1) - (udb_zaccel.offset>>1);
+		tsum += frame[temp_MPU_channel];
+
+		cross_accum(coning, theta, gyro);
+		cross_accum(sculling, theta, accel);
+		cross_accum(sculling, velocity, gyro);
+
+		gsum[0] += gyro[0];
+		gsum[1] += gyro[1];
+		gsum[2] += gyro[2];
+		asum[0] += accel[0];
+		asum[1] += accel[1];
+		asum[2] += accel[2];
+		frame += MPU_FIFO_FRAME_WORDS;
+	}
+
+	// the averages are put back into raw units, so the offsets still apply
+	udb_xrate.value  = (__builtin_divsd(gsum[0], fifo_frames) + (udb_xrate.offset>>1)) << 1;
+	udb_yrate.value  = (__builtin_divsd(gsum[1], fifo_frames) + (udb_yrate.offset>>1)) << 1;
+	udb_zrate.value  = (__builtin_divsd(gsum[2], fifo_frames) + (udb_zrate.offset>>1)) << 1;
+	udb_xaccel.value = (__builtin_divsd(asum[0], fifo_frames) + (udb_xaccel.offset>>1)) << 1;
+	udb_yaccel.value = (__builtin_divsd(asum[1], fifo_frames) + (udb_yaccel.offset>>1)) << 1;
+	udb_zaccel.value = (__builtin_divsd(asum[2], fifo_frames) + (udb_zaccel.offset>>1)) << 1;
+	mpu_temp.value   = __builtin_divsd(tsum, fifo_frames);
+
+	for (i = 0; i < 3; i++)
+	{
+		mpu_coning[i]   = coning[i]   / (CONING_DIVISOR * fifo_frames);
+		mpu_sculling[i] = sculling[i] / (CONING_DIVISOR * fifo_frames);
+	}
+	fifo_complete();
+}
+
+static void MPU6000_fifo_count(void)
+{
+	uint16_t bytes = fifo_count & 0x07FF;
+
+	if (bytes >= MPU_FIFO_SIZE)
+	{
+		// the FIFO has overflowed and may hold torn frames, so start again
+		fifo_overruns++;
+		writeMPUSPIreg16(MPUREG_USER_CTRL, BIT_I2C_IF_DIS | BIT_FIFO_RESET);
+		writeMPUSPIreg16(MPUREG_USER_CTRL, BIT_I2C_IF_DIS | BIT_USER_FIFO_EN);
+		fifo_frames = 0;
+	}
+	else
+	{
+		// only read whole frames, the rest are collected next heartbeat
+		fifo_frames = __builtin_divud(bytes, MPU_FIFO_FRAME_BYTES);
+		if (fifo_frames > MPU_FIFO_FRAMES_MAX)
+		{
+			fifo_frames = MPU_FIFO_FRAMES_MAX;
+		}
+	}
+	if (fifo_frames > 0)
+	{
+		readMPUSPI_dma16n(fifo_data, fifo_frames * MPU_FIFO_FRAME_WORDS, MPUREG_FIFO_R_W, &process_MPU_fifo);
+	}
+	else
+	{
+		// nothing new, hold the previous sensor values
+		mpu_coning[0] = mpu_coning[1] = mpu_coning[2] = 0;
+		mpu_sculling[0] = mpu_sculling[1] = mpu_sculling[2] = 0;
+		fifo_complete();
+	}
+}
+
+void MPU6000_fifo_read(void)
+{
+	if (fifo_busy)
+	{
+		// the previous drain has not completed, skip this heartbeat
+		fifo_overruns++;
+		return;
+	}
+	fifo_busy = true;
+	mpuCnt++;
+	// Non-blocking read of the FIFO byte count, then MPU6000_fifo_count
+	readMPUSPI_dma16n(&fifo_count, 1, MPUREG_FIFO_COUNTH, &MPU6000_fifo_count);
+}
+
+#endif // MPU_FIFO_RATE
+
 #if (MPU_SPI == 1)
 void __attribute__((interrupt, no_auto_psv)) _INT1Interrupt(void)
 {
@@ -238,6 +418,10 @@ void MPU6000_print(void)
 	printf("%06u axyz %06i %06i %06i gxyz %06i %06i %06i t %u\r\n",
 	    mpuCnt,      mpu_data[0], mpu_data[1], mpu_data[2], 
 	    mpu_data[4], mpu_data[5], mpu_data[6], mpu_data[3]);
+#if (MPU_FIFO_RATE != 0)
+	printf("fifo frames %i overruns %u coning %i %i %i\r\n",
+	    fifo_frames, fifo_overruns, mpu_coning[0], mpu_coning[1], mpu_coning[2]);
+#endif
 }
 
 #endif // (BOARD_TYPE != UDB4_BOARD)
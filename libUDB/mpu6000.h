@@ -51,8 +51,10 @@
 #define MPUREG_CONFIG               0x1A
 #define MPUREG_GYRO_CONFIG          0x1B
 #define MPUREG_ACCEL_CONFIG         0x1C
+#define MPUREG_FIFO_EN              0x23
 #define MPUREG_INT_PIN_CFG          0x37
 #define MPUREG_INT_ENABLE           0x38
+#define MPUREG_INT_STATUS           0x3A
 #define MPUREG_ACCEL_XOUT_H         0x3B
 #define MPUREG_ACCEL_XOUT_L         0x3C
 #define MPUREG_ACCEL_YOUT_H         0x3D
@@ -109,6 +111,17 @@
 //#define BIT_RAW_RDY_EN              0x01
 #define BIT_I2C_IF_DIS              0x10
 
+// Register 35 - FIFO Enable (FIFO_EN)
+#define BIT_TEMP_FIFO_EN            0x80
+#define BIT_XG_FIFO_EN              0x40
+#define BIT_YG_FIFO_EN              0x20
+#define BIT_ZG_FIFO_EN              0x10
+#define BIT_ACCEL_FIFO_EN           0x08
+
+// Register 106 - User Control (USER_CTRL)
+#define BIT_USER_FIFO_EN            0x40
+#define BIT_FIFO_RESET              0x04
+
 // Register 55 - INT Pin / Bypass Enable Configuration (INT_PIN_CFG)
 #define BIT_INT_LEVEL               0x80
 #define BIT_INT_OPEN                0x40
@@ -143,6 +156,18 @@
 #define MPU6000_50HZ                3
 
 
+// FIFO oversampling (MPU_FIFO_RATE != 0)
+// Accel, temp and gyro are all enabled in FIFO_EN, so each FIFO frame has the
+// same 7 word layout as a burst read starting at MPUREG_ACCEL_XOUT_H
+#define MPU_FIFO_FRAME_WORDS        7
+#define MPU_FIFO_FRAME_BYTES        (2 * MPU_FIFO_FRAME_WORDS)
+#define MPU_FIFO_SIZE               1024    // bytes
+#define MPU_FIFO_FRAMES             (MPU_FIFO_RATE / HEARTBEAT_HZ)
+// drain a few extra frames per heartbeat to absorb MCU and MPU clock drift,
+// but never more than 64, which the coning accumulators are scaled for
+#define MPU_FIFO_FRAMES_MAX         ((MPU_FIFO_FRAMES + 8) > 64 ? 64 : (MPU_FIFO_FRAMES + 8))
+
+
 void MPU6000_print(void);
 
 typedef void (*callback_fptr_t)(void);
@@ -151,4 +176,15 @@ void MPU6000_init16(callback_fptr_t fptr);
 
 extern struct ADchannel mpu_temp;
 
+#if (MPU_FIFO_RATE != 0)
+// Start draining the FIFO. Called at HEARTBEAT_HZ from the Timer1 interrupt,
+// the callback passed to MPU6000_init16() is made once the samples are processed.
+void MPU6000_fifo_read(void);
+
+// Coning and sculling corrections over the last heartbeat, in the same units
+// and udb channel order (x, y, z) as udb_xrate.value>>1 and udb_xaccel.value>>1
+extern int16_t mpu_coning[3];
+extern int16_t mpu_sculling[3];
+#endif // MPU_FIFO_RATE
+
 #endif // __MPU6000_H__
@@ -26,6 +26,7 @@
 #include "oscillator.h"
 #include "interrupt.h"
 #include "mpu_spi.h"
+#include "mpu6000.h"
 #include <delay.h>
 #include <spi.h>
 
@@ -47,6 +48,7 @@
 #define CloseSPI     CloseSPI1
 #define ConfigIntSPI ConfigIntSPI1
 #define SPIInterrupt _SPI1Interrupt
+#define MPU_DMA_REQ  0x0A           // SPI1 transfer done
 
 #elif (MPU_SPI == 2)
 
@@ -68,6 +70,7 @@
 #define CloseSPI     CloseSPI2
 #define ConfigIntSPI ConfigIntSPI2
 #define SPIInterrupt _SPI2Interrupt
+#define MPU_DMA_REQ  0x21           // SPI2 transfer done
 
 #else
 #error "Select either 1 or 2 for MPU SPI."
@@ -283,6 +286,96 @@ void __attribute__((__interrupt__, __no_auto_psv__)) SPIInterrupt(void)
 
 #endif // (__dsPIC33E__)
 
+#if (MPU_FIFO_RATE != 0)
+
+// DMA3 receives from SPIBUF into mpu_dma_rx, DMA4 clocks out the null words.
+// DMA4 uses register indirect without post-increment, so a single null word
+// in DMA memory serves for the whole burst. DMA3 has the higher priority, so
+// each received word is collected before the next null word is sent.
+#define MPU_DMA_WORDS (MPU_FIFO_FRAMES_MAX * MPU_FIFO_FRAME_WORDS + 1)
+
+#if defined(__dsPIC33E__)
+static __eds__ uint16_t mpu_dma_rx[MPU_DMA_WORDS] __attribute__((eds,space(dma)));
+static __eds__ uint16_t mpu_dma_null __attribute__((eds,space(dma))) = 0;
+#else
+static uint16_t mpu_dma_rx[MPU_DMA_WORDS] __attribute__((space(dma)));
+static uint16_t mpu_dma_null __attribute__((space(dma))) = 0;
+#endif
+static int16_t mpu_dma_n;
+
+// Configure the DMA channels used for FIFO burst reads
+void initMPUSPI_dma(void)
+{
+	DMA3CON = 0x0001;           // Word transfer, peripheral to RAM
+	                            // Register Indirect with Post-Increment mode
+	                            // One-Shot, Ping-Pong modes are disabled
+	DMA3REQ = MPU_DMA_REQ;
+	DMA3PAD = (volatile uint16_t)&SPIBUF;
+	DMA4CON = 0x2011;           // Word transfer, RAM to peripheral
+	                            // Register Indirect without Post-Increment mode
+	                            // One-Shot, Ping-Pong modes are disabled
+	DMA4REQ = MPU_DMA_REQ;
+	DMA4PAD = (volatile uint16_t)&SPIBUF;
+#if defined(__dsPIC33E__)
+	DMA3STAH = 0x0000;
+	DMA3STAL = __builtin_dmaoffset(mpu_dma_rx);
+	DMA4STAH = 0x0000;
+	DMA4STAL = __builtin_dmaoffset(&mpu_dma_null);
+#else
+	DMA3STA = __builtin_dmaoffset(mpu_dma_rx);
+	DMA4STA = __builtin_dmaoffset(&mpu_dma_null);
+#endif
+	_DMA3IP = INT_PRI_DMA3;     // Set the DMA ISR priority
+	_DMA3IF = 0;                // Clear the DMA interrupt flag
+	_DMA3IE = 1;                // Enable the DMA interrupt
+}
+
+// burst read 2n bytes starting at addr, using DMA rather than the SPI interrupt
+void readMPUSPI_dma16n(uint16_t data[], int16_t n, uint16_t addr, void (*call_back)(void))
+{
+	uint16_t i;
+
+	if (n > MPU_DMA_WORDS - 1) n = MPU_DMA_WORDS - 1;
+
+	MPU_SS = 0;                 // assert chip select
+	mpu_call_back = call_back;  // store the address of the call back routine
+	SPI_data = &data[0];        // store address of data buffer
+	mpu_dma_n = n;
+#if defined(__dsPIC33E__)
+	while (!_SRXMPT)
+#endif
+	{
+		i = SPIBUF;             // empty read buffer
+	}
+	_SPIIE = 0;                 // the DMA channels take the SPI events
+	DMA3CNT = n;                // n + 1 words are received, the first one
+	DMA4CNT = n - 1;            //   while the read command is sent
+	DMA3CONbits.CHEN = 1;
+	DMA4CONbits.CHEN = 1;
+	SPIBUF = (addr | 0x80) << 8; // issue read command, DMA does the rest
+}
+
+// realign the received bytes, the first one came in with the read command
+void __attribute__((__interrupt__, __no_auto_psv__)) _DMA3Interrupt(void)
+{
+	int16_t i;
+
+	_DMA3IF = 0;
+	indicate_loading_inter;
+	set_ipl_on_output_pin;
+	interrupt_save_set_corcon;
+	MPU_SS = 1;
+	for (i = 0; i < mpu_dma_n; i++)
+	{
+		SPI_data[i] = (mpu_dma_rx[i] << 8) | (mpu_dma_rx[i + 1] >> 8);
+	}
+	(*mpu_call_back)();
+	interrupt_restore_corcon;
+	unset_ipl_on_output_pin;
+}
+
+#endif // MPU_FIFO_RATE
+
 uint16_t readMPUSPIreg16(uint16_t addr)
 {
 	int16_t data;
@@ -71,5 +71,13 @@ uint16_t readMPUSPIreg16(uint16_t addr);
 // n-word, non-blocking SPI read, followed by call_back
 void readMPUSPI_burst16n(uint16_t data[], int16_t n, uint16_t addr, void (*call_back)(void));
 
+#if (MPU_FIFO_RATE != 0)
+// configure DMA channels 3 and 4 for MPU SPI burst reads
+void initMPUSPI_dma(void);
+
+// n-word, DMA driven SPI read of up to MPU_FIFO_FRAMES_MAX frames, followed by call_back
+void readMPUSPI_dma16n(uint16_t data[], int16_t n, uint16_t addr, void (*call_back)(void));
+#endif
+
 
 #endif // MPU_SPI_H
@@ -23,6 +23,9 @@
 #include "oscillator.h"
 #include "interrupt.h"
 #include "serialIO.h"
+#if (USE_CDC_TELEMETRY == 1)
+#include "usb_cdc.h"
+#endif
 
 // Baud Rate Generator -- See section 19.3.1 of datasheet.
 // Fcy = FREQOSC / CLK_PHASES
@@ -202,6 +205,12 @@ void udb_init_USART(int16_callback_fptr_t tx_fptr, callback_uint8_fptr_t rx_fptr
 	_U2TXIP = INT_PRI_U2TX;     // Mid Range Interrupt Priority level, no urgent reason
 	_U2RXIP = INT_PRI_U2RX;     // Mid Range Interrupt Priority level, no urgent reason
 
+#if (USE_CDC_TELEMETRY == 1)
+	// The UART stays off, the transmit interrupt is only fired by software
+	// to move the serial stream into the USB CDC transmit ring
+	_U2TXIF = 0;                // Clear the Transmit Interrupt Flag
+	_U2TXIE = 1;                // Enable Transmit Interrupts
+#else
 	_U2TXIF = 0;                // Clear the Transmit Interrupt Flag
 	_U2TXIE = 1;                // Enable Transmit Interrupts
 	_U2RXIF = 0;                // Clear the Receive Interrupt Flag
@@ -209,6 +218,7 @@ void udb_init_USART(int16_callback_fptr_t tx_fptr, callback_uint8_fptr_t rx_fptr
 
 	U2MODEbits.UARTEN = 1;      // And turn the peripheral on
 	U2STAbits.UTXEN = 1;
+#endif // USE_CDC_TELEMETRY
 }
 
 void udb_serial_set_rate(int32_t rate)
@@ -232,6 +242,47 @@ void udb_serial_stop_sending_data(void)
 	udb_serial_stop_sending_flag  = true; 
 }
 
+#if (USE_CDC_TELEMETRY == 1)
+
+// Called from CDCTasks() when there is room in the USB transmit ring again
+void udb_serial_usb_resume(void)
+{
+	_U2TXIF = 1; // fire the tx interrupt
+}
+
+// Called from CDCTasks() with each byte received over USB
+void udb_serial_usb_received_byte(uint8_t rxchar)
+{
+	if (serial_callback_received_byte)
+	{
+		serial_callback_received_byte(rxchar);
+	}
+}
+
+void __attribute__((__interrupt__, __no_auto_psv__)) _U2TXInterrupt(void)
+{
+	_U2TXIF = 0; // clear the interrupt
+	indicate_loading_inter;
+	set_ipl_on_output_pin;
+	interrupt_save_set_corcon;
+
+	// Move as much of the stream as fits into the USB transmit ring,
+	// CDCTasks() sends it on in bulk packets
+	while (serial_callback_get_byte_to_send && !udb_serial_stop_sending_flag && usb_cdc_tx_space() > 0)
+	{
+		int16_t txchar = serial_callback_get_byte_to_send();
+		if (txchar == -1)
+		{
+			break;
+		}
+		usb_cdc_tx_put((uint8_t)txchar);
+	}
+	interrupt_restore_corcon;
+	unset_ipl_on_output_pin;
+}
+
+#else
+
 void __attribute__((__interrupt__, __no_auto_psv__)) _U2TXInterrupt(void)
 {
 	_U2TXIF = 0; // clear the interrupt
@@ -257,6 +308,8 @@ void __attribute__((__interrupt__, __no_auto_psv__)) _U2TXInterrupt(void)
     }
 }
 
+#endif // USE_CDC_TELEMETRY
+
 void __attribute__((__interrupt__, __no_auto_psv__)) _U2RXInterrupt(void)
 {
 	_U2RXIF = 0; // clear the interrupt
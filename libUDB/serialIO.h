@@ -49,3 +49,9 @@ int16_t udb_serial_callback_get_byte_to_send(void);     // Callback
 // Implement this callback to handle receiving a byte from the serial port
 void udb_serial_callback_received_byte(uint8_t rxchar); // Callback
 
+#if (USE_CDC_TELEMETRY == 1)
+// The serial stream is sent and received over USB CDC instead of UART2
+void udb_serial_usb_received_byte(uint8_t rxchar);
+void udb_serial_usb_resume(void);
+#endif // USE_CDC_TELEMETRY
+